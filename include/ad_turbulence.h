@@ -5,12 +5,20 @@
 
 #ifdef __cplusplus
 #include <Sacado.hpp>
+#include <memory>
+#include <vector>
 extern "C" {
 #include "el_elm.h"
 #include "mm_mp_const.h"
 #include "std.h"
 }
+#if defined(GOMA_AD_MAX_DERIVATIVES) && GOMA_AD_MAX_DERIVATIVES > 0
+/* Derivative storage is a fixed array, elements must not exceed
+ * GOMA_AD_MAX_DERIVATIVES unknowns (checked in fill_ad_field_variables) */
+using ADType = Sacado::Fad::SLFad<double, GOMA_AD_MAX_DERIVATIVES>;
+#else
 using ADType = Sacado::Fad::DFad<double>;
+#endif
 void ad_supg_tau_shakib(ADType &supg_tau, int dim, dbl dt, ADType diffusivity, int interp_eqn);
 struct AD_Basis {
   ADType d_phi[MDE][DIM];                /* d_phi[i][a]    = d(phi_i)/d(q_a) */
@@ -19,9 +27,15 @@ struct AD_Basis {
                                          /* = (e_p e_q): grad(phi_i e_a) */
   ADType curl_phi_e[MDE][DIM][DIM];
 };
+/* AD_Basis is large with fixed size derivatives, so storage is only
+ * allocated for the variables active in some material (ad_load_bf_grad) */
+struct AD_Basis_Set {
+  std::vector<std::unique_ptr<AD_Basis>> slots;
+  AD_Basis &operator[](int v) { return *slots[v]; }
+};
 struct AD_Field_Variables {
   AD_Field_Variables() = default;
-  std::vector<AD_Basis> basis;
+  AD_Basis_Set basis;
   ADType detJ;
   ADType J[DIM][DIM];
   ADType B[DIM][DIM];
@@ -35,6 +35,17 @@ EXTERN void exchange_dof(Comm_Ex *, /* cx - ptr to communications exchange info
                          double *,  /* x - local processor dof-based vector */
                          int);
 
+EXTERN void exchange_dof_begin(Comm_Ex *, /* cx - ptr to communications exchange info */
+                               Dpi *,     /* dpi - distributed processing info */
+                               double *,  /* x - local processor dof-based vector */
+                               int);      /* imtrx - matrix index */
+
+EXTERN void exchange_dof_end(int); /* imtrx - matrix index */
+
+EXTERN int exchange_dof_pending(int); /* imtrx - matrix index */
+
+EXTERN void exchange_dof_free(void);
+
 EXTERN void exchange_dof_int(Comm_Ex *, /* cx - ptr to communications exchange info */
                              Dpi *,     /* dpi - distributed processing info */
                              int *,     /* x - local processor dof-based vector */
@@ -29,7 +29,8 @@ enum GomaSparseMatrixType {
   GOMA_SPARSE_MATRIX_TYPE_EPETRA,
   GOMA_SPARSE_MATRIX_TYPE_AZTEC_MRS,
   GOMA_SPARSE_MATRIX_TYPE_TPETRA,
-  GOMA_SPARSE_MATRIX_TYPE_PETSC
+  GOMA_SPARSE_MATRIX_TYPE_PETSC,
+  GOMA_SPARSE_MATRIX_TYPE_TPETRA_BLOCK
 };
 
 struct g_GomaSparseMatrix {
@@ -39,8 +40,14 @@ struct g_GomaSparseMatrix {
   GomaGlobalOrdinal n_rows;
   GomaGlobalOrdinal n_cols;
   GomaGlobalOrdinal nnz;
+  // number of unknowns at every node when all nodes carry the same unknowns, otherwise 0
+  int block_size;
+  // equilibration applied by row_sum_scaling, EQUILIBRATE_ROW, _COLUMN or _SYMMETRIC
+  int equilibration;
   // Create matrix with given rows and columns
-  // coo_rows and coo_cols are the COO representation of the matrix ordered by row
+  // row_ptr and local_cols are the local CSR representation of the matrix,
+  // row i has columns local_cols[row_ptr[i]] to local_cols[row_ptr[i + 1] - 1],
+  // sorted, which are indices into col_list
   // local_nnz is the number of non-zero entries in the local partition
   // max_nz_per_row is the maximum number of non-zero entries in any row
   goma_error (*create_graph)(struct g_GomaSparseMatrix *matrix,
@@ -50,8 +57,8 @@ struct g_GomaSparseMatrix {
                              GomaGlobalOrdinal *col_list,
                              GomaGlobalOrdinal local_nnz,
                              GomaGlobalOrdinal max_nz_per_row,
-                             GomaGlobalOrdinal *coo_rows,
-                             GomaGlobalOrdinal *coo_cols);
+                             GomaGlobalOrdinal *row_ptr,
+                             int *local_cols);
   // optional, run after create graph to finalize structure
   goma_error (*complete_graph)(struct g_GomaSparseMatrix *matrix);
   // Insert values into matrix row replacing existing values
@@ -66,15 +73,31 @@ struct g_GomaSparseMatrix {
                                     GomaGlobalOrdinal num_entries,
                                     double *values,
                                     GomaGlobalOrdinal *indices);
+  // optional, node blocked formats only, add dense block_size x block_size tiles (row major,
+  // one after the other) into a block row, rows and columns are local node indices
+  goma_error (*sum_into_block_row_values)(struct g_GomaSparseMatrix *matrix,
+                                          int local_block_row,
+                                          int num_blocks,
+                                          double *values,
+                                          int *local_block_cols);
   // set matrix non-zeros to specified scalar value (commonly re-zero for next assembly)
   goma_error (*put_scalar)(struct g_GomaSparseMatrix *matrix, double scalar);
   // row sum scaling, compute row sum scale, scale matrix and b, and return scaling vector
+  // with column or symmetric equilibration the matrix columns are scaled as well
   goma_error (*row_sum_scaling)(struct g_GomaSparseMatrix *matrix, double *b, double *scale);
+  // optional, required for column and symmetric equilibration, maps the solution of the
+  // equilibrated system back to the original unknowns, x holds the local rows
+  goma_error (*unscale_solution)(struct g_GomaSparseMatrix *matrix, double *x);
   // Zeros a global row
   goma_error (*zero_global_row)(struct g_GomaSparseMatrix *matrix, GomaGlobalOrdinal global_row);
   // Zeros a global row and sets diagonal to 1.0
   goma_error (*zero_global_row_set_diag)(struct g_GomaSparseMatrix *matrix,
                                          GomaGlobalOrdinal global_row);
+  // optional, zeros a list of local rows in one pass, setting the diagonal to 1.0 if set_diag
+  goma_error (*zero_local_rows)(struct g_GomaSparseMatrix *matrix,
+                                int num_rows,
+                                int *local_rows,
+                                int set_diag);
   // delete the allocated matrix;
   goma_error (*destroy)(struct g_GomaSparseMatrix *matrix);
 };
@@ -86,6 +109,7 @@ goma_error GomaSparseMatrix_Create(GomaSparseMatrix *matrix, enum GomaSparseMatr
 //   - global_ids
 //   - n_rows
 //   - n_cols
+//   - block_size
 goma_error GomaSparseMatrix_SetProblemGraph(
     GomaSparseMatrix matrix,
     int num_internal_dofs,
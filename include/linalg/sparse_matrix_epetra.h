@@ -15,6 +15,7 @@ using GO = GomaGlobalOrdinal;
 struct EpetraSparseMatrix {
   Teuchos::RCP<Epetra_CrsMatrix> matrix;
   Teuchos::RCP<Epetra_Map> row_map;
+  Teuchos::RCP<Epetra_Map> col_map;
   Teuchos::RCP<Epetra_CrsGraph> crs_graph;
   EpetraSparseMatrix() = default;
 };
@@ -31,8 +32,8 @@ goma_error g_epetra_create_graph(GomaSparseMatrix matrix,
                                  GomaGlobalOrdinal *col_list,
                                  GomaGlobalOrdinal local_nnz,
                                  GomaGlobalOrdinal max_per_row,
-                                 GomaGlobalOrdinal *coo_rows,
-                                 GomaGlobalOrdinal *coo_cols);
+                                 GomaGlobalOrdinal *row_ptr,
+                                 int *local_cols);
 
 goma_error g_epetra_complete_graph(GomaSparseMatrix matrix);
 
@@ -3,6 +3,7 @@
 #ifdef GOMA_ENABLE_TPETRA
 #ifdef __cplusplus
 #include "Teuchos_RCP.hpp"
+#include <Kokkos_Core.hpp>
 #include <Tpetra_FECrsMatrix.hpp>
 
 #include "linalg/sparse_matrix.h"
@@ -15,6 +16,8 @@ struct TpetraSparseMatrix {
   Teuchos::RCP<Tpetra::Map<LO, GO>> row_map;
   Teuchos::RCP<Tpetra::Map<LO, GO>> col_map;
   Teuchos::RCP<Tpetra::FECrsGraph<LO, GO>> crs_graph;
+  // column equilibration of each local row's unknown since the last assembly
+  Kokkos::View<double *, Tpetra::FECrsMatrix<double, LO, GO>::device_type> col_scale;
   TpetraSparseMatrix() = default;
 };
 
@@ -30,8 +33,8 @@ goma_error g_tpetra_create_graph(GomaSparseMatrix matrix,
                                  GomaGlobalOrdinal *col_list,
                                  GomaGlobalOrdinal local_nnz,
                                  GomaGlobalOrdinal max_per_row,
-                                 GomaGlobalOrdinal *coo_rows,
-                                 GomaGlobalOrdinal *coo_cols);
+                                 GomaGlobalOrdinal *row_ptr,
+                                 int *local_cols);
 
 goma_error g_tpetra_complete_graph(GomaSparseMatrix matrix);
 
@@ -55,6 +58,13 @@ goma_error g_tpetra_zero_row(GomaSparseMatrix matrix, GomaGlobalOrdinal global_r
 
 goma_error g_tpetra_zero_row_set_diag(GomaSparseMatrix matrix, GomaGlobalOrdinal global_row);
 
+goma_error g_tpetra_zero_local_rows(GomaSparseMatrix matrix,
+                                    int num_rows,
+                                    int *local_rows,
+                                    int set_diag);
+
+goma_error g_tpetra_unscale_solution(GomaSparseMatrix matrix, double *x);
+
 goma_error g_tpetra_destroy(GomaSparseMatrix matrix);
 
 #ifdef __cplusplus
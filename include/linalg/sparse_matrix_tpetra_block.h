@@ -0,0 +1,71 @@
+#ifndef GOMA_SPARSE_MATRIX_TPETRA_BLOCK
+#define GOMA_SPARSE_MATRIX_TPETRA_BLOCK
+#ifdef GOMA_ENABLE_TPETRA
+#ifdef __cplusplus
+#include "Teuchos_RCP.hpp"
+#include <Tpetra_BlockCrsMatrix.hpp>
+#include <Tpetra_CrsGraph.hpp>
+
+#include "linalg/sparse_matrix.h"
+
+using LO = int;
+using GO = GomaGlobalOrdinal;
+
+// Node blocked matrix, one block row per node with block_size unknowns,
+// the point maps used by solvers are the matrix domain and range maps
+struct TpetraBlockSparseMatrix {
+  Teuchos::RCP<Tpetra::BlockCrsMatrix<double, LO, GO>> matrix;
+  Teuchos::RCP<Tpetra::Map<LO, GO>> row_map;
+  Teuchos::RCP<Tpetra::Map<LO, GO>> col_map;
+  Teuchos::RCP<Tpetra::CrsGraph<LO, GO>> crs_graph;
+  TpetraBlockSparseMatrix() = default;
+};
+
+extern "C" {
+#endif
+
+goma_error GomaSparseMatrix_TpetraBlock_Create(GomaSparseMatrix *matrix);
+
+goma_error g_tpetra_block_create_graph(GomaSparseMatrix matrix,
+                                       GomaGlobalOrdinal n_rows,
+                                       GomaGlobalOrdinal *row_list,
+                                       GomaGlobalOrdinal n_cols,
+                                       GomaGlobalOrdinal *col_list,
+                                       GomaGlobalOrdinal local_nnz,
+                                       GomaGlobalOrdinal max_per_row,
+                                       GomaGlobalOrdinal *row_ptr,
+                                       int *local_cols);
+
+goma_error g_tpetra_block_insert_row_values(GomaSparseMatrix matrix,
+                                            GomaGlobalOrdinal global_row,
+                                            GomaGlobalOrdinal num_entries,
+                                            double *values,
+                                            GomaGlobalOrdinal *indices);
+
+goma_error g_tpetra_block_sum_into_row_values(GomaSparseMatrix matrix,
+                                              GomaGlobalOrdinal global_row,
+                                              GomaGlobalOrdinal num_entries,
+                                              double *values,
+                                              GomaGlobalOrdinal *indices);
+
+goma_error g_tpetra_block_sum_into_block_row_values(GomaSparseMatrix matrix,
+                                                    int local_block_row,
+                                                    int num_blocks,
+                                                    double *values,
+                                                    int *local_block_cols);
+
+goma_error g_tpetra_block_put_scalar(GomaSparseMatrix matrix, double scalar);
+
+goma_error g_tpetra_block_row_sum_scaling(GomaSparseMatrix matrix, double *b, double *scale);
+
+goma_error g_tpetra_block_zero_row(GomaSparseMatrix matrix, GomaGlobalOrdinal global_row);
+
+goma_error g_tpetra_block_zero_row_set_diag(GomaSparseMatrix matrix, GomaGlobalOrdinal global_row);
+
+goma_error g_tpetra_block_destroy(GomaSparseMatrix matrix);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
+#endif // GOMA_SPARSE_MATRIX_TPETRA_BLOCK
@@ -39,4 +39,34 @@ EXTERN void get_date(char *); /* string - fill in with mm/dd/yy */
 
 EXTERN void get_time(char *); /* string - fill in with hh:mm:ss */
 
+EXTERN dbl wall_time /* monotonic wall clock time in seconds */
+    (void);
+
+/*
+ * Region profiler, enabled with the -profile command line option
+ *
+ * Regions nest: a region begun while another is open is recorded as its
+ * child. Use the macros so that a disabled profiler costs one test.
+ * Names are expected to be string literals.
+ */
+extern int Goma_Profile; /* TRUE when the region profiler is enabled */
+
+EXTERN void goma_prof_begin(const char *); /* name - region name */
+
+EXTERN void goma_prof_end(const char *); /* name - region name */
+
+EXTERN void goma_prof_summary(void); /* write per-rank and reduced summaries */
+
+#define GOMA_PROF_BEGIN(name) \
+  do {                        \
+    if (Goma_Profile)         \
+      goma_prof_begin(name);  \
+  } while (0)
+
+#define GOMA_PROF_END(name) \
+  do {                      \
+    if (Goma_Profile)       \
+      goma_prof_end(name);  \
+  } while (0)
+
 #endif /* GOMA_MD_TIMER_H */
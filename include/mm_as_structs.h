@@ -138,9 +138,15 @@ typedef char CK_NAME_STR[64];
 
 #define LEC_R_INDEX(peqn_macro, index_macro) ((lec->max_dof * (peqn_macro)) + index_macro)
 
-#define LEC_J_INDEX(peqn_macro, pvar_macro, index_i, index_j)                  \
-  (((MAX_PROB_VAR + MAX_CONC) * lec->max_dof * lec->max_dof) * (peqn_macro)) + \
-      ((lec->max_dof * lec->max_dof) * (pvar_macro)) + (lec->max_dof * (index_i)) + index_j
+/*
+ * lec->J only holds blocks for the equation/variable descriptions that are
+ * in use; lec->desc_slot[] maps a peqn/pvar to its block (see
+ * setup_lec_layout()).
+ */
+#define LEC_J_INDEX(peqn_macro, pvar_macro, index_i, index_j)                            \
+  ((((lec->num_desc * lec->max_dof * lec->max_dof) * lec->desc_slot[(peqn_macro)]) +     \
+    ((lec->max_dof * lec->max_dof) * lec->desc_slot[(pvar_macro)]) +                     \
+    (lec->max_dof * (index_i)) + (index_j)))
 
 #define LEC_J_STRESS_INDEX(peqn, pvar, index_i, index_j)          \
   ((lec->max_dof * MAX_LOCAL_VAR_DESC * lec->max_dof) * (peqn)) + \
@@ -748,6 +754,9 @@ struct Element_Quality_Metrics {
 
 struct Local_Element_Contributions {
   int max_dof;
+  int num_desc;                          /* Number of blocks in each direction of J */
+  int desc_slot[MAX_LOCAL_VAR_DESC];     /* Block of J holding peqn/pvar, unused
+                                          * descriptions share the last block */
   dbl *R;
   dbl *J;
   /* For face m and  mode k we have for mode imode
@@ -919,6 +928,19 @@ struct Uniform_Problem_Description {
   int disable_supg_tau_sensitivities;
   int supg_lagged_tau;
   dbl Residual_Relative_Tol[MAX_NUM_MATRICES];
+  int Geometry_Cache;        /* Cache element mappings on fixed meshes, GEOMETRY_CACHE_* */
+  int Geometry_Cache_Max_MB; /* Upper bound on the geometry cache size */
+  int Overlap_Dof_Exchange;  /* Assemble owned-node elements while ghost dofs are in flight */
+  int Precond_Reuse;         /* Stratimikos preconditioner reuse policy, PRECOND_REUSE_* */
+  int Precond_Reuse_Steps;   /* Newton or time steps a preconditioner is kept for */
+  dbl Precond_Reuse_Growth;  /* Rebuild early when linear iterations grow by this factor */
+  int Newton_Forcing;        /* Inexact Newton forcing term, FORCING_* */
+  dbl Newton_Forcing_Max;    /* Largest allowed forcing term */
+  int Matrix_Free;           /* Jacobian free Krylov operator, MATRIX_FREE_* */
+  int Matrix_Free_Lag;       /* Newton steps the assembled preconditioner matrix is kept */
+  int Matrix_Equilibration;  /* Row, column or symmetric scaling, EQUILIBRATE_* */
+  int Linear_Solve_Precision[MAX_NUM_MATRICES]; /* LINEAR_PRECISION_* */
+  int Refinement_Max_Steps[MAX_NUM_MATRICES];   /* Iterative refinement steps for mixed */
 };
 typedef struct Uniform_Problem_Description UPD_STRUCT;
 /*____________________________________________________________________________*/
@@ -2773,11 +2795,14 @@ struct LS_Surf {
   struct LS_Surf *next;
 };
 
+struct LS_Surf_Search_Tree; /* bounding volume hierarchy, mm_fill_ls.c */
+
 struct LS_Surf_List {
   int size;
   struct LS_Surf *start;
   struct LS_Surf *current;
   struct LS_Surf *end;
+  struct LS_Surf_Search_Tree *tree; /* NULL unless built by create_subsurfs */
 };
 
 struct LS_Surf_Point_Data {
@@ -2856,6 +2881,7 @@ struct Level_Set_Data {
   int adapt_freq;
   double Control_Width;
   double Renorm_Tolerance;
+  double Renorm_Band;
   int Renorm_Method;
   int Search_Option;
   int Grid_Search_Depth;
@@ -121,6 +121,8 @@ EXTERN int matrix_fill_stress(struct GomaLinearSolverData *,
                                          * frontal solver                            */
                               int);     /* zeroCA */
 
+EXTERN void element_ghost_flags_free(void);
+
 EXTERN int checkfinite(const char *file,
                        const int line,       /* line                                      */
                        const char *message); /* message                                   */
@@ -0,0 +1,75 @@
+/************************************************************************ *
+* Goma - Multiphysics finite element software                             *
+* Sandia National Laboratories                                            *
+*                                                                         *
+* Copyright (c) 2022 Goma Developers, National Technology & Engineering   *
+*               Solutions of Sandia, LLC (NTESS)                          *
+*                                                                         *
+* Under the terms of Contract DE-NA0003525, the U.S. Government retains   *
+* certain rights in this software.                                        *
+*                                                                         *
+* This software is distributed under the GNU General Public License.      *
+* See LICENSE file.                                                       *
+\************************************************************************/
+
+/*
+ * mm_fill_block.h -- element block context for block-wise assembly
+ *
+ * matrix_fill_full visits the elements one element block at a time. The
+ * quantities that are the same for every element of a block (block index,
+ * material, element type, quadrature count, discontinuous interpolation
+ * flags, problem description) are gathered once into an Element_Block_Context
+ * which load_ei and matrix_fill use instead of searching for them again
+ * for every element.
+ */
+
+#ifndef GOMA_MM_FILL_BLOCK_H
+#define GOMA_MM_FILL_BLOCK_H
+
+#include "exo_struct.h"
+#include "mm_as_structs.h"
+#include "std.h"
+
+typedef struct Element_Block_Context {
+  int ebn;             /* Element block index */
+  int eb_id;           /* Exodus element block id */
+  int mn;              /* Material index, Matilda[ebn] */
+  int imtrx;           /* Matrix the context was built for */
+  int e_start;         /* Elements of the block are e_start .. e_end-1 */
+  int e_end;
+  int ielem_type;      /* Element type of the block */
+  int ielem_shape;     /* Element shape of ielem_type */
+  int ielem_dim;       /* Physical dimension of ielem_type */
+  int num_local_nodes; /* Nodes per element */
+  int num_sides;       /* Sides per element */
+  int ip_total;        /* Regular volume quadrature points */
+  int discontinuous_mass;   /* Discontinuous Galerkin species interpolation */
+  int ielem_type_mass;      /* Element type for DG species, -1 if not DG */
+  int discontinuous_stress; /* Discontinuous Galerkin stress interpolation */
+  PROBLEM_DESCRIPTION_STRUCT *pd;
+  MATRL_PROP_STRUCT *mp;
+} Element_Block_Context;
+
+/*
+ * Context of the block currently being assembled by matrix_fill_full,
+ * NULL outside of the block loop.
+ */
+extern Element_Block_Context *Current_Block_Context;
+
+extern void element_block_context_load(Element_Block_Context *, /* ctx - context to fill */
+                                       const int,               /* ebn - element block index */
+                                       const Exo_DB *,          /* exo */
+                                       const int);              /* imtrx */
+
+extern void element_block_dg_types(const PROBLEM_DESCRIPTION_STRUCT *, /* pd */
+                                   const int,                          /* imtrx */
+                                   int *,  /* discontinuous_mass */
+                                   int *,  /* ielem_type_mass */
+                                   int *); /* discontinuous_stress */
+
+/* TRUE if elem is inside the block described by the current context */
+#define BLOCK_CONTEXT_HAS_ELEM(elem)                                                   \
+  (Current_Block_Context != NULL && (elem) >= Current_Block_Context->e_start &&          \
+   (elem) < Current_Block_Context->e_end)
+
+#endif /* GOMA_MM_FILL_BLOCK_H */
@@ -0,0 +1,43 @@
+/************************************************************************ *
+* Goma - Multiphysics finite element software                             *
+* Sandia National Laboratories                                            *
+*                                                                         *
+* Copyright (c) 2022 Goma Developers, National Technology & Engineering   *
+*               Solutions of Sandia, LLC (NTESS)                          *
+*                                                                         *
+* Under the terms of Contract DE-NA0003525, the U.S. Government retains   *
+* certain rights in this software.                                        *
+*                                                                         *
+* This software is distributed under the GNU General Public License.      *
+* See LICENSE file.                                                       *
+\************************************************************************/
+
+/*
+ * mm_fill_geom_cache.h -- element mapping cache for fixed meshes
+ *
+ * Without mesh motion the mapping Jacobian, its inverse and determinant
+ * at a volume quadrature point only depend on the element and the point.
+ * With "Geometry Cache" enabled they are computed by beer_belly() the first
+ * time an element is assembled and restored from the cache afterwards.
+ */
+
+#ifndef GOMA_MM_FILL_GEOM_CACHE_H
+#define GOMA_MM_FILL_GEOM_CACHE_H
+
+#include "exo_struct.h"
+
+/* upd->Geometry_Cache */
+#define GEOMETRY_CACHE_NONE   0
+#define GEOMETRY_CACHE_DOUBLE 1
+#define GEOMETRY_CACHE_SINGLE 2
+
+/* Default upper bound on the cache size, upd->Geometry_Cache_Max_MB */
+#define GEOMETRY_CACHE_DEFAULT_MB 512
+
+extern int geometry_cache_beer_belly(const int,       /* ielem - element number */
+                                     const int,       /* ip - regular quadrature point, or -1 */
+                                     const Exo_DB *); /* exo */
+
+extern void geometry_cache_free(void);
+
+#endif /* GOMA_MM_FILL_GEOM_CACHE_H */
@@ -0,0 +1,64 @@
+/************************************************************************ *
+* Goma - Multiphysics finite element software                             *
+* Sandia National Laboratories                                            *
+*                                                                         *
+* Copyright (c) 2022 Goma Developers, National Technology & Engineering   *
+*               Solutions of Sandia, LLC (NTESS)                          *
+*                                                                         *
+* Under the terms of Contract DE-NA0003525, the U.S. Government retains   *
+* certain rights in this software.                                        *
+*                                                                         *
+* This software is distributed under the GNU General Public License.      *
+* See LICENSE file.                                                       *
+\************************************************************************/
+
+/*
+ * mm_fill_scatter.h -- element to global scatter maps for loading the lec
+ *
+ * The rows and columns an element contributes to depend only on the
+ * unknown map, which is fixed between remeshes. The scatter map of an
+ * element records them once so that loading the local element
+ * contributions into the global system needs no Index_Solution() calls.
+ */
+
+#ifndef GOMA_MM_FILL_SCATTER_H
+#define GOMA_MM_FILL_SCATTER_H
+
+/*
+ * rows[LEC_SCATTER_ROW_SIZE * r + ...] for each owned row r of the element
+ */
+#define LEC_SCATTER_ROW_INDEX 0 /* processor unknown number of the row */
+#define LEC_SCATTER_ROW_PE    1 /* lec equation index (pe) */
+#define LEC_SCATTER_ROW_DOF   2 /* lec row dof (i) */
+#define LEC_SCATTER_ROW_EQN   3 /* equation type, for Inter_Mask */
+#define LEC_SCATTER_ROW_SIZE  4
+
+/*
+ * blocks[LEC_SCATTER_BLK_SIZE * b + ...] for each column variable block b
+ */
+#define LEC_SCATTER_BLK_VAR   0 /* variable type, for Inter_Mask */
+#define LEC_SCATTER_BLK_PV    1 /* lec variable index (pv) */
+#define LEC_SCATTER_BLK_START 2 /* first entry of the block in cols[] */
+#define LEC_SCATTER_BLK_NCOL  3 /* number of columns (lec column dofs j) */
+#define LEC_SCATTER_BLK_SIZE  4
+
+struct Lec_Scatter {
+  int nrows;   /* Number of owned residual rows */
+  int nblocks; /* Number of (variable, species) column blocks */
+  int ncols;   /* Total number of columns over all blocks */
+  int *rows;   /* [LEC_SCATTER_ROW_SIZE*nrows] */
+  int *blocks; /* [LEC_SCATTER_BLK_SIZE*nblocks] */
+  int *cols;   /* [ncols] - processor unknown numbers of the columns */
+};
+
+extern const struct Lec_Scatter *lec_scatter_get(const int, /* ielem */
+                                                 const int  /* imtrx */
+);
+
+extern int *lec_scatter_column_map(const int, /* imtrx */
+                                   const int  /* ncols - length of the map */
+);
+
+extern void lec_scatter_free(void);
+
+#endif /* GOMA_MM_FILL_SCATTER_H */
@@ -108,6 +108,8 @@ EXTERN int load_bf_mesh_derivs(void);
 EXTERN int load_basis_functions(const double[], /*  xi - local element coordinates [DIM]     */
                                 struct Basis_Functions **); /* bfa - pointer to basis function */
 
+EXTERN void basis_tab_free(void);
+
 EXTERN void asdv(double **,  /* v - vector to be allocated */
                  const int); /* n - number of elements in vector */
 
@@ -57,6 +57,8 @@ extern int Index_Solution(const int nodeNum,     /* Global Node Number
                           const int imtrx        /* Matrix ID */
 );
 
+extern void nodal_vars_index_tables_build(void);
+
 extern int variable_type_nodalInterp(int);
 
 extern VARIABLE_DESCRIPTION_STRUCT *Index_Solution_Inv(const int, int *, int *, int *, int *, int);
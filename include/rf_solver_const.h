@@ -39,6 +39,49 @@
 
 #define NLS_FULL_STEP 0
 #define NLS_BACKTRACK 1
+
+/*
+ * Stratimikos preconditioner reuse policies
+ */
+#define PRECOND_REUSE_NONE   0 /* Build a new preconditioner for every solve */
+#define PRECOND_REUSE_NEWTON 1 /* Keep the preconditioner for a number of Newton steps */
+#define PRECOND_REUSE_TIME   2 /* Keep the preconditioner for a number of time steps */
+
+/*
+ * Inexact Newton forcing terms, the relative linear tolerance of each Newton step
+ */
+#define FORCING_FIXED 0 /* Matrix convergence tolerance for every step */
+#define FORCING_EW1   1 /* Eisenstat-Walker choice 1, linear model agreement */
+#define FORCING_EW2   2 /* Eisenstat-Walker choice 2, residual reduction rate */
+
+/*
+ * Jacobian free Newton-Krylov, the assembled matrix only preconditions
+ */
+#define MATRIX_FREE_NONE 0 /* Krylov solver uses the assembled Jacobian */
+#define MATRIX_FREE_FD   1 /* J v from finite differences of the residual */
+
+/*
+ * Equilibration of the assembled system before the linear solve
+ */
+#define EQUILIBRATE_ROW       0 /* Rows by their absolute row sums */
+#define EQUILIBRATE_COLUMN    1 /* Columns by their absolute column sums */
+#define EQUILIBRATE_SYMMETRIC 2 /* Rows and columns by square roots of both sums */
+
+/*
+ * Precision of the factorization used by the linear solve
+ */
+#define LINEAR_PRECISION_DOUBLE 0 /* Factor and solve in double precision */
+#define LINEAR_PRECISION_MIXED  1 /* Single precision factors, double refinement */
+
+#define REFINEMENT_DEFAULT_TOL 1.0e-12 /* Mixed refinement target without Residual Ratio Tol */
+
+/*
+ * Outcome of a mixed precision refinement, returned by amesos2_solve
+ */
+#define REFINEMENT_CONVERGED 0 /* Relative residual reached the tolerance */
+#define REFINEMENT_MAXITS    1 /* Steps ran out or stalled, best iterate returned */
+#define REFINEMENT_DIVERGED  2 /* Refinement could not improve on one solve */
+
 /*
  * Kinds of solvers available...
  */
@@ -170,6 +170,14 @@ struct Nodal_Vars {
                       * from the list of variables in the solution
                       * vector corresponding to this node.
                       */
+  short int *Index_Table;
+  /* Index into Var_Desc_List of the variable description that
+   * Index_Solution() matches for each (variable type, species,
+   * material id) triple, or -1 if there is none.
+   * Length = (V_LAST + Max_Num_Species_Eqn) * (Num_Mat + 2)
+   * Built by nodal_vars_index_tables_build() once the nodal
+   * variables are complete, NULL before then.
+   */
 };
 typedef struct Nodal_Vars NODAL_VARS_STRUCT;
 
@@ -11,6 +11,7 @@ extern "C" {
 int amesos2_solve(struct GomaLinearSolverData *ams,
                   double *x_,
                   double *b_,
+                  int *iterations,
                   char *amesos2_solver,
                   char *amesos2_file);
 
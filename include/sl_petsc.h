@@ -31,6 +31,9 @@ typedef struct PetscPCDData {
   PetscBool pcd_inverse_diag;
 } PetscPCDData;
 
+/* Residual of the Newton system at x, scaled like the assembled rows */
+typedef int (*PetscMatrixFreeResidual)(void *ctx, double *x, double *resid);
+
 typedef struct PetscMatrixData {
   PetscOptions options;
   PetscBool mat_entries_set;
@@ -51,6 +54,13 @@ typedef struct PetscMatrixData {
   PetscInt pcd_ns_remove_n;
   PetscInt *pcd_ns_remove;
   PetscInt *real_to_complex;
+  Mat mat_free;                        /* matrix free Jacobian, NULL unless Matrix Free Newton */
+  Vec mf_base;                         /* Newton iterate J is linearized about */
+  Vec mf_base_resid;                   /* residual at mf_base */
+  PetscMatrixFreeResidual mf_residual; /* residual evaluation for the differences */
+  void *mf_ctx;
+  double *mf_x;     /* local work vectors including external dofs */
+  double *mf_resid;
 } PetscMatrixData;
 
 PetscErrorCode petsc_PCD_setup(PC ppc,
@@ -95,6 +105,13 @@ goma_error petsc_scale_matrix(struct GomaLinearSolverData *ams, double *b_, doub
 
 goma_error goma_petsc_free_matrix(struct GomaLinearSolverData *ams);
 int petsc_zero_mat(struct GomaLinearSolverData *ams);
+
+goma_error petsc_matrix_free_set_base(struct GomaLinearSolverData *ams,
+                                      PetscMatrixFreeResidual residual,
+                                      void *ctx,
+                                      double *x,
+                                      double *resid,
+                                      PetscBool reuse_preconditioner);
 #endif
 #endif
 #endif // GOMA_SL_PETSC_H
@@ -54,6 +54,7 @@ struct GomaLinearSolverData;
 #define SM_OBJECT         8
 #define HUYGENS_MASS_ITER 9
 #define SMOLIANSKI_ONLY   10
+#define FAST_MARCHING     11
 
 #define LS_SURF_POINT      0
 #define LS_SURF_PLANE      1
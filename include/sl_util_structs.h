@@ -109,6 +109,9 @@ struct GomaLinearSolverData {
 
   int solveSetup;
 
+  double forcingTol;  /* relative linear tolerance for this solve, 0 for the solver settings */
+  double achievedTol; /* relative linear residual reached by the last solve, 0 if unknown */
+
   void *PetscMatrixData;
   void *GomaMatrixData;
   void *SolverData;
@@ -10,6 +10,10 @@ extern "C" {
 
 // Find the current distance for all nodes given the nodesets and sidesets to compare against
 // returns distance array of size exo->num_nodes
+//
+// Distances are measured to the side set facets (and node set nodes), the wall
+// and its search tree persist between calls for the same sets and are only
+// rebuilt when the displacements move the wall
 goma_error find_current_distances(Exo_DB *exo,
                                   Dpi *dpi,
                                   double *solution_vector,
@@ -20,6 +24,10 @@ goma_error find_current_distances(Exo_DB *exo,
                                   int *ss_ids,
                                   double *distances);
 
+// Drop the persistent wall distance engines, e.g. before the problem is set
+// up again on a new mesh
+void wall_distance_engines_free(void);
+
 #ifdef __cplusplus
 }
 #endif
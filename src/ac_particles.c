@@ -177,6 +177,10 @@ static void add_to_send_list(particle_t *);
 
 static void add_to_do_list(particle_t *);
 
+#ifdef PARALLEL
+static void exchange_particles(void);
+#endif
+
 static void couple_to_continuum(void);
 
 static void load_restart_file(void);
@@ -1289,14 +1293,11 @@ int compute_particles(const Exo_DB *exo,         /* mesh */
   particle_t *p, *p_tmp;
   int i, el_index;
 #ifdef PARALLEL
-  int mpi_byte_count, mpi_retval;
-  particle_t termination_p, send_p, recv_p;
-  int j, done, local_max_particle_iterations, local_max_newton_iterations;
+  int done, local_max_particle_iterations, local_max_newton_iterations;
   int local_num_particles, local_particle_transfers, particle_transfers;
   dbl local_total_accum_ust, local_particle_accum_ust, local_output_accum_ust,
       local_communication_accum_ust;
   int local_num_to_send, num_to_send;
-  MPI_Status mpi_status;
 #endif
 
   total_accum_ust = 0.0;
@@ -1437,94 +1438,11 @@ int compute_particles(const Exo_DB *exo,         /* mesh */
     else
       done = 0;
 
-    zero_a_particle(&termination_p);
-    termination_p.state = TERMINATION_MARKER;
     while (!done) {
-      /* This next loop does a full all processor to all processor
-       * exchange of particles.  This is done before any other moves are
-       * completed. */
-      for (i = 0; i < Num_Proc; i++) {
-        if (i == ProcID) /* I'm the sender! */
-        {
-          p = particles_to_send;
-          particles_to_send = NULL;
-          while (p) {
-            p_tmp = p->next;
-            /*
-              fprintf(stderr, "Proc %d is sending a particle to proc %d\n", i, p->owning_proc_id);
-              fflush(stderr);
-            */
-            memcpy(&send_p, p, sizeof(particle_t));
-            mpi_retval = MPI_Send(&send_p, sizeof(particle_t), MPI_BYTE, p->owning_proc_id, 0,
-                                  MPI_COMM_WORLD);
-            if (mpi_retval != MPI_SUCCESS) {
-              fprintf(stderr, "Proc %d failed on particle send (%d).\n", ProcID, mpi_retval);
-              exit(-1);
-            }
-            free(p);
-            p = p_tmp;
-          }
-          for (j = 0; j < Num_Proc; j++)
-            if (i == j)
-              continue;
-            else {
-              /*
-                fprintf(stderr, "Proc %d is sending the TERMINATION_MARKER to proc %d\n", i, j);
-                fflush(stderr);
-              */
-              mpi_retval =
-                  MPI_Send(&termination_p, sizeof(particle_t), MPI_BYTE, j, 0, MPI_COMM_WORLD);
-              if (mpi_retval != MPI_SUCCESS) {
-                fprintf(stderr, "Proc %d failed on TERMINATION_MARKER send (%d).\n", ProcID,
-                        mpi_retval);
-                exit(-1);
-              }
-            }
-        } else {
-          recv_p.state = ACTIVE;
-          while (recv_p.state != TERMINATION_MARKER) {
-            mpi_retval =
-                MPI_Recv(&recv_p, sizeof(particle_t), MPI_BYTE, i, 0, MPI_COMM_WORLD, &mpi_status);
-            if (mpi_retval != MPI_SUCCESS) {
-              fprintf(stderr, "Proc %d failed on particle receive (%d).\n", ProcID, mpi_retval);
-              exit(-1);
-            }
-            MPI_Get_count(&mpi_status, MPI_BYTE, &mpi_byte_count);
-
-            /*
-              fprintf(stderr, "Proc %d received a particle from proc %d with state = %d\n
-              MPI_SOURCE/TAG/ERROR = %d/%d/%d, MPI_Count = %d.\n", ProcID, i, recv_p.state,
-              mpi_status.MPI_SOURCE, mpi_status.MPI_TAG, mpi_status.MPI_ERROR, mpi_byte_count);
-              fflush(stderr);
-            */
-            if (mpi_byte_count != sizeof(particle_t)) {
-              fprintf(stderr, "Proc %d did not have proper incoming byte count!\n", ProcID);
-              fflush(stderr);
-              MPI_Finalize();
-              exit(-1);
-            }
-
-            if (recv_p.state != TERMINATION_MARKER) {
-              add_to_do_list(&recv_p);
-              /*
-                fprintf(stderr, "Proc %d is adding a particle to its to do list.\n", ProcID);
-                fflush(stderr);
-              */
-              /*
-                dump(NO_EXIT, &termination_p, "Rcvd by proc %d.\n", ProcID);
-              */
-            }
-          }
-        }
-        mpi_retval = MPI_Barrier(MPI_COMM_WORLD);
-        /*
-          fprintf(stderr, "Proc %d BARRIER\n", ProcID);
-        */
-        if (mpi_retval != MPI_SUCCESS) {
-          fprintf(stderr, "Proc %d failed on MPI_BARRIER (%d).\n", ProcID, mpi_retval);
-          exit(-1);
-        }
-      }
+      /* All processor to all processor exchange of particles, one
+       * aggregated message per neighbor.  This is done before any
+       * other moves are completed. */
+      exchange_particles();
 
       /* Now we move the new particles. */
       local_num_to_send = 0;
@@ -4702,6 +4620,94 @@ static void add_to_do_list(particle_t *p) {
   p_recv->state = ACTIVE;
 }
 
+#ifdef PARALLEL
+/* This routine ships everything on the outgoing send list to its
+ * owning processor and puts what arrives on the incoming list.  The
+ * particles bound for each processor are packed into one contiguous
+ * buffer so there is a single message per neighbor, and only
+ * processors that actually exchange particles post a send/receive. */
+static void exchange_particles(void) {
+  particle_t *p, *p_tmp, *send_buf, *recv_buf;
+  int *send_count, *recv_count, *send_offset, *recv_offset, *fill;
+  int i, num_send, num_recv, num_req, mpi_retval;
+  MPI_Request *requests;
+
+  send_count = (int *)calloc(4 * Num_Proc, sizeof(int));
+  if (!send_count)
+    GOMA_EH(GOMA_ERROR, "Could not malloc particle exchange counts.");
+  recv_count = send_count + Num_Proc;
+  send_offset = recv_count + Num_Proc;
+  recv_offset = send_offset + Num_Proc;
+
+  num_send = 0;
+  for (p = particles_to_send; p; p = p->next) {
+    if (p->owning_proc_id < 0 || p->owning_proc_id >= Num_Proc)
+      dump1(EXIT, p, "Particle transfer to a nonexistent processor.");
+    send_count[p->owning_proc_id]++;
+    num_send++;
+  }
+
+  mpi_retval = MPI_Alltoall(send_count, 1, MPI_INT, recv_count, 1, MPI_INT, MPI_COMM_WORLD);
+  if (mpi_retval != MPI_SUCCESS)
+    GOMA_EH(GOMA_ERROR, "Failed on particle count exchange.");
+
+  num_recv = 0;
+  for (i = 0; i < Num_Proc; i++) {
+    send_offset[i] = (i == 0) ? 0 : send_offset[i - 1] + send_count[i - 1];
+    recv_offset[i] = num_recv;
+    num_recv += recv_count[i];
+  }
+
+  send_buf = (particle_t *)malloc(MAX(num_send, 1) * sizeof(particle_t));
+  recv_buf = (particle_t *)malloc(MAX(num_recv, 1) * sizeof(particle_t));
+  requests = (MPI_Request *)malloc(2 * Num_Proc * sizeof(MPI_Request));
+  fill = (int *)malloc(Num_Proc * sizeof(int));
+  if (!send_buf || !recv_buf || !requests || !fill)
+    GOMA_EH(GOMA_ERROR, "Could not malloc particle exchange buffers.");
+
+  /* Pack, grouped by destination.  Once packed the space is free()'ed. */
+  memcpy(fill, send_offset, Num_Proc * sizeof(int));
+  p = particles_to_send;
+  particles_to_send = NULL;
+  while (p) {
+    p_tmp = p->next;
+    memcpy(&send_buf[fill[p->owning_proc_id]++], p, sizeof(particle_t));
+    free(p);
+    p = p_tmp;
+  }
+
+  num_req = 0;
+  for (i = 0; i < Num_Proc; i++)
+    if (recv_count[i]) {
+      mpi_retval =
+          MPI_Irecv(&recv_buf[recv_offset[i]], recv_count[i] * (int)sizeof(particle_t), MPI_BYTE,
+                    i, 0, MPI_COMM_WORLD, &requests[num_req++]);
+      if (mpi_retval != MPI_SUCCESS)
+        GOMA_EH(GOMA_ERROR, "Failed on particle receive.");
+    }
+  for (i = 0; i < Num_Proc; i++)
+    if (send_count[i]) {
+      mpi_retval =
+          MPI_Isend(&send_buf[send_offset[i]], send_count[i] * (int)sizeof(particle_t), MPI_BYTE,
+                    i, 0, MPI_COMM_WORLD, &requests[num_req++]);
+      if (mpi_retval != MPI_SUCCESS)
+        GOMA_EH(GOMA_ERROR, "Failed on particle send.");
+    }
+  mpi_retval = MPI_Waitall(num_req, requests, MPI_STATUSES_IGNORE);
+  if (mpi_retval != MPI_SUCCESS)
+    GOMA_EH(GOMA_ERROR, "Failed waiting on particle exchange.");
+
+  for (i = 0; i < num_recv; i++)
+    add_to_do_list(&recv_buf[i]);
+
+  free(fill);
+  free(requests);
+  free(recv_buf);
+  free(send_buf);
+  free(send_count);
+}
+#endif
+
 /* This routine handles whatever needs to be saved off, etc., to
  * influence the continuum solution with repsect to the particles'
  * presence.  It assumes that all particles contribute (irresepective
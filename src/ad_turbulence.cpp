@@ -381,12 +381,15 @@ int ad_load_bf_grad(void) {
   /* zero array for initialization */
   /*  v_length = DIM*DIM*DIM*MDE;
       init_vec_value(zero_array, 0., v_length); */
-  if (ad_fv->basis.empty()) {
-    ad_fv->basis.resize(V_LAST);
+  if (ad_fv->basis.slots.empty()) {
+    ad_fv->basis.slots.resize(V_LAST);
   }
 
   for (int v = V_FIRST; v < V_LAST; v++) {
     if (pd->gv[v]) {
+      if (!ad_fv->basis.slots[v]) {
+        ad_fv->basis.slots[v] = std::make_unique<AD_Basis>();
+      }
 
       bfv = bf[v];
       dofs = ei[upd->matrix_index[v]]->dof[v];
@@ -503,6 +506,13 @@ extern "C" void fill_ad_field_variables() {
     // }
   }
 
+#if defined(GOMA_AD_MAX_DERIVATIVES) && GOMA_AD_MAX_DERIVATIVES > 0
+  if (num_ad_variables > GOMA_AD_MAX_DERIVATIVES) {
+    GOMA_EH(GOMA_ERROR,
+            "Element %d has %d AD variables, Goma was built with GOMA_AD_MAX_DERIVATIVES = %d",
+            ad_fv->ielem, num_ad_variables, GOMA_AD_MAX_DERIVATIVES);
+  }
+#endif
   ad_fv->total_ad_variables = num_ad_variables;
 
   ad_beer_belly();
@@ -7,6 +7,7 @@
 #include <rf_solve.h>
 #include <string.h>
 
+#include "dp_comm.h"
 #include "dp_map_comm_vec.h"
 #include "dp_types.h"
 #include "dpi.h"
@@ -14,6 +15,9 @@
 #include "mm_as.h"
 #include "mm_as_structs.h"
 #include "mm_eh.h"
+#include "mm_fill.h"
+#include "mm_fill_geom_cache.h"
+#include "mm_fill_scatter.h"
 #include "mm_unknown_map.h"
 #include "rf_fem.h"
 #include "rf_fem_const.h"
@@ -25,6 +29,7 @@
 #include "rf_util.h"
 #include "rf_vars_const.h"
 #include "sl_util_structs.h"
+#include "util/distance_helpers.h"
 
 int resetup_problem(Exo_DB *exo, /* ptr to the finite element mesh database */
                     Dpi *dpi)    /* distributed processing information */
@@ -45,6 +50,13 @@ int resetup_problem(Exo_DB *exo, /* ptr to the finite element mesh database */
  **********************************************************************/
 {
 
+  /* element scatter maps, dof exchanges and the other mesh caches refer to the old mesh */
+  lec_scatter_free();
+  geometry_cache_free();
+  exchange_dof_free();
+  element_ghost_flags_free();
+  wall_distance_engines_free();
+
   pre_process(exo);
   /*
    *  Initialize nodal based structures pertaining to properties
@@ -189,7 +201,8 @@ int resetup_problem(Exo_DB *exo, /* ptr to the finite element mesh database */
 }
 
 int resetup_matrix(struct GomaLinearSolverData **ams, Exo_DB *exo, Dpi *dpi) {
-  if ((strcmp(Matrix_Format, "tpetra") == 0) || (strcmp(Matrix_Format, "epetra") == 0)) {
+  if ((strcmp(Matrix_Format, "tpetra") == 0) || (strcmp(Matrix_Format, "tpetra_block") == 0) ||
+      (strcmp(Matrix_Format, "epetra") == 0)) {
     for (pg->imtrx = 0; pg->imtrx < upd->Total_Num_Matrices; pg->imtrx++) {
       GomaSparseMatrix goma_matrix = ams[pg->imtrx]->GomaMatrixData;
       GomaSparseMatrix_Destroy(&goma_matrix);
@@ -200,9 +213,9 @@ int resetup_matrix(struct GomaLinearSolverData **ams, Exo_DB *exo, Dpi *dpi) {
                                        num_boundary_dofs[pg->imtrx], num_external_dofs[pg->imtrx],
                                        local_nodes, Nodes, MaxVarPerNode, Matilda, Inter_Mask, exo,
                                        dpi, cx[pg->imtrx], pg->imtrx, Debug_Flag, ams[JAC]);
+      ams[pg->imtrx]->solveSetup = 0;
     }
     pg->imtrx = 0;
-    ams[pg->imtrx]->solveSetup = 0;
   } else {
     GOMA_EH(-1, "Unsupported matrix storage format use epetra");
   }
@@ -16,10 +16,15 @@
 #include "dp_map_comm_vec.h"
 #include "dp_types.h"
 #include "dpi.h"
+#include "md_timer.h"
+#include "mm_eh.h"
 #include "rf_allo.h"
 #include "rf_fem.h"
+#include "rf_fem_const.h"
+#include "std.h"
 
 /* System Include files */
+#include <string.h>
 
 /* User include files */
 /*
@@ -45,61 +50,232 @@
 /********************************************************************/
 /********************************************************************/
 
-void exchange_dof(Comm_Ex *cx, Dpi *dpi, double *x, int imtrx)
+/*
+ * Persistent state of the split-phase dof exchange of one matrix.
+ *
+ * The persistent requests are bound to fixed send and receive buffers,
+ * so the ghost values are gathered out of x when the exchange begins
+ * and copied into x when it ends.
+ */
+#ifdef PARALLEL
+struct Dof_Exchange {
+  Comm_Ex *cx;           /* exchange pattern the requests were built for */
+  int num_neighbors;     /* number of neighbor processors */
+  int num_send;          /* total number of dofs sent */
+  int num_recv;          /* total number of dofs received */
+  double *send_buf;      /* packed send values, neighbor p at ptr_dof_send[imtrx][p] */
+  double *recv_buf;      /* received ghost values in external dof order */
+  MPI_Request *requests; /* receives for each neighbor, then sends */
+  double *x;             /* vector of the exchange in flight, NULL if none */
+};
+
+static struct Dof_Exchange *Dof_Exchange_State[MAX_NUM_MATRICES];
+
+/*
+ * Tags of the persistent exchange, one per matrix and out of the range
+ * cycled through by exchange_neighbor_proc_info()
+ */
+#define DOF_EXCHANGE_TAG 300
+
+static void dof_exchange_destroy(int imtrx) {
+  struct Dof_Exchange *dx = Dof_Exchange_State[imtrx];
+  int p;
+
+  if (dx == NULL) {
+    return;
+  }
+  exchange_dof_end(imtrx);
+  for (p = 0; p < 2 * dx->num_neighbors; p++) {
+    MPI_Request_free(&(dx->requests[p]));
+  }
+  safer_free((void **)&(dx->requests));
+  safer_free((void **)&(dx->send_buf));
+  safer_free((void **)&(dx->recv_buf));
+  safer_free((void **)&(Dof_Exchange_State[imtrx]));
+}
+
+/*
+ * Return the exchange state for cx, building the buffers and persistent
+ * requests the first time and again whenever the pattern changes
+ */
+static struct Dof_Exchange *dof_exchange_setup(Comm_Ex *cx, Dpi *dpi, int imtrx) {
+  struct Dof_Exchange *dx = Dof_Exchange_State[imtrx];
+  int p, num_recv = 0, retn;
+  int num_neighbors = dpi->num_neighbors;
+  int num_send = ptr_dof_send[imtrx][num_neighbors];
+  double *recv_ptr;
+
+  for (p = 0; p < num_neighbors; p++) {
+    num_recv += cx[p].num_dofs_recv;
+  }
+  if (dx != NULL && dx->cx == cx && dx->num_neighbors == num_neighbors &&
+      dx->num_send == num_send && dx->num_recv == num_recv) {
+    return dx;
+  }
+  dof_exchange_destroy(imtrx);
+
+  dx = alloc_struct_1(struct Dof_Exchange, 1);
+  dx->cx = cx;
+  dx->num_neighbors = num_neighbors;
+  dx->num_send = num_send;
+  dx->num_recv = num_recv;
+  dx->send_buf = alloc_dbl_1(MAX(num_send, 1), DBL_NOINIT);
+  dx->recv_buf = alloc_dbl_1(MAX(num_recv, 1), DBL_NOINIT);
+  dx->requests = (MPI_Request *)smalloc(2 * num_neighbors * sizeof(MPI_Request));
+  dx->x = NULL;
+
+  recv_ptr = dx->recv_buf;
+  for (p = 0; p < num_neighbors; p++) {
+    retn = MPI_Recv_init(recv_ptr, cx[p].num_dofs_recv, MPI_DOUBLE, cx[p].neighbor_name,
+                         DOF_EXCHANGE_TAG + imtrx, MPI_COMM_WORLD, &(dx->requests[p]));
+    GOMA_EH((retn == MPI_SUCCESS) ? GOMA_SUCCESS : GOMA_ERROR, "MPI_Recv_init failed");
+    recv_ptr += cx[p].num_dofs_recv;
+  }
+  for (p = 0; p < num_neighbors; p++) {
+    retn = MPI_Send_init(dx->send_buf + ptr_dof_send[imtrx][p], cx[p].num_dofs_send, MPI_DOUBLE,
+                         cx[p].neighbor_name, DOF_EXCHANGE_TAG + imtrx, MPI_COMM_WORLD,
+                         &(dx->requests[num_neighbors + p]));
+    GOMA_EH((retn == MPI_SUCCESS) ? GOMA_SUCCESS : GOMA_ERROR, "MPI_Send_init failed");
+  }
+
+  Dof_Exchange_State[imtrx] = dx;
+  return dx;
+}
+#endif /* PARALLEL */
+
+void exchange_dof_begin(Comm_Ex *cx, Dpi *dpi, double *x, int imtrx)
 
 /************************************************************
  *
- *  exchange_dof():
+ *  exchange_dof_begin():
  *
- *  send/recv appropriate pieces of a dof-based double array
+ *  Start sending the owned values of a dof-based double array
+ *  to the neighbors that hold them as ghosts. The ghost entries
+ *  of x are not valid until exchange_dof_end() is called, and
+ *  x must not be freed before then. Owned entries of x may be
+ *  read in between, but not written.
  ************************************************************/
 {
-  COMM_NP_STRUCT *np_base, *np_ptr;
-  double *ptr_send_list, *ptr_recv_list;
-  register double *ptrd;
-  register int *ptr_int, i;
-  int p;
-  int num_neighbors = dpi->num_neighbors;
-  int total_num_send_unknowns;
+#ifdef PARALLEL
+  struct Dof_Exchange *dx;
+  int i, retn;
+  int *ptr_int;
 
-  if (num_neighbors == 0)
+  if (dpi->num_neighbors == 0)
     return;
 
-#ifdef PARALLEL
-  total_num_send_unknowns = ptr_dof_send[imtrx][dpi->num_neighbors];
-  np_base = alloc_struct_1(COMM_NP_STRUCT, dpi->num_neighbors);
-  ptrd = (double *)alloc_dbl_1(total_num_send_unknowns, DBL_NOINIT);
-  ptr_send_list = ptrd;
+  dx = dof_exchange_setup(cx, dpi, imtrx);
+  if (dx->x != NULL) {
+    GOMA_EH(GOMA_ERROR, "exchange_dof_begin: previous exchange was not ended");
+  }
 
   /*
    * gather up the list of send unknowns
    */
   ptr_int = list_dof_send[imtrx];
-  for (i = total_num_send_unknowns; i > 0; i--) {
-    *ptrd++ = x[*ptr_int++];
+  for (i = 0; i < dx->num_send; i++) {
+    dx->send_buf[i] = x[ptr_int[i]];
   }
 
+  retn = MPI_Startall(2 * dx->num_neighbors, dx->requests);
+  GOMA_EH((retn == MPI_SUCCESS) ? GOMA_SUCCESS : GOMA_ERROR, "MPI_Startall failed");
+  dx->x = x;
+#endif /* PARALLEL */
+}
+/********************************************************************/
+
+void exchange_dof_end(int imtrx)
+
+/************************************************************
+ *
+ *  exchange_dof_end():
+ *
+ *  Wait for the exchange started by exchange_dof_begin() and
+ *  copy the received values into the ghost entries of its
+ *  vector. Does nothing if no exchange is in flight.
+ ************************************************************/
+{
+#ifdef PARALLEL
+  struct Dof_Exchange *dx = Dof_Exchange_State[imtrx];
+  int retn;
+
+  if (dx == NULL || dx->x == NULL)
+    return;
+
+  GOMA_PROF_BEGIN("exchange_dof_wait");
+  retn = MPI_Waitall(2 * dx->num_neighbors, dx->requests, MPI_STATUSES_IGNORE);
+  GOMA_EH((retn == MPI_SUCCESS) ? GOMA_SUCCESS : GOMA_ERROR, "MPI_Waitall failed");
+  GOMA_PROF_END("exchange_dof_wait");
+
   /*
-   * store base address for the start of the external degrees of freedom
-   * in this vector
+   * The external degrees of freedom are stored after the internal and
+   * boundary ones, in neighbor order
    */
-  ptr_recv_list = x + num_internal_dofs[imtrx] + num_boundary_dofs[imtrx];
+  memcpy(dx->x + num_internal_dofs[imtrx] + num_boundary_dofs[imtrx], dx->recv_buf,
+         dx->num_recv * sizeof(double));
+  dx->x = NULL;
+#endif /* PARALLEL */
+}
+/********************************************************************/
 
-  np_ptr = np_base;
-  for (p = 0; p < dpi->num_neighbors; p++) {
-    np_ptr->neighbor_ProcID = cx[p].neighbor_name;
-    np_ptr->send_message_buf = (void *)(ptr_send_list + ptr_dof_send[imtrx][p]);
-    np_ptr->send_message_length = sizeof(double) * cx[p].num_dofs_send;
-    np_ptr->recv_message_buf = (void *)ptr_recv_list;
-    np_ptr->recv_message_length = sizeof(double) * cx[p].num_dofs_recv;
-    ptr_recv_list += cx[p].num_dofs_recv;
-    np_ptr++;
+int exchange_dof_pending(int imtrx)
+
+/************************************************************
+ *
+ *  exchange_dof_pending():
+ *
+ *  TRUE if an exchange begun for matrix imtrx has not ended.
+ ************************************************************/
+{
+#ifdef PARALLEL
+  return (Dof_Exchange_State[imtrx] != NULL && Dof_Exchange_State[imtrx]->x != NULL);
+#else
+  return FALSE;
+#endif /* PARALLEL */
+}
+/********************************************************************/
+
+void exchange_dof_free(void)
+
+/************************************************************
+ *
+ *  exchange_dof_free():
+ *
+ *  Release the persistent requests and buffers of the dof
+ *  exchanges, e.g. before the communication pattern is
+ *  rebuilt after a remesh.
+ ************************************************************/
+{
+#ifdef PARALLEL
+  int imtrx;
+
+  for (imtrx = 0; imtrx < MAX_NUM_MATRICES; imtrx++) {
+    dof_exchange_destroy(imtrx);
   }
-  exchange_neighbor_proc_info(dpi->num_neighbors, np_base);
-  safer_free((void **)&np_base);
-  safer_free((void **)&ptr_send_list);
 #endif /* PARALLEL */
 }
+/********************************************************************/
+
+void exchange_dof(Comm_Ex *cx, Dpi *dpi, double *x, int imtrx)
+
+/************************************************************
+ *
+ *  exchange_dof():
+ *
+ *  send/recv appropriate pieces of a dof-based double array
+ ************************************************************/
+{
+  if (dpi->num_neighbors == 0)
+    return;
+
+  GOMA_PROF_BEGIN("exchange_dof");
+  exchange_dof_begin(cx, dpi, x, imtrx);
+  exchange_dof_end(imtrx);
+  GOMA_PROF_END("exchange_dof");
+}
+/********************************************************************/
+/********************************************************************/
+/********************************************************************/
 
 void exchange_dof_int(Comm_Ex *cx, Dpi *dpi, int *x, int imtrx)
 
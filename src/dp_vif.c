@@ -44,6 +44,7 @@
 #include "dp_utils.h"
 #include "dp_vif.h"
 #include "el_elm.h"
+#include "md_timer.h"
 #include "mm_as.h"
 #include "mm_as_const.h"
 #include "mm_as_structs.h"
@@ -112,6 +113,7 @@ void noahs_raven(void) {
   ddd_add_member(n, &Decompose_Flag, 1, MPI_INT);
   ddd_add_member(n, &Decompose_Type, 1, MPI_INT);
   ddd_add_member(n, &Skip_Fix, 1, MPI_INT);
+  ddd_add_member(n, &Goma_Profile, 1, MPI_INT);
 
   ddd_add_member(n, &Num_Var_Init, 1, MPI_INT);
   ddd_add_member(n, &Num_Var_Bound, 1, MPI_INT);
@@ -1023,6 +1025,19 @@ void noahs_ark(void) {
   ddd_add_member(n, &upd->strong_bc_replace, 1, MPI_INT);
   ddd_add_member(n, &upd->strong_penalty, 1, MPI_DOUBLE);
   ddd_add_member(n, &upd->Residual_Relative_Tol, MAX_NUM_MATRICES, MPI_DOUBLE);
+  ddd_add_member(n, &upd->Geometry_Cache, 1, MPI_INT);
+  ddd_add_member(n, &upd->Geometry_Cache_Max_MB, 1, MPI_INT);
+  ddd_add_member(n, &upd->Overlap_Dof_Exchange, 1, MPI_INT);
+  ddd_add_member(n, &upd->Precond_Reuse, 1, MPI_INT);
+  ddd_add_member(n, &upd->Precond_Reuse_Steps, 1, MPI_INT);
+  ddd_add_member(n, &upd->Precond_Reuse_Growth, 1, MPI_DOUBLE);
+  ddd_add_member(n, &upd->Newton_Forcing, 1, MPI_INT);
+  ddd_add_member(n, &upd->Newton_Forcing_Max, 1, MPI_DOUBLE);
+  ddd_add_member(n, &upd->Matrix_Free, 1, MPI_INT);
+  ddd_add_member(n, &upd->Matrix_Free_Lag, 1, MPI_INT);
+  ddd_add_member(n, &upd->Matrix_Equilibration, 1, MPI_INT);
+  ddd_add_member(n, upd->Linear_Solve_Precision, MAX_NUM_MATRICES, MPI_INT);
+  ddd_add_member(n, upd->Refinement_Max_Steps, MAX_NUM_MATRICES, MPI_INT);
 
   ddd_add_member(n, pg->time_step_control_disabled, MAX_NUM_MATRICES, MPI_INT);
   ddd_add_member(n, pg->matrix_subcycle_count, MAX_NUM_MATRICES, MPI_INT);
@@ -1339,6 +1354,7 @@ void noahs_ark(void) {
     ddd_add_member(n, &ls->adapt_width, 1, MPI_DOUBLE);
     ddd_add_member(n, &ls->Control_Width, 1, MPI_DOUBLE);
     ddd_add_member(n, &ls->Renorm_Tolerance, 1, MPI_DOUBLE);
+    ddd_add_member(n, &ls->Renorm_Band, 1, MPI_DOUBLE);
     ddd_add_member(n, &ls->Renorm_Method, 1, MPI_INT);
     ddd_add_member(n, &ls->Search_Option, 1, MPI_INT);
     ddd_add_member(n, &ls->Grid_Search_Depth, 1, MPI_INT);
@@ -1391,6 +1407,7 @@ void noahs_ark(void) {
       ddd_add_member(n, &pfd->ls[i]->Length_Scale, 1, MPI_DOUBLE);
       ddd_add_member(n, &pfd->ls[i]->Control_Width, 1, MPI_DOUBLE);
       ddd_add_member(n, &pfd->ls[i]->Renorm_Tolerance, 1, MPI_DOUBLE);
+      ddd_add_member(n, &pfd->ls[i]->Renorm_Band, 1, MPI_DOUBLE);
       ddd_add_member(n, &pfd->ls[i]->Renorm_Method, 1, MPI_INT);
       ddd_add_member(n, &pfd->ls[i]->Search_Option, 1, MPI_INT);
       ddd_add_member(n, &pfd->ls[i]->Grid_Search_Depth, 1, MPI_INT);
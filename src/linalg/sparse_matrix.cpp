@@ -1,9 +1,12 @@
+#include <algorithm>
 #include <cstdlib>
+#include <cstring>
 #include <vector>
 
 #include "linalg/sparse_matrix.h"
 #ifdef GOMA_ENABLE_TPETRA
 #include "linalg/sparse_matrix_tpetra.h"
+#include "linalg/sparse_matrix_tpetra_block.h"
 #endif
 #ifdef GOMA_ENABLE_EPETRA
 #include "linalg/sparse_matrix_epetra.h"
@@ -16,11 +19,13 @@ extern "C" {
 #include "mm_as.h"
 #include "mm_as_const.h"
 #include "mm_eh.h"
+#include "mm_fill_scatter.h"
 #include "mm_fill_util.h"
 #include "mm_mp.h"
 #include "mm_unknown_map.h"
 #include "rf_masks.h"
 #include "rf_node_const.h"
+#include "rf_solver_const.h"
 #include "sl_util_structs.h"
 #undef DISABLE_CPP
 }
@@ -29,6 +34,8 @@ extern "C" goma_error GomaSparseMatrix_CreateFromFormat(GomaSparseMatrix *matrix
                                                         char *matrix_format) {
   if (strcmp(matrix_format, "tpetra") == 0) {
     return GomaSparseMatrix_Create(matrix, GOMA_SPARSE_MATRIX_TYPE_TPETRA);
+  } else if (strcmp(matrix_format, "tpetra_block") == 0) {
+    return GomaSparseMatrix_Create(matrix, GOMA_SPARSE_MATRIX_TYPE_TPETRA_BLOCK);
   } else if (strcmp(matrix_format, "epetra") == 0) {
     return GomaSparseMatrix_Create(matrix, GOMA_SPARSE_MATRIX_TYPE_EPETRA);
   }
@@ -37,16 +44,25 @@ extern "C" goma_error GomaSparseMatrix_CreateFromFormat(GomaSparseMatrix *matrix
 
 extern "C" goma_error GomaSparseMatrix_Create(GomaSparseMatrix *matrix,
                                               enum GomaSparseMatrixType type) {
+  goma_error err;
   *matrix = (GomaSparseMatrix)malloc(sizeof(struct g_GomaSparseMatrix));
+  (*matrix)->block_size = 0;
+  (*matrix)->equilibration = upd->Matrix_Equilibration;
+  (*matrix)->sum_into_block_row_values = NULL;
+  (*matrix)->unscale_solution = NULL;
+  (*matrix)->zero_local_rows = NULL;
   switch (type) {
 #ifdef GOMA_ENABLE_TPETRA
   case GOMA_SPARSE_MATRIX_TYPE_TPETRA:
-    return GomaSparseMatrix_Tpetra_Create(matrix);
+    err = GomaSparseMatrix_Tpetra_Create(matrix);
+    break;
+  case GOMA_SPARSE_MATRIX_TYPE_TPETRA_BLOCK:
+    err = GomaSparseMatrix_TpetraBlock_Create(matrix);
     break;
 #endif
 #ifdef GOMA_ENABLE_EPETRA
   case GOMA_SPARSE_MATRIX_TYPE_EPETRA:
-    return GomaSparseMatrix_Epetra_Create(matrix);
+    err = GomaSparseMatrix_Epetra_Create(matrix);
     break;
 #endif
   default:
@@ -54,7 +70,11 @@ extern "C" goma_error GomaSparseMatrix_Create(GomaSparseMatrix *matrix,
     return GOMA_ERROR;
     break;
   }
-  return GOMA_SUCCESS;
+  if ((*matrix)->equilibration != EQUILIBRATE_ROW && (*matrix)->unscale_solution == NULL) {
+    GOMA_EH(GOMA_ERROR, "Matrix Equilibration other than row is only available for tpetra");
+    return GOMA_ERROR;
+  }
+  return err;
 }
 
 extern "C" goma_error GomaSparseMatrix_SetProblemGraph(
@@ -80,9 +100,8 @@ extern "C" goma_error GomaSparseMatrix_SetProblemGraph(
   int add_var = 0;
   NODE_INFO_STRUCT *nodeCol;
   NODAL_VARS_STRUCT *nv, *nvCol;
-  int inode_varType[MaxVarPerNode], inode_matID[MaxVarPerNode];
-  int inter_node_varType[MaxVarPerNode], inter_node_matID[MaxVarPerNode];
-  int nnz = 0;
+  std::vector<int> inode_varType(MaxVarPerNode), inode_matID(MaxVarPerNode);
+  std::vector<int> inter_node_varType(MaxVarPerNode), inter_node_matID(MaxVarPerNode);
 
   GomaGlobalOrdinal NumMyRows = num_internal_dofs + num_boundary_dofs;
   GomaGlobalOrdinal NumExternal = num_external_dofs;
@@ -111,24 +130,36 @@ extern "C" goma_error GomaSparseMatrix_SetProblemGraph(
     matrix->global_ids[i] = GlobalIDs[i];
   }
 
+  /*
+   * Node blocked formats need the same number of unknowns at every node
+   */
+  int block_size = local_nodes > 0 ? Nodes[0]->Nodal_Vars_Info[imtrx]->Num_Unknowns : 0;
+  for (inode = 1; inode < local_nodes; inode++) {
+    if (Nodes[inode]->Nodal_Vars_Info[imtrx]->Num_Unknowns != block_size) {
+      block_size = 0;
+      break;
+    }
+  }
+  int min_block_size, max_block_size;
+  MPI_Allreduce(&block_size, &min_block_size, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+  MPI_Allreduce(&block_size, &max_block_size, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+  matrix->block_size = (min_block_size == max_block_size) ? block_size : 0;
+
   std::vector<GomaGlobalOrdinal> rows(GlobalIDs.begin(), GlobalIDs.begin() + NumMyRows);
   std::vector<GomaGlobalOrdinal> cols(GlobalIDs.begin(), GlobalIDs.end());
-  std::vector<GomaGlobalOrdinal> coo_rows;
-  std::vector<GomaGlobalOrdinal> coo_cols;
-
-  int max_nz_per_row = 0;
-  int row_nz;
 
   /*
-   * loop over all of the nodes on this processor
+   * Visit the columns with an interaction in the rows of the unknowns of
+   * node inode, calling add_entry(row, local column) for each. The rows
+   * are numbered in local dof order.
    */
-  for (inode = 0; inode < local_nodes; inode++) {
+  auto visit_node_rows = [&](int inode, auto &&add_entry) {
     nv = Nodes[inode]->Nodal_Vars_Info[pg->imtrx];
     /*
      * Fill the vector list which points to the unknowns defined at this
      * node...
      */
-    row_num_unknowns = fill_variable_vector(inode, inode_varType, inode_matID);
+    row_num_unknowns = fill_variable_vector(inode, inode_varType.data(), inode_matID.data());
     /*
      * Do a check against the number of unknowns at this
      * node stored in the global array
@@ -141,7 +172,6 @@ extern "C" goma_error GomaSparseMatrix_SetProblemGraph(
      * Loop over the unknowns defined at this row node
      */
     for (iunknown = 0; iunknown < row_num_unknowns; iunknown++) {
-      row_nz = 0;
       /*
        * Retrieve the var type of the current unknown
        */
@@ -160,7 +190,8 @@ extern "C" goma_error GomaSparseMatrix_SetProblemGraph(
          * fill the vector list which points to the unknowns
          * defined at this interaction node
          */
-        col_num_unknowns = fill_variable_vector(inter_node, inter_node_varType, inter_node_matID);
+        col_num_unknowns =
+            fill_variable_vector(inter_node, inter_node_varType.data(), inter_node_matID.data());
         if (col_num_unknowns != nvCol->Num_Unknowns) {
           GOMA_EH(GOMA_ERROR, "Inconsistency counting unknowns.");
         }
@@ -219,22 +250,47 @@ extern "C" goma_error GomaSparseMatrix_SetProblemGraph(
              * Determine the equation number of the current unknown
              */
             icol_index = nodeCol->First_Unknown[pg->imtrx] + inter_unknown;
-            coo_rows.push_back(GlobalIDs[irow_index]);
-            coo_cols.push_back(GlobalIDs[icol_index]);
-            nnz++;
-            row_nz++;
+            add_entry(irow_index, icol_index);
           }
         }
       }
-      if (row_nz > max_nz_per_row) {
-        max_nz_per_row = row_nz;
-      }
       irow_index++;
     }
+  };
+
+  /*
+   * The graph is built as local CSR in two passes over the nodes on this
+   * processor, first counting the entries of every row, then filling in
+   * the local column indices
+   */
+  std::vector<GomaGlobalOrdinal> row_ptr(NumMyRows + 1, 0);
+  irow_index = 0;
+  for (inode = 0; inode < local_nodes; inode++) {
+    visit_node_rows(inode, [&](int row, int) { row_ptr[row + 1]++; });
+  }
+  if (irow_index != NumMyRows) {
+    GOMA_EH(GOMA_ERROR, "Inconsistency counting rows, GomaSparseMatrix_SetProblemGraph");
+  }
+
+  int max_nz_per_row = 0;
+  for (GomaGlobalOrdinal i = 0; i < NumMyRows; i++) {
+    max_nz_per_row = std::max(max_nz_per_row, static_cast<int>(row_ptr[i + 1]));
+    row_ptr[i + 1] += row_ptr[i];
+  }
+  GomaGlobalOrdinal nnz = row_ptr[NumMyRows];
+
+  std::vector<int> local_cols(nnz);
+  std::vector<GomaGlobalOrdinal> row_fill(row_ptr.begin(), row_ptr.end() - 1);
+  irow_index = 0;
+  for (inode = 0; inode < local_nodes; inode++) {
+    visit_node_rows(inode, [&](int row, int col) { local_cols[row_fill[row]++] = col; });
+  }
+  for (GomaGlobalOrdinal i = 0; i < NumMyRows; i++) {
+    std::sort(local_cols.begin() + row_ptr[i], local_cols.begin() + row_ptr[i + 1]);
   }
 
   matrix->create_graph(matrix, NumMyRows, rows.data(), NumMyCols, cols.data(), nnz, max_nz_per_row,
-                       coo_rows.data(), coo_cols.data());
+                       row_ptr.data(), local_cols.data());
 
   if (matrix->complete_graph != NULL) {
     //  matrix->complete_graph(matrix);
@@ -267,192 +323,114 @@ extern "C" goma_error GomaSparseMatrix_SetProblemGraph(
   return GOMA_SUCCESS;
 }
 
+/*
+ * Node blocked load, the element contributions are gathered into dense
+ * block_size x block_size tiles, one per (row node, column node) pair of the
+ * element, and each row node is summed into the matrix with a single call
+ */
+static goma_error load_lec_blocked(GomaSparseMatrix matrix,
+                                   const struct Lec_Scatter *scatter,
+                                   struct Local_Element_Contributions *lec,
+                                   double resid_vector[]) {
+  static std::vector<int> block_rows, block_cols, col_block;
+  static std::vector<double> tiles;
+  const int bs = matrix->block_size;
+  const int bs2 = bs * bs;
+
+  block_rows.clear();
+  block_cols.clear();
+  for (int r = 0; r < scatter->nrows; r++) {
+    int node = scatter->rows[LEC_SCATTER_ROW_SIZE * r + LEC_SCATTER_ROW_INDEX] / bs;
+    if (std::find(block_rows.begin(), block_rows.end(), node) == block_rows.end()) {
+      block_rows.push_back(node);
+    }
+  }
+  col_block.resize(scatter->ncols);
+  for (int j = 0; j < scatter->ncols; j++) {
+    int node = scatter->cols[j] / bs;
+    auto it = std::find(block_cols.begin(), block_cols.end(), node);
+    col_block[j] = it - block_cols.begin();
+    if (it == block_cols.end()) {
+      block_cols.push_back(node);
+    }
+  }
+  const int nbc = block_cols.size();
+  tiles.assign(block_rows.size() * nbc * bs2, 0.0);
+
+  for (int r = 0; r < scatter->nrows; r++) {
+    const int *row = scatter->rows + LEC_SCATTER_ROW_SIZE * r;
+    int row_index = row[LEC_SCATTER_ROW_INDEX];
+    int pe = row[LEC_SCATTER_ROW_PE];
+    int i = row[LEC_SCATTER_ROW_DOF];
+    int e = row[LEC_SCATTER_ROW_EQN];
+
+    resid_vector[row_index] += lec->R[LEC_R_INDEX(pe, i)];
+
+    if (af->Assemble_Jacobian) {
+      int br = std::find(block_rows.begin(), block_rows.end(), row_index / bs) - block_rows.begin();
+      double *tile_row = tiles.data() + br * nbc * bs2 + (row_index % bs) * bs;
+      for (int blk = 0; blk < scatter->nblocks; blk++) {
+        const int *block = scatter->blocks + LEC_SCATTER_BLK_SIZE * blk;
+        if (!Inter_Mask[pg->imtrx][e][block[LEC_SCATTER_BLK_VAR]])
+          continue;
+        int pv = block[LEC_SCATTER_BLK_PV];
+        int start = block[LEC_SCATTER_BLK_START];
+        for (int j = 0; j < block[LEC_SCATTER_BLK_NCOL]; j++) {
+          tile_row[col_block[start + j] * bs2 + scatter->cols[start + j] % bs] +=
+              lec->J[LEC_J_INDEX(pe, pv, i, j)];
+        }
+      }
+    }
+  }
+
+  if (af->Assemble_Jacobian) {
+    for (size_t br = 0; br < block_rows.size(); br++) {
+      matrix->sum_into_block_row_values(matrix, block_rows[br], nbc, tiles.data() + br * nbc * bs2,
+                                        block_cols.data());
+    }
+  }
+  return GOMA_SUCCESS;
+}
+
 extern "C" goma_error GomaSparseMatrix_LoadLec(GomaSparseMatrix matrix,
                                                int ielem,
                                                struct Local_Element_Contributions *lec,
                                                double resid_vector[]) {
-  int e, v, i, j, pe, pv;
-  int dofs;
-  int gnn, row_index, ke, kv, nvdof;
-  int col_index, ledof;
-  int je_new;
-  struct Element_Indices *ei_ptr;
-  std::vector<GomaGlobalOrdinal> Indices;
-  std::vector<double> Values;
-
-  for (e = V_FIRST; e < V_LAST; e++) {
-    pe = upd->ep[pg->imtrx][e];
-    if (pe != -1) {
-      if (e == R_MASS) {
-        for (ke = 0; ke < upd->Max_Num_Species_Eqn; ke++) {
-          pe = MAX_PROB_VAR + ke;
-          dofs = ei[pg->imtrx]->dof[e];
-          for (i = 0; i < dofs; i++) {
-            /*
-             * Check to see whether this dof is on a
-             * node owned by this processor. If it isn't
-             * there is no need to fill in the processor
-             * residual and Jacobian row for this variable.
-             */
-            ledof = ei[pg->imtrx]->lvdof_to_ledof[e][i];
-            if (ei[pg->imtrx]->owned_ledof[ledof]) {
-              gnn = ei[pg->imtrx]->gnn_list[e][i];
-              nvdof = ei[pg->imtrx]->Baby_Dolphin[e][i];
-              je_new = ei[pg->imtrx]->ieqn_ledof[ledof] + ke;
-              row_index =
-                  Index_Solution(gnn, e, ke, nvdof, ei[pg->imtrx]->matID_ledof[ledof], pg->imtrx);
-              resid_vector[row_index] += lec->R[LEC_R_INDEX(MAX_PROB_VAR + ke, i)];
-
-              if (af->Assemble_Jacobian) {
-                for (v = V_FIRST; v < V_LAST; v++) {
-                  pv = upd->vp[pg->imtrx][v];
-                  if (pv != -1 && (Inter_Mask[pg->imtrx][e][v])) {
-                    ei_ptr = ei[pg->imtrx];
-                    if (ei[pg->imtrx]->owningElementForColVar[v] != ielem) {
-                      if (ei[pg->imtrx]->owningElementForColVar[v] != -1) {
-                        ei_ptr = ei[pg->imtrx]->owningElement_ei_ptr[v];
-                        if (ei_ptr == 0) {
-                          printf("ei_ptr == 0\n");
-                          exit(-1);
-                        }
-                      }
-                    }
-                    if (v == MASS_FRACTION) {
-                      for (kv = 0; kv < upd->Max_Num_Species_Eqn; kv++) {
-                        pv = MAX_PROB_VAR + kv;
-                        for (j = 0; j < ei_ptr->dof[v]; j++) {
-                          ledof = ei_ptr->lvdof_to_ledof[v][j];
-                          je_new = ei_ptr->ieqn_ledof[ledof] + kv;
-                          col_index = Index_Solution(ei_ptr->gnn_list[v][j], v, kv,
-                                                     ei_ptr->Baby_Dolphin[v][j],
-                                                     ei_ptr->matID_ledof[ledof], pg->imtrx);
-                          GOMA_EH(col_index, "Bad var index.");
-                          Indices.push_back(matrix->global_ids[col_index]);
-                          Values.push_back(lec->J[LEC_J_INDEX(pe, pv, i, j)]);
-                        }
-                      }
-                    } else {
-                      pv = upd->vp[pg->imtrx][v];
-                      kv = 0;
-                      for (j = 0; j < ei_ptr->dof[v]; j++) {
-                        ledof = ei_ptr->lvdof_to_ledof[v][j];
-                        je_new = ei_ptr->ieqn_ledof[ledof];
-                        col_index = Index_Solution(ei_ptr->gnn_list[v][j], v, kv,
-                                                   ei_ptr->Baby_Dolphin[v][j],
-                                                   ei_ptr->matID_ledof[ledof], pg->imtrx);
-                        if (col_index != je_new) {
-                          fprintf(stderr, "Oh fiddlesticks: je = %d, je_new = %d\n", col_index,
-                                  je_new);
-                          GOMA_EH(GOMA_ERROR, "LEC Indexing error");
-                        }
-                        GOMA_EH(col_index, "Bad var index.");
-                        Indices.push_back(matrix->global_ids[col_index]);
-                        Values.push_back(lec->J[LEC_J_INDEX(pe, pv, i, j)]);
-                      }
-                    }
-                  }
-                }
-                matrix->sum_into_row_values(matrix, matrix->global_ids[row_index], Indices.size(),
-                                            &Values[0], &Indices[0]);
-                Indices.clear();
-                Values.clear();
-              }
-            }
-          }
-        }
-      } else {
-        pe = upd->ep[pg->imtrx][e];
-        dofs = ei[pg->imtrx]->dof[e];
-        for (i = 0; i < dofs; i++) {
-          /*
-           * Check to see whether this dof is on a
-           * node owned by this processor. If it isn't
-           * there is no need to fill in the processor
-           * residual and Jacobian row for this variable.
-           */
-          ledof = ei[pg->imtrx]->lvdof_to_ledof[e][i];
-          if (ei[pg->imtrx]->owned_ledof[ledof]) {
-            row_index = ei[pg->imtrx]->gun_list[e][i];
-            resid_vector[row_index] += lec->R[LEC_R_INDEX(pe, i)];
-
-            if (af->Assemble_Jacobian) {
-              for (v = V_FIRST; v < V_LAST; v++) {
-                pv = upd->vp[pg->imtrx][v];
-                if (pv != -1 && (Inter_Mask[pg->imtrx][e][v])) {
-                  if (v == MASS_FRACTION) {
-
-                    ei_ptr = ei[pg->imtrx];
-                    if (ei[pg->imtrx]->owningElementForColVar[v] != ielem) {
-                      if (ei[pg->imtrx]->owningElementForColVar[v] != -1) {
-                        ei_ptr = ei[pg->imtrx]->owningElement_ei_ptr[v];
-                        if (ei_ptr == 0) {
-                          GOMA_EH(GOMA_ERROR, "ei_ptr == 0\n");
-                          exit(-1);
-                        }
-                      }
-                    }
-                    for (kv = 0; kv < upd->Max_Num_Species_Eqn; kv++) {
-                      pv = MAX_PROB_VAR + kv;
-                      for (j = 0; j < ei_ptr->dof[v]; j++) {
-                        ledof = ei_ptr->lvdof_to_ledof[v][j];
-                        je_new = ei_ptr->ieqn_ledof[ledof] + kv;
-                        col_index = Index_Solution(ei_ptr->gnn_list[v][j], v, kv,
-                                                   ei_ptr->Baby_Dolphin[v][j],
-                                                   ei_ptr->matID_ledof[ledof], pg->imtrx);
-                        if (col_index != je_new) {
-                          /*
-                           * HKM -> another special case. Until we delineate
-                           *        the subspecies as individual local
-                           *        dofs, je_new will be wrong here. je
-                           *        is correct.
-                           */
-                          if (Nodes[ei[pg->imtrx]->gnn_list[v][j]]->Mat_List.Length < 2) {
-                          }
-                        }
-                        GOMA_EH(col_index, "Bad var index.");
-                        Indices.push_back(matrix->global_ids[col_index]);
-                        Values.push_back(lec->J[LEC_J_INDEX(pe, pv, i, j)]);
-                      }
-                    }
-                  } else {
-                    kv = 0;
-                    // NEW IMPLEMENTATION
-                    ei_ptr = ei[pg->imtrx];
-                    if (ei[pg->imtrx]->owningElementForColVar[v] != ielem) {
-                      if (ei[pg->imtrx]->owningElementForColVar[v] != -1) {
-                        ei_ptr = ei[pg->imtrx]->owningElement_ei_ptr[v];
-                        if (ei_ptr == 0) {
-                          GOMA_EH(GOMA_ERROR, "ei slave pointer is null");
-                          exit(-1);
-                        }
-                      }
-                    }
-                    for (j = 0; j < ei_ptr->dof[v]; j++) {
-                      ledof = ei_ptr->lvdof_to_ledof[v][j];
-                      je_new = ei_ptr->ieqn_ledof[ledof];
-                      col_index =
-                          Index_Solution(ei_ptr->gnn_list[v][j], v, kv, ei_ptr->Baby_Dolphin[v][j],
-                                         ei_ptr->matID_ledof[ledof], pg->imtrx);
-                      if (col_index != je_new) {
-                        fprintf(stderr, "Oh fiddlesticks: je = %d, je_new = %d\n", col_index,
-                                je_new);
-                        GOMA_EH(GOMA_ERROR, "LEC Indexing error");
-                      }
-                      GOMA_EH(col_index, "Bad var index.");
-                      Indices.push_back(matrix->global_ids[col_index]);
-                      Values.push_back(lec->J[LEC_J_INDEX(pe, pv, i, j)]);
-                    }
-                  }
-                }
-              }
-              matrix->sum_into_row_values(matrix, matrix->global_ids[row_index], Indices.size(),
-                                          &Values[0], &Indices[0]);
-              Indices.clear();
-              Values.clear();
-            }
-          }
+  // Row and column lookups are done once per element and kept in the scatter map,
+  // the buffers keep their capacity between calls
+  static std::vector<GomaGlobalOrdinal> Indices;
+  static std::vector<double> Values;
+  const struct Lec_Scatter *scatter = lec_scatter_get(ielem, pg->imtrx);
+
+  if (matrix->sum_into_block_row_values != NULL) {
+    return load_lec_blocked(matrix, scatter, lec, resid_vector);
+  }
+
+  for (int r = 0; r < scatter->nrows; r++) {
+    const int *row = scatter->rows + LEC_SCATTER_ROW_SIZE * r;
+    int row_index = row[LEC_SCATTER_ROW_INDEX];
+    int pe = row[LEC_SCATTER_ROW_PE];
+    int i = row[LEC_SCATTER_ROW_DOF];
+    int e = row[LEC_SCATTER_ROW_EQN];
+
+    resid_vector[row_index] += lec->R[LEC_R_INDEX(pe, i)];
+
+    if (af->Assemble_Jacobian) {
+      Indices.clear();
+      Values.clear();
+      for (int blk = 0; blk < scatter->nblocks; blk++) {
+        const int *block = scatter->blocks + LEC_SCATTER_BLK_SIZE * blk;
+        if (!Inter_Mask[pg->imtrx][e][block[LEC_SCATTER_BLK_VAR]])
+          continue;
+        int pv = block[LEC_SCATTER_BLK_PV];
+        const int *cols = scatter->cols + block[LEC_SCATTER_BLK_START];
+        for (int j = 0; j < block[LEC_SCATTER_BLK_NCOL]; j++) {
+          Indices.push_back(matrix->global_ids[cols[j]]);
+          Values.push_back(lec->J[LEC_J_INDEX(pe, pv, i, j)]);
         }
       }
+      matrix->sum_into_row_values(matrix, matrix->global_ids[row_index], Indices.size(),
+                                  Values.data(), Indices.data());
     }
   }
   return GOMA_SUCCESS;
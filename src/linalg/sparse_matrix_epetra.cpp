@@ -50,8 +50,8 @@ extern "C" goma_error g_epetra_create_graph(GomaSparseMatrix matrix,
                                             GomaGlobalOrdinal *col_list,
                                             GomaGlobalOrdinal local_nnz,
                                             GomaGlobalOrdinal max_per_row,
-                                            GomaGlobalOrdinal *coo_rows,
-                                            GomaGlobalOrdinal *coo_cols) {
+                                            GomaGlobalOrdinal *row_ptr,
+                                            int *local_cols) {
   auto *tmp = static_cast<EpetraSparseMatrix *>(matrix->data);
 #ifdef EPETRA_MPI
   Epetra_MpiComm comm(MPI_COMM_WORLD);
@@ -59,27 +59,22 @@ extern "C" goma_error g_epetra_create_graph(GomaSparseMatrix matrix,
   Epetra_SerialComm comm;
 #endif
   GomaGlobalOrdinal global_n_rows;
-  GomaGlobalOrdinal global_n_cols;
   MPI_Allreduce(&n_rows, &global_n_rows, 1, MPI_GOMA_ORDINAL, MPI_SUM, MPI_COMM_WORLD);
-  MPI_Allreduce(&n_cols, &global_n_cols, 1, MPI_GOMA_ORDINAL, MPI_SUM, MPI_COMM_WORLD);
 
   tmp->row_map = Teuchos::rcp(new Epetra_Map(global_n_rows, n_rows, row_list, 0, comm));
-  tmp->crs_graph = Teuchos::rcp(new Epetra_CrsGraph(Copy, *(tmp->row_map), max_per_row));
-
-  GomaGlobalOrdinal current_row = row_list[0];
-  std::vector<GomaGlobalOrdinal> indices(max_per_row);
-  std::vector<double> values(max_per_row);
-  GomaGlobalOrdinal row_count = 0;
-  for (GomaGlobalOrdinal i = 0; i < local_nnz; i++) {
-    if (coo_rows[i] != current_row) {
-      tmp->crs_graph->InsertGlobalIndices(current_row, row_count, indices.data());
-      current_row = coo_rows[i];
-      row_count = 0;
-    }
-    indices[row_count] = coo_cols[i];
-    row_count++;
+  tmp->col_map = Teuchos::rcp(new Epetra_Map(-1, n_cols, col_list, 0, comm));
+
+  std::vector<int> num_entries(n_rows);
+  for (GomaGlobalOrdinal i = 0; i < n_rows; i++) {
+    num_entries[i] = static_cast<int>(row_ptr[i + 1] - row_ptr[i]);
+  }
+  tmp->crs_graph = Teuchos::rcp(
+      new Epetra_CrsGraph(Copy, *(tmp->row_map), *(tmp->col_map), num_entries.data(), true));
+
+  // columns are already local indices into col_list, no global lookups needed
+  for (GomaGlobalOrdinal i = 0; i < n_rows; i++) {
+    tmp->crs_graph->InsertMyIndices(i, num_entries[i], local_cols + row_ptr[i]);
   }
-  tmp->crs_graph->InsertGlobalIndices(current_row, row_count, indices.data());
 
   tmp->crs_graph->FillComplete();
 
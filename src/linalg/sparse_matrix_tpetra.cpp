@@ -1,6 +1,7 @@
 #ifdef GOMA_ENABLE_TPETRA
 #include "Tpetra_computeRowAndColumnOneNorms.hpp"
 #include "std.h"
+#include <Kokkos_DualView.hpp>
 #include <Teuchos_ArrayViewDecl.hpp>
 #include <Teuchos_DefaultMpiComm.hpp>
 #include <Teuchos_RCPDecl.hpp>
@@ -19,6 +20,9 @@ extern "C" {
 }
 #include "linalg/sparse_matrix.h"
 #include "linalg/sparse_matrix_tpetra.h"
+extern "C" {
+#include "rf_solver_const.h"
+}
 
 using Teuchos::RCP;
 
@@ -34,6 +38,8 @@ extern "C" goma_error GomaSparseMatrix_Tpetra_Create(GomaSparseMatrix *matrix) {
   (*matrix)->row_sum_scaling = g_tpetra_row_sum_scaling;
   (*matrix)->zero_global_row = g_tpetra_zero_row;
   (*matrix)->zero_global_row_set_diag = g_tpetra_zero_row_set_diag;
+  (*matrix)->zero_local_rows = g_tpetra_zero_local_rows;
+  (*matrix)->unscale_solution = g_tpetra_unscale_solution;
   (*matrix)->destroy = g_tpetra_destroy;
   return GOMA_SUCCESS;
 }
@@ -45,40 +51,38 @@ extern "C" goma_error g_tpetra_create_graph(GomaSparseMatrix matrix,
                                             GomaGlobalOrdinal *col_list,
                                             GomaGlobalOrdinal local_nnz,
                                             GomaGlobalOrdinal max_per_row,
-                                            GomaGlobalOrdinal *coo_rows,
-                                            GomaGlobalOrdinal *coo_cols) {
+                                            GomaGlobalOrdinal *row_ptr,
+                                            int *local_cols) {
   auto *tmp = static_cast<TpetraSparseMatrix *>(matrix->data);
   RCP<const Teuchos::MpiComm<int>> comm(new Teuchos::MpiComm<int>(MPI_COMM_WORLD));
   GomaGlobalOrdinal global_n_rows;
-  GomaGlobalOrdinal global_n_cols;
   MPI_Allreduce(&n_rows, &global_n_rows, 1, MPI_GOMA_ORDINAL, MPI_SUM, MPI_COMM_WORLD);
-  MPI_Allreduce(&n_cols, &global_n_cols, 1, MPI_GOMA_ORDINAL, MPI_SUM, MPI_COMM_WORLD);
 
   Teuchos::ArrayView<GomaGlobalOrdinal> row_list_view(row_list, n_rows);
   Teuchos::ArrayView<GomaGlobalOrdinal> col_list_view(col_list, n_cols);
 
   tmp->row_map = Teuchos::rcp(new Tpetra::Map<LO, GO>(global_n_rows, row_list_view, 0, comm));
-  tmp->col_map = Teuchos::rcp(new Tpetra::Map<LO, GO>(global_n_rows, row_list_view, 0, comm));
-  tmp->crs_graph =
-      Teuchos::rcp(new Tpetra::FECrsGraph<LO, GO>(tmp->row_map, tmp->col_map, max_per_row));
-
-  GomaGlobalOrdinal current_row = row_list[0];
-  std::vector<GomaGlobalOrdinal> indices(max_per_row);
-  std::vector<double> values(max_per_row);
-  GomaGlobalOrdinal row_count = 0;
-  for (GomaGlobalOrdinal i = 0; i < local_nnz; i++) {
-    if (coo_rows[i] != current_row) {
-      tmp->crs_graph->insertGlobalIndices(
-          current_row, Teuchos::ArrayView<GomaGlobalOrdinal>(indices.data(), row_count));
-      current_row = coo_rows[i];
-      row_count = 0;
-    }
-    indices[row_count] = coo_cols[i];
-    values[row_count] = coo_cols[i];
-    row_count++;
+  tmp->col_map = Teuchos::rcp(new Tpetra::Map<LO, GO>(
+      Teuchos::OrdinalTraits<Tpetra::global_size_t>::invalid(), col_list_view, 0, comm));
+
+  // exact row lengths, so the graph storage is allocated once
+  using device_type = typename Tpetra::FECrsGraph<LO, GO>::device_type;
+  Kokkos::DualView<size_t *, device_type> num_entries("num_entries_per_row", n_rows);
+  num_entries.modify_host();
+  for (GomaGlobalOrdinal i = 0; i < n_rows; i++) {
+    num_entries.h_view(i) = static_cast<size_t>(row_ptr[i + 1] - row_ptr[i]);
+  }
+  num_entries.sync_device();
+
+  tmp->crs_graph = Teuchos::rcp(
+      new Tpetra::FECrsGraph<LO, GO>(tmp->row_map, tmp->row_map, tmp->col_map, num_entries));
+
+  // columns are already local indices into col_list, no global lookups needed
+  for (GomaGlobalOrdinal i = 0; i < n_rows; i++) {
+    tmp->crs_graph->insertLocalIndices(
+        static_cast<LO>(i),
+        Teuchos::ArrayView<const LO>(local_cols + row_ptr[i], row_ptr[i + 1] - row_ptr[i]));
   }
-  tmp->crs_graph->insertGlobalIndices(
-      current_row, Teuchos::ArrayView<GomaGlobalOrdinal>(indices.data(), row_count));
 
   if (Debug_Flag > 2) {
     RCP<Teuchos::FancyOStream> fos = Teuchos::fancyOStream(Teuchos::rcpFromRef(std::cout));
@@ -88,6 +92,9 @@ extern "C" goma_error g_tpetra_create_graph(GomaSparseMatrix matrix,
 
   tmp->matrix = Teuchos::rcp(new Tpetra::FECrsMatrix<double, LO, GO>((tmp->crs_graph)));
   tmp->matrix->beginAssembly();
+
+  tmp->col_scale = decltype(tmp->col_scale)("col_scale", n_rows);
+  Kokkos::deep_copy(tmp->col_scale, 1.0);
   return GOMA_SUCCESS;
 }
 
@@ -125,85 +132,170 @@ extern "C" goma_error g_tpetra_sum_into_row_values(GomaSparseMatrix matrix,
 extern "C" goma_error g_tpetra_put_scalar(GomaSparseMatrix matrix, double scalar) {
   auto *tmp = static_cast<TpetraSparseMatrix *>(matrix->data);
   tmp->matrix->setAllToScalar(scalar);
+  // a new assembly starts without column equilibration
+  Kokkos::deep_copy(tmp->col_scale, 1.0);
   return GOMA_SUCCESS;
 }
 
+/*
+ * Equilibrate the local rows with kernels over the local CRS views,
+ * row: A_ij / r_i, column: A_ij / c_j, symmetric: A_ij / sqrt(r_i c_j),
+ * with r and c the absolute row and column sums. The column sums need
+ * the contributions of the other processors, row scaling stays local.
+ */
 extern "C" goma_error g_tpetra_row_sum_scaling(GomaSparseMatrix matrix, double *b, double *scale) {
   auto *tmp = static_cast<TpetraSparseMatrix *>(matrix->data);
+  using crs_t = Tpetra::CrsMatrix<double, LO, GO>;
+  using device_type = typename crs_t::device_type;
+  using execution_space = typename crs_t::execution_space;
   bool ended_assembly = false;
   if (!tmp->matrix->isFillComplete()) {
     tmp->matrix->endAssembly();
     ended_assembly = true;
   }
-  RCP<Tpetra::Vector<double, LO, GO>> b_vec =
-      Teuchos::rcp(new Tpetra::Vector<double, LO, GO>(tmp->row_map));
-  auto n_rows = tmp->matrix->getLocalNumRows();
+  const LO n_rows = static_cast<LO>(tmp->matrix->getLocalNumRows());
+  const LO n_cols = static_cast<LO>(tmp->col_map->getLocalNumElements());
+  Kokkos::View<double *, device_type> row_factor("row_factor", n_rows);
+  Kokkos::View<double *, device_type> col_factor("col_factor", n_cols);
+  auto local_matrix = tmp->matrix->getLocalMatrixDevice();
+  int zero_sums = 0;
 
-  using crs_t = Tpetra::CrsMatrix<double, LO, GO>;
-  typename crs_t::local_inds_host_view_type indices;
-  typename crs_t::values_host_view_type values;
-  for (size_t i = 0; i < n_rows; i++) {
-    tmp->matrix->getLocalRowView(i, indices, values);
-    double row_sum = 0;
-    for (size_t j = 0; j < values.size(); j++) {
-      row_sum += std::abs(values[j]);
-    }
-    if (row_sum == 0) {
-      GOMA_WH_MANY(GOMA_ERROR, "Row sum is zero setting to 1.0, g_tpetra_row_sum_scaling");
-      row_sum = 1.0;
-    }
-    b_vec->replaceLocalValue(i, 1.0 / row_sum);
+  if (matrix->equilibration == EQUILIBRATE_ROW) {
+    Kokkos::parallel_reduce(
+        "g_tpetra_row_sums", Kokkos::RangePolicy<execution_space>(0, n_rows),
+        KOKKOS_LAMBDA(const LO i, int &zeros) {
+          double row_sum = 0;
+          for (auto k = local_matrix.graph.row_map(i); k < local_matrix.graph.row_map(i + 1); k++) {
+            row_sum += Kokkos::fabs(local_matrix.values(k));
+          }
+          if (row_sum == 0) {
+            row_sum = 1.0;
+            zeros++;
+          }
+          row_factor(i) = 1.0 / row_sum;
+        },
+        zero_sums);
+    Kokkos::deep_copy(col_factor, 1.0);
+  } else {
+    auto norms = Tpetra::computeRowAndColumnOneNorms(*tmp->matrix, false);
+    auto row_norms = norms.rowNorms;
+    auto col_norms = norms.colNorms;
+    const bool symmetric = matrix->equilibration == EQUILIBRATE_SYMMETRIC;
+    Kokkos::parallel_reduce(
+        "g_tpetra_row_factors", Kokkos::RangePolicy<execution_space>(0, n_rows),
+        KOKKOS_LAMBDA(const LO i, int &zeros) {
+          double row_sum = row_norms(i);
+          if (row_sum == 0) {
+            row_sum = 1.0;
+            zeros++;
+          }
+          row_factor(i) = symmetric ? 1.0 / Kokkos::sqrt(row_sum) : 1.0;
+        },
+        zero_sums);
+    Kokkos::parallel_for(
+        "g_tpetra_col_factors", Kokkos::RangePolicy<execution_space>(0, n_cols),
+        KOKKOS_LAMBDA(const LO j) {
+          double col_sum = col_norms(j) == 0 ? 1.0 : col_norms(j);
+          col_factor(j) = symmetric ? 1.0 / Kokkos::sqrt(col_sum) : 1.0 / col_sum;
+        });
+  }
+
+  Kokkos::parallel_for(
+      "g_tpetra_equilibrate", Kokkos::RangePolicy<execution_space>(0, n_rows),
+      KOKKOS_LAMBDA(const LO i) {
+        for (auto k = local_matrix.graph.row_map(i); k < local_matrix.graph.row_map(i + 1); k++) {
+          local_matrix.values(k) *= row_factor(i) * col_factor(local_matrix.graph.entries(k));
+        }
+      });
+
+  if (matrix->equilibration != EQUILIBRATE_ROW) {
+    auto row_map = tmp->row_map->getLocalMap();
+    auto col_map = tmp->col_map->getLocalMap();
+    auto col_scale = tmp->col_scale;
+    Kokkos::parallel_for(
+        "g_tpetra_col_scale", Kokkos::RangePolicy<execution_space>(0, n_rows),
+        KOKKOS_LAMBDA(const LO i) {
+          col_scale(i) *= col_factor(col_map.getLocalElement(row_map.getGlobalElement(i)));
+        });
+  }
+
+  if (zero_sums > 0) {
+    GOMA_WH_MANY(GOMA_ERROR, "Row sum is zero setting to 1.0, g_tpetra_row_sum_scaling");
   }
-  tmp->matrix->leftScale(*b_vec);
   if (ended_assembly) {
     tmp->matrix->beginAssembly();
   }
-  // tmp->matrix->beginAssembly();
-  auto data = b_vec->getData();
-  for (size_t i = 0; i < n_rows; i++) {
-    auto local = tmp->matrix->getRowMap()->getLocalElement(matrix->global_ids[i]);
-    scale[local] = 1 / data[local];
-    b[local] *= data[local];
+
+  // rows follow global_ids, so the local row is also the index into b and scale
+  auto row_factor_host = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), row_factor);
+  for (LO i = 0; i < n_rows; i++) {
+    scale[i] = 1 / row_factor_host(i);
+    b[i] *= row_factor_host(i);
   }
   return GOMA_SUCCESS;
 }
 
-extern "C" goma_error g_tpetra_zero_row(GomaSparseMatrix matrix, GomaGlobalOrdinal global_row) {
+extern "C" goma_error g_tpetra_unscale_solution(GomaSparseMatrix matrix, double *x) {
   auto *tmp = static_cast<TpetraSparseMatrix *>(matrix->data);
-  using crs_t = Tpetra::CrsMatrix<double, LO, GO>;
-  typename crs_t::nonconst_global_inds_host_view_type Indices;
-  typename crs_t::nonconst_values_host_view_type Values;
-  size_t NumEntries;
-  tmp->matrix->getGlobalRowCopy(global_row, Indices, Values, NumEntries);
-  if (NumEntries == Teuchos::OrdinalTraits<size_t>::invalid()) {
-    GOMA_EH(GOMA_ERROR, "Global row does not exist on this processor, g_tptra_zero_row");
+  if (matrix->equilibration == EQUILIBRATE_ROW) {
+    return GOMA_SUCCESS;
+  }
+  auto col_scale_host = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), tmp->col_scale);
+  for (size_t i = 0; i < col_scale_host.extent(0); i++) {
+    x[i] *= col_scale_host(i);
   }
-  for (size_t i = 0; i < NumEntries; i++) {
-    Values[i] = 0;
+  return GOMA_SUCCESS;
+}
+
+extern "C" goma_error g_tpetra_zero_local_rows(GomaSparseMatrix matrix,
+                                               int num_rows,
+                                               int *local_rows,
+                                               int set_diag) {
+  auto *tmp = static_cast<TpetraSparseMatrix *>(matrix->data);
+  using crs_t = Tpetra::CrsMatrix<double, LO, GO>;
+  using device_type = typename crs_t::device_type;
+  using execution_space = typename crs_t::execution_space;
+  if (num_rows == 0) {
+    return GOMA_SUCCESS;
   }
+  Kokkos::View<LO *, device_type> rows("zero_rows", num_rows);
+  Kokkos::deep_copy(rows, Kokkos::View<LO *, Kokkos::HostSpace, Kokkos::MemoryUnmanaged>(
+                              local_rows, num_rows));
 
+  auto local_matrix = tmp->matrix->getLocalMatrixDevice();
+  auto row_map = tmp->row_map->getLocalMap();
+  auto col_map = tmp->col_map->getLocalMap();
+  const double diag_value = set_diag ? 1.0 : 0.0;
+  Kokkos::parallel_for(
+      "g_tpetra_zero_rows", Kokkos::RangePolicy<execution_space>(0, num_rows),
+      KOKKOS_LAMBDA(const int r) {
+        const LO row = rows(r);
+        const LO diag = col_map.getLocalElement(row_map.getGlobalElement(row));
+        for (auto k = local_matrix.graph.row_map(row); k < local_matrix.graph.row_map(row + 1);
+             k++) {
+          local_matrix.values(k) = local_matrix.graph.entries(k) == diag ? diag_value : 0.0;
+        }
+      });
   return GOMA_SUCCESS;
 }
 
+extern "C" goma_error g_tpetra_zero_row(GomaSparseMatrix matrix, GomaGlobalOrdinal global_row) {
+  auto *tmp = static_cast<TpetraSparseMatrix *>(matrix->data);
+  LO local_row = tmp->row_map->getLocalElement(global_row);
+  if (local_row == Teuchos::OrdinalTraits<LO>::invalid()) {
+    GOMA_EH(GOMA_ERROR, "Global row does not exist on this processor, g_tptra_zero_row");
+  }
+  return g_tpetra_zero_local_rows(matrix, 1, &local_row, FALSE);
+}
+
 extern "C" goma_error g_tpetra_zero_row_set_diag(GomaSparseMatrix matrix,
                                                  GomaGlobalOrdinal global_row) {
   auto *tmp = static_cast<TpetraSparseMatrix *>(matrix->data);
-  using crs_t = Tpetra::CrsMatrix<double, LO, GO>;
-  typename crs_t::nonconst_global_inds_host_view_type Indices;
-  typename crs_t::nonconst_values_host_view_type Values;
-  size_t NumEntries;
-  tmp->matrix->getGlobalRowCopy(global_row, Indices, Values, NumEntries);
-  if (NumEntries == Teuchos::OrdinalTraits<size_t>::invalid()) {
+  LO local_row = tmp->row_map->getLocalElement(global_row);
+  if (local_row == Teuchos::OrdinalTraits<LO>::invalid()) {
     GOMA_EH(GOMA_ERROR, "Global row does not exist on this processor, g_tptra_zero_row");
   }
-  for (size_t i = 0; i < NumEntries; i++) {
-    if (Indices[i] == global_row) {
-      Values[i] = 1;
-    } else {
-      Values[i] = 0;
-    }
-  }
-  return GOMA_SUCCESS;
+  return g_tpetra_zero_local_rows(matrix, 1, &local_row, TRUE);
 }
 
 extern "C" goma_error g_tpetra_destroy(GomaSparseMatrix matrix) {
@@ -0,0 +1,323 @@
+#ifdef GOMA_ENABLE_TPETRA
+#include "std.h"
+#include <Kokkos_Core.hpp>
+#include <Teuchos_ArrayViewDecl.hpp>
+#include <Teuchos_DefaultMpiComm.hpp>
+#include <Teuchos_RCPDecl.hpp>
+#include <Tpetra_BlockCrsMatrix.hpp>
+#include <Tpetra_CrsGraph.hpp>
+#include <Tpetra_Map.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <mpi.h>
+#include <vector>
+
+extern "C" {
+#include "mm_eh.h"
+#include "rf_io.h"
+}
+#include "linalg/sparse_matrix.h"
+#include "linalg/sparse_matrix_tpetra_block.h"
+
+using Teuchos::RCP;
+
+using block_crs_t = Tpetra::BlockCrsMatrix<double, LO, GO>;
+
+extern "C" goma_error GomaSparseMatrix_TpetraBlock_Create(GomaSparseMatrix *matrix) {
+  TpetraBlockSparseMatrix *tmp = new TpetraBlockSparseMatrix();
+  (*matrix)->type = GOMA_SPARSE_MATRIX_TYPE_TPETRA_BLOCK;
+  (*matrix)->data = reinterpret_cast<void *>(tmp);
+  (*matrix)->create_graph = g_tpetra_block_create_graph;
+  (*matrix)->complete_graph = NULL;
+  (*matrix)->insert_row_values = g_tpetra_block_insert_row_values;
+  (*matrix)->sum_into_row_values = g_tpetra_block_sum_into_row_values;
+  (*matrix)->sum_into_block_row_values = g_tpetra_block_sum_into_block_row_values;
+  (*matrix)->put_scalar = g_tpetra_block_put_scalar;
+  (*matrix)->row_sum_scaling = g_tpetra_block_row_sum_scaling;
+  (*matrix)->zero_global_row = g_tpetra_block_zero_row;
+  (*matrix)->zero_global_row_set_diag = g_tpetra_block_zero_row_set_diag;
+  (*matrix)->destroy = g_tpetra_block_destroy;
+  return GOMA_SUCCESS;
+}
+
+/*
+ * The point global ids of the unknowns of a node must be
+ * node_gid * block_size + k for the point maps of the block matrix to match
+ * the Goma numbering, this holds whenever every node carries block_size
+ * unknowns
+ */
+static bool node_blocked_ids(GomaGlobalOrdinal n, GomaGlobalOrdinal *list, int bs) {
+  if (n % bs != 0) {
+    return false;
+  }
+  for (GomaGlobalOrdinal b = 0; b < n / bs; b++) {
+    if (list[b * bs] % bs != 0) {
+      return false;
+    }
+    for (int k = 1; k < bs; k++) {
+      if (list[b * bs + k] != list[b * bs] + k) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+extern "C" goma_error g_tpetra_block_create_graph(GomaSparseMatrix matrix,
+                                                  GomaGlobalOrdinal n_rows,
+                                                  GomaGlobalOrdinal *row_list,
+                                                  GomaGlobalOrdinal n_cols,
+                                                  GomaGlobalOrdinal *col_list,
+                                                  GomaGlobalOrdinal local_nnz,
+                                                  GomaGlobalOrdinal max_per_row,
+                                                  GomaGlobalOrdinal *row_ptr,
+                                                  int *local_cols) {
+  auto *tmp = static_cast<TpetraBlockSparseMatrix *>(matrix->data);
+  RCP<const Teuchos::MpiComm<int>> comm(new Teuchos::MpiComm<int>(MPI_COMM_WORLD));
+  int bs = matrix->block_size;
+
+  int blocked = bs > 0 && node_blocked_ids(n_rows, row_list, bs) &&
+                node_blocked_ids(n_cols, col_list, bs);
+  int all_blocked;
+  MPI_Allreduce(&blocked, &all_blocked, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+  if (!all_blocked) {
+    GOMA_EH(GOMA_ERROR, "Matrix storage format tpetra_block requires the same unknowns at every "
+                        "node, use tpetra");
+    return GOMA_ERROR;
+  }
+
+  LO n_block_rows = n_rows / bs;
+  LO n_block_cols = n_cols / bs;
+
+  std::vector<GO> block_row_list(n_block_rows);
+  std::vector<GO> block_col_list(n_block_cols);
+  for (LO b = 0; b < n_block_rows; b++) {
+    block_row_list[b] = row_list[b * bs] / bs;
+  }
+  for (LO b = 0; b < n_block_cols; b++) {
+    block_col_list[b] = col_list[b * bs] / bs;
+  }
+
+  auto invalid = Teuchos::OrdinalTraits<Tpetra::global_size_t>::invalid();
+  tmp->row_map = Teuchos::rcp(new Tpetra::Map<LO, GO>(
+      invalid, Teuchos::ArrayView<const GO>(block_row_list.data(), n_block_rows), 0, comm));
+  tmp->col_map = Teuchos::rcp(new Tpetra::Map<LO, GO>(
+      invalid, Teuchos::ArrayView<const GO>(block_col_list.data(), n_block_cols), 0, comm));
+
+  /*
+   * Collapse the point CSR to nodes, a block is present when any of its
+   * point entries is
+   */
+  using local_graph_t = typename Tpetra::CrsGraph<LO, GO>::local_graph_device_type;
+  std::vector<size_t> h_block_ptr(n_block_rows + 1, 0);
+  std::vector<LO> h_block_cols;
+  h_block_cols.reserve(local_nnz / bs + 1);
+  std::vector<LO> row_blocks;
+  for (LO b = 0; b < n_block_rows; b++) {
+    row_blocks.clear();
+    for (GomaGlobalOrdinal k = row_ptr[b * bs]; k < row_ptr[(b + 1) * bs]; k++) {
+      row_blocks.push_back(local_cols[k] / bs);
+    }
+    std::sort(row_blocks.begin(), row_blocks.end());
+    row_blocks.erase(std::unique(row_blocks.begin(), row_blocks.end()), row_blocks.end());
+    h_block_cols.insert(h_block_cols.end(), row_blocks.begin(), row_blocks.end());
+    h_block_ptr[b + 1] = h_block_cols.size();
+  }
+
+  typename local_graph_t::row_map_type::non_const_type block_ptr("block_ptr", n_block_rows + 1);
+  typename local_graph_t::entries_type::non_const_type block_cols("block_cols",
+                                                                  h_block_cols.size());
+  auto block_ptr_h = Kokkos::create_mirror_view(block_ptr);
+  auto block_cols_h = Kokkos::create_mirror_view(block_cols);
+  for (LO b = 0; b <= n_block_rows; b++) {
+    block_ptr_h(b) = h_block_ptr[b];
+  }
+  for (size_t k = 0; k < h_block_cols.size(); k++) {
+    block_cols_h(k) = h_block_cols[k];
+  }
+  Kokkos::deep_copy(block_ptr, block_ptr_h);
+  Kokkos::deep_copy(block_cols, block_cols_h);
+
+  tmp->crs_graph =
+      Teuchos::rcp(new Tpetra::CrsGraph<LO, GO>(tmp->row_map, tmp->col_map, block_ptr, block_cols));
+  tmp->crs_graph->fillComplete(tmp->row_map, tmp->row_map);
+
+  if (Debug_Flag > 2) {
+    RCP<Teuchos::FancyOStream> fos = Teuchos::fancyOStream(Teuchos::rcpFromRef(std::cout));
+    tmp->crs_graph->describe(*fos, Teuchos::VERB_EXTREME);
+  }
+
+  tmp->matrix = Teuchos::rcp(new block_crs_t(*(tmp->crs_graph), bs));
+  return GOMA_SUCCESS;
+}
+
+extern "C" goma_error g_tpetra_block_insert_row_values(GomaSparseMatrix matrix,
+                                                       GomaGlobalOrdinal global_row,
+                                                       GomaGlobalOrdinal num_entries,
+                                                       double *values,
+                                                       GomaGlobalOrdinal *indices) {
+  GOMA_EH(GOMA_ERROR, "insert_row_values not supported by tpetra_block, the graph is fixed");
+  return GOMA_ERROR;
+}
+
+/*
+ * Point row access into the node blocks, the blocks of a block row are
+ * stored row major one after the other
+ */
+static LO block_row_view(TpetraBlockSparseMatrix *tmp,
+                         int bs,
+                         GomaGlobalOrdinal global_row,
+                         typename block_crs_t::local_inds_host_view_type &block_cols,
+                         typename block_crs_t::nonconst_values_host_view_type &values) {
+  LO block_row = tmp->row_map->getLocalElement(global_row / bs);
+  if (block_row == Teuchos::OrdinalTraits<LO>::invalid()) {
+    return block_row;
+  }
+  tmp->matrix->getLocalRowViewNonConst(block_row, block_cols, values);
+  return block_row;
+}
+
+extern "C" goma_error g_tpetra_block_sum_into_row_values(GomaSparseMatrix matrix,
+                                                         GomaGlobalOrdinal global_row,
+                                                         GomaGlobalOrdinal num_entries,
+                                                         double *values,
+                                                         GomaGlobalOrdinal *indices) {
+  auto *tmp = static_cast<TpetraBlockSparseMatrix *>(matrix->data);
+  int bs = matrix->block_size;
+  int r = global_row % bs;
+  typename block_crs_t::local_inds_host_view_type block_cols;
+  typename block_crs_t::nonconst_values_host_view_type block_values;
+  if (block_row_view(tmp, bs, global_row, block_cols, block_values) ==
+      Teuchos::OrdinalTraits<LO>::invalid()) {
+    GOMA_EH(GOMA_ERROR, "Global row does not exist on this processor, g_tpetra_block_sum_into");
+    return GOMA_ERROR;
+  }
+  GomaGlobalOrdinal num_summed = 0;
+  for (GomaGlobalOrdinal i = 0; i < num_entries; i++) {
+    LO block_col = tmp->col_map->getLocalElement(indices[i] / bs);
+    int c = indices[i] % bs;
+    for (size_t k = 0; k < block_cols.extent(0); k++) {
+      if (block_cols(k) == block_col) {
+        block_values(k * bs * bs + r * bs + c) += values[i];
+        num_summed++;
+        break;
+      }
+    }
+  }
+  if (num_summed != num_entries) {
+    GOMA_EH(GOMA_ERROR, "Column not in the graph of row %ld, g_tpetra_block_sum_into",
+            (long)global_row);
+    return GOMA_ERROR;
+  }
+  return GOMA_SUCCESS;
+}
+
+extern "C" goma_error g_tpetra_block_sum_into_block_row_values(GomaSparseMatrix matrix,
+                                                               int local_block_row,
+                                                               int num_blocks,
+                                                               double *values,
+                                                               int *local_block_cols) {
+  auto *tmp = static_cast<TpetraBlockSparseMatrix *>(matrix->data);
+  LO num_summed =
+      tmp->matrix->sumIntoLocalValues(local_block_row, local_block_cols, values, num_blocks);
+  if (num_summed != num_blocks) {
+    GOMA_EH(GOMA_ERROR, "Block column not in the graph of block row %d, g_tpetra_block_sum_into",
+            local_block_row);
+    return GOMA_ERROR;
+  }
+  return GOMA_SUCCESS;
+}
+
+extern "C" goma_error g_tpetra_block_put_scalar(GomaSparseMatrix matrix, double scalar) {
+  auto *tmp = static_cast<TpetraBlockSparseMatrix *>(matrix->data);
+  tmp->matrix->setAllToScalar(scalar);
+  return GOMA_SUCCESS;
+}
+
+extern "C" goma_error g_tpetra_block_row_sum_scaling(GomaSparseMatrix matrix,
+                                                     double *b,
+                                                     double *scale) {
+  auto *tmp = static_cast<TpetraBlockSparseMatrix *>(matrix->data);
+  int bs = matrix->block_size;
+  LO n_block_rows = tmp->row_map->getLocalNumElements();
+  std::vector<double> row_sum(bs);
+
+  typename block_crs_t::local_inds_host_view_type block_cols;
+  typename block_crs_t::nonconst_values_host_view_type values;
+  for (LO i = 0; i < n_block_rows; i++) {
+    tmp->matrix->getLocalRowViewNonConst(i, block_cols, values);
+    size_t n_blocks = block_cols.extent(0);
+    std::fill(row_sum.begin(), row_sum.end(), 0.0);
+    for (size_t k = 0; k < n_blocks; k++) {
+      for (int r = 0; r < bs; r++) {
+        for (int c = 0; c < bs; c++) {
+          row_sum[r] += std::abs(values(k * bs * bs + r * bs + c));
+        }
+      }
+    }
+    for (int r = 0; r < bs; r++) {
+      if (row_sum[r] == 0) {
+        GOMA_WH_MANY(GOMA_ERROR, "Row sum is zero setting to 1.0, g_tpetra_block_row_sum_scaling");
+        row_sum[r] = 1.0;
+      }
+      for (size_t k = 0; k < n_blocks; k++) {
+        for (int c = 0; c < bs; c++) {
+          values(k * bs * bs + r * bs + c) /= row_sum[r];
+        }
+      }
+      scale[i * bs + r] = row_sum[r];
+      b[i * bs + r] /= row_sum[r];
+    }
+  }
+  return GOMA_SUCCESS;
+}
+
+extern "C" goma_error g_tpetra_block_zero_row(GomaSparseMatrix matrix,
+                                              GomaGlobalOrdinal global_row) {
+  auto *tmp = static_cast<TpetraBlockSparseMatrix *>(matrix->data);
+  int bs = matrix->block_size;
+  int r = global_row % bs;
+  typename block_crs_t::local_inds_host_view_type block_cols;
+  typename block_crs_t::nonconst_values_host_view_type values;
+  if (block_row_view(tmp, bs, global_row, block_cols, values) ==
+      Teuchos::OrdinalTraits<LO>::invalid()) {
+    GOMA_EH(GOMA_ERROR, "Global row does not exist on this processor, g_tpetra_block_zero_row");
+    return GOMA_ERROR;
+  }
+  for (size_t k = 0; k < block_cols.extent(0); k++) {
+    for (int c = 0; c < bs; c++) {
+      values(k * bs * bs + r * bs + c) = 0;
+    }
+  }
+  return GOMA_SUCCESS;
+}
+
+extern "C" goma_error g_tpetra_block_zero_row_set_diag(GomaSparseMatrix matrix,
+                                                       GomaGlobalOrdinal global_row) {
+  auto *tmp = static_cast<TpetraBlockSparseMatrix *>(matrix->data);
+  int bs = matrix->block_size;
+  int r = global_row % bs;
+  typename block_crs_t::local_inds_host_view_type block_cols;
+  typename block_crs_t::nonconst_values_host_view_type values;
+  if (block_row_view(tmp, bs, global_row, block_cols, values) ==
+      Teuchos::OrdinalTraits<LO>::invalid()) {
+    GOMA_EH(GOMA_ERROR, "Global row does not exist on this processor, g_tpetra_block_zero_row");
+    return GOMA_ERROR;
+  }
+  LO diag_block = tmp->col_map->getLocalElement(global_row / bs);
+  for (size_t k = 0; k < block_cols.extent(0); k++) {
+    for (int c = 0; c < bs; c++) {
+      values(k * bs * bs + r * bs + c) = (block_cols(k) == diag_block && c == r) ? 1.0 : 0.0;
+    }
+  }
+  return GOMA_SUCCESS;
+}
+
+extern "C" goma_error g_tpetra_block_destroy(GomaSparseMatrix matrix) {
+  delete static_cast<TpetraBlockSparseMatrix *>(matrix->data);
+  return GOMA_SUCCESS;
+}
+#endif // GOMA_ENABLE_TPETRA
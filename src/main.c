@@ -50,6 +50,7 @@ extern void handle_ieee(void);
 #include "metis_decomp.h"
 #endif
 #include "brkfix/fix.h"
+#include "md_timer.h"
 #include "mm_as.h"
 #include "mm_as_alloc.h"
 #include "mm_as_structs.h"
@@ -939,6 +940,8 @@ int main(int argc, char **argv)
     GOMA_WH(unlerr, "Unlink problem with front scratch file");
   }
 
+  goma_prof_summary();
+
 #ifdef PARALLEL
   total_time = (MPI_Wtime() - time_start) / 60.;
   DPRINTF(stdout, "\nProc 0 runtime: %10.2f Minutes.\n\n", total_time);
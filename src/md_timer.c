@@ -74,8 +74,11 @@
 
 #define GOMA_MD_TIMER_C
 #include "md_timer.h"
+#include "rf_mp.h"
 #include "std.h"
 
+int Goma_Profile = FALSE;
+
 /*
  * ut -- return user time in seconds (double).
  */
@@ -186,5 +189,308 @@ void get_time(char *string) {
 
 /*****************************************************************************/
 
+/*
+ * wall_time -- return monotonic wall clock time in seconds (double).
+ */
+dbl wall_time(void) {
+#ifdef CLOCK_MONOTONIC
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ((dbl)ts.tv_sec + 1.0e-9 * (dbl)ts.tv_nsec);
+#else
+  return (MPI_Wtime());
+#endif
+} /* END of routine wall_time */
+/*****************************************************************************/
+
+/*
+ * Region profiler
+ *
+ * Every (parent, name) pair seen gets a node in a tree rooted at node 0.
+ * Children are kept in a singly linked list, searched by name pointer
+ * first since regions are named by string literals.
+ */
+
+#define PROF_MAX_DEPTH 64
+
+struct Prof_Node {
+  const char *name;
+  int parent;
+  int first_child;
+  int next_sibling;
+  long calls;
+  dbl total;
+  dbl start;
+};
+
+static struct Prof_Node *Prof_Nodes = NULL;
+static int Prof_Num_Nodes = 0;
+static int Prof_Max_Nodes = 0;
+static int Prof_Current = 0;
+static int Prof_Depth = 0;
+
+static int prof_new_node(const char *name, const int parent) {
+  struct Prof_Node *node;
+
+  if (Prof_Num_Nodes == Prof_Max_Nodes) {
+    Prof_Max_Nodes = (Prof_Max_Nodes == 0) ? 64 : 2 * Prof_Max_Nodes;
+    Prof_Nodes = realloc(Prof_Nodes, Prof_Max_Nodes * sizeof(struct Prof_Node));
+    if (Prof_Nodes == NULL) {
+      fprintf(stderr, "error allocating profiler regions.\n");
+      exit(-1);
+    }
+  }
+  node = Prof_Nodes + Prof_Num_Nodes;
+  node->name = name;
+  node->parent = parent;
+  node->first_child = -1;
+  node->next_sibling = -1;
+  node->calls = 0;
+  node->total = 0.0;
+  node->start = 0.0;
+  if (parent >= 0) {
+    node->next_sibling = Prof_Nodes[parent].first_child;
+    Prof_Nodes[parent].first_child = Prof_Num_Nodes;
+  }
+  return (Prof_Num_Nodes++);
+}
+
+void goma_prof_begin(const char *name) {
+  int c;
+
+  if (Prof_Num_Nodes == 0) {
+    prof_new_node("total", -1);
+    Prof_Nodes[0].start = wall_time();
+  }
+
+  for (c = Prof_Nodes[Prof_Current].first_child; c != -1; c = Prof_Nodes[c].next_sibling) {
+    if (Prof_Nodes[c].name == name || strcmp(Prof_Nodes[c].name, name) == 0) {
+      break;
+    }
+  }
+  if (c == -1) {
+    c = prof_new_node(name, Prof_Current);
+  }
+
+  if (Prof_Depth < PROF_MAX_DEPTH) {
+    Prof_Depth++;
+    Prof_Current = c;
+    Prof_Nodes[c].calls++;
+    Prof_Nodes[c].start = wall_time();
+  }
+} /* END of routine goma_prof_begin */
+
+/*
+ * goma_prof_end -- close region name
+ *
+ * Regions left open by an early return inside name are closed with it.
+ */
+void goma_prof_end(const char *name) {
+  int n;
+  dbl now;
+
+  for (n = Prof_Current; n > 0; n = Prof_Nodes[n].parent) {
+    if (Prof_Nodes[n].name == name || strcmp(Prof_Nodes[n].name, name) == 0) {
+      break;
+    }
+  }
+  if (n <= 0) {
+    return; /* not open, nothing to close */
+  }
+
+  now = wall_time();
+  while (Prof_Current != Prof_Nodes[n].parent) {
+    Prof_Nodes[Prof_Current].total += now - Prof_Nodes[Prof_Current].start;
+    Prof_Current = Prof_Nodes[Prof_Current].parent;
+    Prof_Depth--;
+  }
+} /* END of routine goma_prof_end */
+
+/*
+ * Full path of node n, "parent/child/..." below the root
+ */
+static void prof_path(const int n, char *path, const size_t len) {
+  if (n <= 0) {
+    path[0] = '\0';
+    return;
+  }
+  prof_path(Prof_Nodes[n].parent, path, len);
+  if (path[0] != '\0') {
+    strncat(path, "/", len - strlen(path) - 1);
+  }
+  strncat(path, Prof_Nodes[n].name, len - strlen(path) - 1);
+}
+
+static void prof_print_tree(FILE *fp, const int n, const int depth, const dbl total) {
+  int c;
+  dbl child_time = 0.0;
+
+  for (c = Prof_Nodes[n].first_child; c != -1; c = Prof_Nodes[c].next_sibling) {
+    child_time += Prof_Nodes[c].total;
+  }
+  if (n > 0) {
+    fprintf(fp, "%*s%-*s %10ld %12.4f %12.4f %6.1f%%\n", 2 * (depth - 1), "",
+            40 - 2 * (depth - 1), Prof_Nodes[n].name, Prof_Nodes[n].calls, Prof_Nodes[n].total,
+            Prof_Nodes[n].total - child_time,
+            (total > 0.0) ? 100.0 * Prof_Nodes[n].total / total : 0.0);
+  }
+  for (c = Prof_Nodes[n].first_child; c != -1; c = Prof_Nodes[c].next_sibling) {
+    prof_print_tree(fp, c, depth + 1, total);
+  }
+}
+
+#define PROF_PATH_LEN 256
+
+/*
+ * goma_prof_summary -- write the profile of this rank to goma-profile.<rank>
+ *                      and the min/avg/max over ranks to stdout.
+ *
+ * Must be called by all ranks. Ranks may have seen different regions,
+ * the reduced summary is over the union of the region paths.
+ */
+void goma_prof_summary(void) {
+  FILE *fp;
+  char fname[80];
+  char *paths = NULL, *all_paths = NULL;
+  int n, i, j, p, num_paths, my_len, total_len;
+  int *lens = NULL, *displs = NULL;
+  long *calls = NULL, *calls_sum = NULL;
+  dbl *times = NULL, *t_min = NULL, *t_max = NULL, *t_sum = NULL;
+  dbl total;
+
+  if (!Goma_Profile) {
+    return;
+  }
+  if (Prof_Num_Nodes == 0) {
+    prof_new_node("total", -1);
+    Prof_Nodes[0].start = wall_time();
+  }
+  total = wall_time() - Prof_Nodes[0].start;
+
+  snprintf(fname, sizeof(fname), "goma-profile.%d", ProcID);
+  fp = fopen(fname, "w");
+  if (fp != NULL) {
+    fprintf(fp, "Goma region profile, rank %d of %d, %.4f s wall time\n\n", ProcID, Num_Proc,
+            total);
+    fprintf(fp, "%-40s %10s %12s %12s %7s\n", "region", "calls", "total [s]", "self [s]", "share");
+    prof_print_tree(fp, 0, 0, total);
+    fclose(fp);
+  }
+
+  /*
+   * Union of the region paths over all ranks, gathered on rank 0 and sent
+   * back out as one '\n' separated string
+   */
+  paths = calloc((size_t)Prof_Num_Nodes * PROF_PATH_LEN + 1, sizeof(char));
+  for (n = 1; n < Prof_Num_Nodes; n++) {
+    char path[PROF_PATH_LEN];
+    prof_path(n, path, PROF_PATH_LEN);
+    strcat(paths, path);
+    strcat(paths, "\n");
+  }
+  my_len = (int)strlen(paths);
+
+  lens = calloc(Num_Proc, sizeof(int));
+  displs = calloc(Num_Proc + 1, sizeof(int));
+  MPI_Gather(&my_len, 1, MPI_INT, lens, 1, MPI_INT, 0, MPI_COMM_WORLD);
+  for (p = 0; p < Num_Proc; p++) {
+    displs[p + 1] = displs[p] + lens[p];
+  }
+  total_len = displs[Num_Proc];
+  all_paths = calloc((size_t)total_len + 1, sizeof(char));
+  MPI_Gatherv(paths, my_len, MPI_CHAR, all_paths, lens, displs, MPI_CHAR, 0, MPI_COMM_WORLD);
+
+  if (ProcID == 0) {
+    /* drop repeated paths, keeping the first occurrence */
+    char *src = all_paths, *dst = all_paths, *line;
+    all_paths[total_len] = '\0';
+    while (*src != '\0') {
+      char *eol = strchr(src, '\n');
+      size_t l = (size_t)(eol - src);
+      int seen = FALSE;
+      for (line = all_paths; line < dst; line = strchr(line, '\n') + 1) {
+        if (strncmp(line, src, l) == 0 && line[l] == '\n') {
+          seen = TRUE;
+          break;
+        }
+      }
+      if (!seen) {
+        memmove(dst, src, l + 1);
+        dst += l + 1;
+      }
+      src = eol + 1;
+    }
+    *dst = '\0';
+    total_len = (int)(dst - all_paths);
+  }
+  MPI_Bcast(&total_len, 1, MPI_INT, 0, MPI_COMM_WORLD);
+  all_paths[total_len] = '\0';
+  MPI_Bcast(all_paths, total_len, MPI_CHAR, 0, MPI_COMM_WORLD);
+
+  num_paths = 0;
+  for (i = 0; i < total_len; i++) {
+    if (all_paths[i] == '\n') {
+      num_paths++;
+    }
+  }
+
+  calls = calloc(num_paths + 1, sizeof(long));
+  calls_sum = calloc(num_paths + 1, sizeof(long));
+  times = calloc(num_paths + 1, sizeof(dbl));
+  t_min = calloc(num_paths + 1, sizeof(dbl));
+  t_max = calloc(num_paths + 1, sizeof(dbl));
+  t_sum = calloc(num_paths + 1, sizeof(dbl));
+
+  /* this rank's numbers in the order of the union, zero where absent */
+  for (n = 1; n < Prof_Num_Nodes; n++) {
+    char path[PROF_PATH_LEN];
+    char *line = all_paths;
+    prof_path(n, path, PROF_PATH_LEN);
+    for (j = 0; j < num_paths; j++) {
+      char *eol = strchr(line, '\n');
+      if ((size_t)(eol - line) == strlen(path) && strncmp(line, path, eol - line) == 0) {
+        calls[j] = Prof_Nodes[n].calls;
+        times[j] = Prof_Nodes[n].total;
+        break;
+      }
+      line = eol + 1;
+    }
+  }
+
+  MPI_Reduce(times, t_min, num_paths + 1, MPI_DOUBLE, MPI_MIN, 0, MPI_COMM_WORLD);
+  MPI_Reduce(times, t_max, num_paths + 1, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+  MPI_Reduce(times, t_sum, num_paths + 1, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
+  MPI_Reduce(calls, calls_sum, num_paths + 1, MPI_LONG, MPI_SUM, 0, MPI_COMM_WORLD);
+
+  if (ProcID == 0) {
+    char *line = all_paths;
+    fprintf(stdout, "\nRegion profile over %d ranks (seconds)\n", Num_Proc);
+    fprintf(stdout, "%-50s %12s %10s %10s %10s %7s\n", "region", "calls", "min", "avg", "max",
+            "imbal");
+    for (j = 0; j < num_paths; j++) {
+      char *eol = strchr(line, '\n');
+      dbl avg = t_sum[j] / Num_Proc;
+      *eol = '\0';
+      fprintf(stdout, "%-50s %12ld %10.4f %10.4f %10.4f %6.2f\n", line, calls_sum[j], t_min[j],
+              avg, t_max[j], (avg > 0.0) ? t_max[j] / avg : 1.0);
+      line = eol + 1;
+    }
+    fprintf(stdout, "\n");
+  }
+
+  free(paths);
+  free(all_paths);
+  free(lens);
+  free(displs);
+  free(calls);
+  free(calls_sum);
+  free(times);
+  free(t_min);
+  free(t_max);
+  free(t_sum);
+} /* END of routine goma_prof_summary */
+
+/*****************************************************************************/
+
 /* END of file md_timer.c */
 /*****************************************************************************/
@@ -37,6 +37,7 @@
 #include "bc_dirich.h"
 #include "bc_integ.h"
 #include "bc_special.h"
+#include "dp_comm.h"
 #include "dpi.h"
 #include "el_elm.h"
 #include "el_elm_info.h"
@@ -52,16 +53,19 @@
 #include "mm_eh.h"
 #include "mm_fill.h"
 #include "mm_fill_aux.h"
+#include "mm_fill_block.h"
 #include "mm_fill_common.h"
 #include "mm_fill_elliptic_mesh.h"
 #include "mm_fill_em.h"
 #include "mm_fill_fill.h"
+#include "mm_fill_geom_cache.h"
 #include "mm_fill_ls.h"
 #include "mm_fill_population.h"
 #include "mm_fill_porous.h"
 #include "mm_fill_potential.h"
 #include "mm_fill_pthings.h"
 #include "mm_fill_ptrs.h"
+#include "mm_fill_scatter.h"
 #include "mm_fill_rs.h"
 #include "mm_fill_shell.h"
 #include "mm_shell_util.h"
@@ -136,6 +140,79 @@ static void load_lec(Exo_DB *, /* Exodus database pointer */
                      double *); /* element stiffness Matrix for frontal solver*/
 static void zero_lec(void);
 
+/*
+ * Contact angle bookkeeping for matrix_fill(). The arrays track the
+ * connectivity of elements around contact lines over one complete fill.
+ */
+static int CA_id[MAX_CA];     /*  array of CA conditions */
+static int CA_fselem[MAX_CA]; /*  array of CA free surface elements  */
+static int CA_sselem[MAX_CA]; /*  array of CA solid surface elements */
+static int CA_proc[MAX_CA];   /*  Processor which has each CA */
+
+/*
+ * Reset the contact angle arrays at the start of a fill and mark the
+ * conditions whose first node set node is owned by this processor.
+ */
+static void contact_angle_fill_begin(Exo_DB *exo) {
+  int j, nsp, nspk, count = -1;
+
+  memset(CA_fselem, -1, sizeof(int) * MAX_CA);
+  memset(CA_sselem, -1, sizeof(int) * MAX_CA);
+  memset(CA_id, -1, sizeof(int) * MAX_CA);
+  memset(CA_proc, -1, sizeof(int) * MAX_CA);
+  for (j = 0; j < Num_BC; j++) {
+    switch (BC_Types[j].BC_Name) {
+    case CA_BC:
+    case CA_MOMENTUM_BC:
+    case VELO_THETA_HOFFMAN_BC:
+    case VELO_THETA_TPL_BC:
+    case VELO_THETA_COX_BC:
+    case VELO_THETA_SHIK_BC: {
+      nsp = match_nsid(BC_Types[j].BC_ID);
+      if (nsp != -1) {
+        int n_nodes = exo->ns_num_nodes[nsp];
+        if (n_nodes > 0) {
+          nspk = exo->ns_node_list[exo->ns_node_index[nsp]];
+          if (Nodes[nspk]->Proc == ProcID) {
+            count++;
+            CA_proc[count] = ProcID;
+          }
+        }
+      }
+    } break;
+    }
+  }
+
+  /*
+   * Initialize the accumulated CPU time for assembly...
+   */
+  mm_fill_total = 0;
+}
+
+/*
+ * Warn at the end of a complete fill if a contact angle condition owned by
+ * this processor was never applied.
+ */
+static void contact_angle_fill_check(void) {
+  int j, count = 0, Num_CAs_done = 0;
+
+  for (j = 0; j < MAX_CA; j++) {
+    if (CA_id[j] == -2)
+      Num_CAs_done++;
+    if (CA_proc[j] == ProcID)
+      count++;
+  }
+
+  if (count != Num_CAs_done) {
+    GOMA_WH(-1, "\nNot all contact angle conditions were applied!\n");
+    for (j = 0; j < count; j++) {
+      fprintf(stderr, "CA:%d ID:%d fselem:%d sselem:%d Proc:%d\n", j, CA_id[j], CA_fselem[j],
+              CA_sselem[j], CA_proc[j]);
+    }
+    fprintf(stderr, "Count=%d  Done=%d\n", count, Num_CAs_done);
+  }
+}
+
 /*****************************************************************************/
 /*****************************************************************************/
 /*****************************************************************************/
@@ -154,6 +231,46 @@ static void zero_lec(void);
  *   0 : Successful completion.
  *************************************************************************/
 
+/*
+ * Flag the elements that read ghost degrees of freedom, i.e. that have a
+ * node owned by another processor. Elements with friends (shells and the
+ * bulk elements they sit on) load their neighbor's dofs as well, so they
+ * are always flagged. The flags are built on first use and kept until
+ * element_ghost_flags_free() is called for a new mesh.
+ */
+static char *Element_Ghost_Flags = NULL;
+
+static char *element_ghost_flags(Exo_DB *exo, Dpi *dpi) {
+  int e, n, num_owned_nodes;
+
+  if (Element_Ghost_Flags != NULL) {
+    return Element_Ghost_Flags;
+  }
+  Element_Ghost_Flags = (char *)smalloc(MAX(exo->num_elems, 1) * sizeof(char));
+
+  num_owned_nodes = dpi->num_internal_nodes + dpi->num_boundary_nodes;
+  for (e = 0; e < exo->num_elems; e++) {
+    Element_Ghost_Flags[e] = FALSE;
+    if (num_elem_friends != NULL && num_elem_friends[e] > 0) {
+      Element_Ghost_Flags[e] = TRUE;
+      continue;
+    }
+    for (n = exo->elem_node_pntr[e]; n < exo->elem_node_pntr[e + 1]; n++) {
+      if (exo->elem_node_list[n] >= num_owned_nodes) {
+        Element_Ghost_Flags[e] = TRUE;
+        break;
+      }
+    }
+  }
+  return Element_Ghost_Flags;
+}
+
+/*
+ * Release the ghost element flags, e.g. before the problem is set up
+ * again on a new mesh.
+ */
+void element_ghost_flags_free(void) { safer_free((void **)&Element_Ghost_Flags); }
+
 int matrix_fill_full(struct GomaLinearSolverData *ams,
                      double x[],
                      double resid_vector[],
@@ -172,9 +289,12 @@ int matrix_fill_full(struct GomaLinearSolverData *ams,
                      dbl *ptr_h_elem_avg,
                      dbl *ptr_U_norm,
                      dbl *estifm) {
-  int ielem = 0, e_start = 0, e_end = 0, ebn = 0;
+  int ielem = 0, ebn = 0;
   char yo[] = "matrix_fill_full";
-  int err, err_global;
+  int err = 0, err_global;
+  int overlap, pass, num_passes, defer_block;
+  char *ghost_flags = NULL;
+  Element_Block_Context block_ctx;
 
 #define debug_subelement_decomposition 0
 #if debug_subelement_decomposition
@@ -207,55 +327,112 @@ int matrix_fill_full(struct GomaLinearSolverData *ams,
    */
 
   /*
-   * Loop over all of the elements one a time. Obtain their
-   * element contributions to the global matrix
-   *
-   * -> This would be a good spot to loop over each element block instead
-   *    Then allocate memory here for common data elements
+   * Loop over the element blocks and then over the elements of each block
+   * one at a time, obtaining their element contributions to the global
+   * matrix. The block invariant data is gathered once per block into
+   * block_ctx which load_ei and matrix_fill pick up through
+   * Current_Block_Context.
    */
   neg_elem_volume = FALSE;
   neg_lub_height = FALSE;
   zero_detJ = FALSE;
 
-  e_start = exo->eb_ptr[0];
-  e_end = exo->eb_ptr[exo->num_elem_blocks];
+  /*
+   * If the ghost dof exchange of x is still in flight (Overlap Ghost
+   * Exchange), the elements with only owned nodes are assembled in a
+   * first pass and the elements reading ghost dofs, including all those
+   * with shell friends, in a second pass once the exchange has completed.
+   * Level set, phase function and XFEM assembly reach beyond the nodes of
+   * the element, so those complete the exchange up front, as do blocks
+   * with discontinuous interpolations which upwind from neighboring
+   * elements.
+   */
+  overlap = exchange_dof_pending(pg->imtrx);
+  if (overlap && (ls != NULL || pfd != NULL || xfem != NULL)) {
+    exchange_dof_end(pg->imtrx);
+    overlap = FALSE;
+  }
+  if (overlap) {
+    ghost_flags = element_ghost_flags(exo, dpi);
+  }
+  num_passes = overlap ? 2 : 1;
 
-  for (ielem = e_start, ebn = 0; ielem < e_end && !neg_elem_volume && !neg_lub_height && !zero_detJ;
-       ielem++) {
+  /*
+   * The contact angle arrays span the whole fill, whatever order the
+   * passes visit the elements in. The frontal solver keys them on its own
+   * element order inside matrix_fill().
+   */
+  if (exo->ns_node_len > 0 && Linear_Solver != FRONT) {
+    contact_angle_fill_begin(exo);
+  }
 
-    /*First we must calculate the material-referenced element
-     *number so as to be compatible with the ElemStorage struct
-     */
-    ebn = find_elemblock_index(ielem, exo);
-    int mn = Matilda[ebn];
-    if (mn < 0) {
-      continue;
+  GOMA_PROF_BEGIN("matrix_fill");
+  for (pass = 0; pass < num_passes; pass++) {
+    if (pass == 1) {
+      exchange_dof_end(pg->imtrx);
     }
 
-    /*needed for saturation hyst. func. */
-    PRS_mat_ielem = ielem - exo->eb_ptr[ebn];
+    for (ebn = 0; ebn < exo->num_elem_blocks && !err && !neg_elem_volume && !neg_lub_height &&
+                  !zero_detJ;
+         ebn++) {
 
-    err = matrix_fill(ams, x, resid_vector, x_old, x_older, xdot, xdot_old, x_update, ptr_delta_t,
-                      ptr_theta, first_elem_side_BC_array, ptr_time_value, exo, dpi, &ielem,
-                      ptr_num_total_nodes, ptr_h_elem_avg, ptr_U_norm, estifm, 0);
+      /* Blocks without a material are not assembled */
+      if (Matilda[ebn] < 0) {
+        continue;
+      }
 
-    if (err)
-      break;
+      element_block_context_load(&block_ctx, ebn, exo, pg->imtrx);
+      defer_block = overlap && (block_ctx.discontinuous_mass || block_ctx.discontinuous_stress);
+      if (defer_block && pass == 0) {
+        continue;
+      }
+      Current_Block_Context = &block_ctx;
 
-    if (neg_elem_volume) {
-      log_msg("Negative elem det J in element (%d)", ielem + 1);
-      if (ls != NULL && ls->SubElemIntegration)
-        subelement_mesh_output(x, exo);
-    }
+      for (ielem = block_ctx.e_start;
+           ielem < block_ctx.e_end && !neg_elem_volume && !neg_lub_height && !zero_detJ;
+           ielem++) {
 
-    if (neg_lub_height) {
-      log_msg("Negative lubrication height in element (%d)", ielem + 1);
-    }
+        if (overlap && !defer_block && ghost_flags[ielem] != pass) {
+          continue;
+        }
+
+        /*needed for saturation hyst. func. */
+        PRS_mat_ielem = ielem - block_ctx.e_start;
+
+        err = matrix_fill(ams, x, resid_vector, x_old, x_older, xdot, xdot_old, x_update,
+                          ptr_delta_t, ptr_theta, first_elem_side_BC_array, ptr_time_value, exo,
+                          dpi, &ielem, ptr_num_total_nodes, ptr_h_elem_avg, ptr_U_norm, estifm, 0);
+
+        if (err)
+          break;
 
-    if (zero_detJ) {
-      log_msg("Zero determinant of Jacobian of transformation (%d)", ielem + 1);
+        if (neg_elem_volume) {
+          log_msg("Negative elem det J in element (%d)", ielem + 1);
+          if (ls != NULL && ls->SubElemIntegration)
+            subelement_mesh_output(x, exo);
+        }
+
+        if (neg_lub_height) {
+          log_msg("Negative lubrication height in element (%d)", ielem + 1);
+        }
+
+        if (zero_detJ) {
+          log_msg("Zero determinant of Jacobian of transformation (%d)", ielem + 1);
+        }
+      }
+
+      Current_Block_Context = NULL;
     }
   }
+  GOMA_PROF_END("matrix_fill");
+
+  if (Proc_NS_List_Length > 0 && Linear_Solver != FRONT && !err && !neg_elem_volume &&
+      !neg_lub_height && !zero_detJ) {
+    contact_angle_fill_check();
+  }
+
+  /* An error in the first pass skips the second, the exchange still ends */
+  exchange_dof_end(pg->imtrx);
 
   /*
    * Free memory allocated above
@@ -361,11 +538,6 @@ Revised:         Summer 1998, SY Tam (UNM)
 				/* iteration is not recommended*/
 #endif
 
-  static int CA_id[MAX_CA];     /*  array of CA conditions */
-  static int CA_fselem[MAX_CA]; /*  array of CA free surface elements  */
-  static int CA_sselem[MAX_CA]; /*  array of CA solid surface elements */
-  static int CA_proc[MAX_CA];   /*  Processor which has each CA */
-
   int mn;                     /* material block counter */
   int err;                    /* temp variable to hold diagnostic flags.      */
   int ip;                     /* ip is the local quadrature point index       */
@@ -528,41 +700,10 @@ Revised:         Summer 1998, SY Tam (UNM)
    *
    */
 
+  /* matrix_fill_full() resets and checks them around its passes otherwise */
   if (exo->ns_node_len > 0 &&
-      ((zeroCA == 1) || ((Linear_Solver != FRONT && ielem == exo->eb_ptr[0]) ||
-                         (Linear_Solver == FRONT && ielem == exo->elem_order_map[0] - 1)))) {
-    int nsp, nspk, count = -1;
-    memset(CA_fselem, -1, sizeof(int) * MAX_CA);
-    memset(CA_sselem, -1, sizeof(int) * MAX_CA);
-    memset(CA_id, -1, sizeof(int) * MAX_CA);
-    memset(CA_proc, -1, sizeof(int) * MAX_CA);
-    for (j = 0; j < Num_BC; j++) {
-      switch (BC_Types[j].BC_Name) {
-      case CA_BC:
-      case CA_MOMENTUM_BC:
-      case VELO_THETA_HOFFMAN_BC:
-      case VELO_THETA_TPL_BC:
-      case VELO_THETA_COX_BC:
-      case VELO_THETA_SHIK_BC: {
-        nsp = match_nsid(BC_Types[j].BC_ID);
-        if (nsp != -1) {
-          int n_nodes = exo->ns_num_nodes[nsp];
-          if (n_nodes > 0) {
-            nspk = exo->ns_node_list[exo->ns_node_index[nsp]];
-            if (Nodes[nspk]->Proc == ProcID) {
-              count++;
-              CA_proc[count] = ProcID;
-            }
-          }
-        }
-      } break;
-      }
-    }
-
-    /*
-     * Initialize the accumulated CPU time for assembly...
-     */
-    mm_fill_total = 0;
+      ((zeroCA == 1) || (Linear_Solver == FRONT && ielem == exo->elem_order_map[0] - 1))) {
+    contact_angle_fill_begin(exo);
   }
 
   /*
@@ -593,56 +734,19 @@ Revised:         Summer 1998, SY Tam (UNM)
     ve[mode] = ve_glob[mn][mode];
   }
 
-  /* discontinuous Galerkin information */
-  /* element type, assumed to be globally consistent for now */
-
-  /* need to take this section out and up above.  Inefficient now as it assumes
-     every element is different */
-
-  discontinuous_mass = 0;
+  /* discontinuous Galerkin information, set once per element block when
+     called from the block loop of matrix_fill_full */
 
-  if (pd->i[pg->imtrx][MASS_FRACTION] == I_P1) {
-    if (pd->Num_Dim == 2)
-      ielem_type_mass = P1_QUAD;
-    if (pd->Num_Dim == 3)
-      ielem_type_mass = P1_HEX;
-    discontinuous_mass = 1;
-  } else if (pd->i[pg->imtrx][MASS_FRACTION] == I_P0) {
-    if (pd->Num_Dim == 2)
-      ielem_type_mass = P0_QUAD;
-    if (pd->Num_Dim == 3)
-      ielem_type_mass = P0_HEX;
-    discontinuous_mass = 1;
-  } else if (pd->i[pg->imtrx][MASS_FRACTION] == I_PQ1) {
-    if (pd->Num_Dim == 2)
-      ielem_type_mass = BILINEAR_QUAD;
-    if (pd->Num_Dim == 3)
-      GOMA_EH(GOMA_ERROR, "Sorry PQ1 interpolation has not been implemented in 3D yet.");
-    discontinuous_mass = 1;
-  } else if (pd->i[pg->imtrx][MASS_FRACTION] == I_PQ2) {
-    if (pd->Num_Dim == 2)
-      ielem_type_mass = BIQUAD_QUAD;
-    if (pd->Num_Dim == 3)
-      GOMA_EH(GOMA_ERROR, "Sorry PQ2 interpolation has not been implemented in 3D yet.");
-    discontinuous_mass = 1;
+  if (BLOCK_CONTEXT_HAS_ELEM(ielem) && Current_Block_Context->imtrx == pg->imtrx) {
+    discontinuous_mass = Current_Block_Context->discontinuous_mass;
+    ielem_type_mass = Current_Block_Context->ielem_type_mass;
+    discontinuous_stress = Current_Block_Context->discontinuous_stress;
   } else {
-    ielem_type_mass = ielem_type;
+    element_block_dg_types(pd, pg->imtrx, &discontinuous_mass, &ielem_type_mass,
+                           &discontinuous_stress);
   }
-
-  discontinuous_stress = 0;
-
-  if (pd->i[pg->imtrx][POLYMER_STRESS11] == I_P1) {
-    discontinuous_stress = 1;
-  } else if (pd->i[pg->imtrx][POLYMER_STRESS11] == I_P0) {
-    discontinuous_stress = 1;
-  } else if (pd->i[pg->imtrx][POLYMER_STRESS11] == I_PQ1) {
-    if (pd->Num_Dim == 3)
-      GOMA_EH(GOMA_ERROR, "Sorry PQ1 interpolation has not been implemented in 3D yet.");
-    discontinuous_stress = 1;
-  } else if (pd->i[pg->imtrx][POLYMER_STRESS11] == I_PQ2) {
-    if (pd->Num_Dim == 3)
-      GOMA_EH(GOMA_ERROR, "Sorry PQ2 interpolation has not been implemented in 3D yet.");
-    discontinuous_stress = 1;
+  if (!discontinuous_mass) {
+    ielem_type_mass = ielem_type;
   }
 
   ielem_type = ei[pg->imtrx]->ielem_type; /* element type */
@@ -1027,7 +1131,8 @@ Revised:         Summer 1998, SY Tam (UNM)
   /*          INITIALIZATION THAT IS DEPENDENT ON THE QUADRATURE POINT VALUE    */
   /******************************************************************************/
 
-  ip_total = elem_info(NQUAD, ielem_type);
+  ip_total = BLOCK_CONTEXT_HAS_ELEM(ielem) ? Current_Block_Context->ip_total
+                                           : elem_info(NQUAD, ielem_type);
 
   /* Loop over all the Volume Quadrature integration points */
 
@@ -1081,7 +1186,7 @@ Revised:         Summer 1998, SY Tam (UNM)
        * That is done in load_fv.
        */
 
-      err = beer_belly();
+      err = geometry_cache_beer_belly(ielem, ip, exo);
       GOMA_EH(err, "beer_belly");
       if (neg_elem_volume)
         return -1;
@@ -1116,10 +1221,11 @@ Revised:         Summer 1998, SY Tam (UNM)
        * basis functions with respect to physical space coordinates.
        *
        * Only call this high computational intensity tensor workout if
-       * we really need this information...
+       * we really need this information, never for a residual-only fill
+       * (af->Assemble_Jacobian FALSE)
        */
 
-      if (pd->gv[R_MESH1]) {
+      if (af->Assemble_Jacobian && pd->gv[R_MESH1]) {
         err = load_bf_mesh_derivs();
         GOMA_EH(err, "load_bf_mesh_derivs");
       }
@@ -1139,7 +1245,7 @@ Revised:         Summer 1998, SY Tam (UNM)
 #endif
       }
 
-      if (pd->gv[R_MESH1]) {
+      if (af->Assemble_Jacobian && pd->gv[R_MESH1]) {
         err = load_fv_mesh_derivs(1);
         GOMA_EH(err, "load_fv_mesh_derivs");
       }
@@ -1351,9 +1457,11 @@ Revised:         Summer 1998, SY Tam (UNM)
      * "raw", in the sense that they do not yet include the
      * scale factors necessary to make them into *gradients*.
      * That is done in load_fv.
+     *
+     * Only regular Gauss points (case 1) may come from the geometry cache.
      */
 
-    err = beer_belly();
+    err = geometry_cache_beer_belly(ielem, (ls == NULL || !ls->elem_overlap_state) ? ip : -1, exo);
     GOMA_EH(err, "beer_belly");
     if (neg_elem_volume)
       return -1;
@@ -1388,10 +1496,11 @@ Revised:         Summer 1998, SY Tam (UNM)
      * basis functions with respect to physical space coordinates.
      *
      * Only call this high computational intensity tensor workout if
-     * we really need this information...
+     * we really need this information, never for a residual-only fill
+     * (af->Assemble_Jacobian FALSE)
      */
 
-    if (pd->gv[R_MESH1]) {
+    if (af->Assemble_Jacobian && pd->gv[R_MESH1]) {
       err = load_bf_mesh_derivs();
       GOMA_EH(err, "load_bf_mesh_derivs");
     }
@@ -1410,7 +1519,7 @@ Revised:         Summer 1998, SY Tam (UNM)
       GOMA_EH(GOMA_ERROR, "AutoDiff assembly enabled but Goma not compiled with Sacado support");
 #endif
     }
-    if (pd->gv[R_MESH1]) {
+    if (af->Assemble_Jacobian && pd->gv[R_MESH1]) {
       err = load_fv_mesh_derivs(1);
       GOMA_EH(err, "load_fv_mesh_derivs");
     }
@@ -1469,7 +1578,9 @@ Revised:         Summer 1998, SY Tam (UNM)
     do_LSA_mods(LSA_VOLUME);
 
     if (vn->evssModel == EVSS_G && cr->MeshFluxModel == ZENER_SLS) {
+      GOMA_PROF_BEGIN("assemble_stress_vesolid");
       err = assemble_stress_vesolid(theta, delta_t, ielem, ip, ip_total);
+      GOMA_PROF_END("assemble_stress_vesolid");
       GOMA_EH(err, "assemble_stress_vesolid");
 #ifdef CHECK_FINITE
       err = CHECKFINITE("assemble_stress_vesolid");
@@ -1477,7 +1588,9 @@ Revised:         Summer 1998, SY Tam (UNM)
         return -1;
 #endif
     } else if (vn->evssModel == EVSS_F || vn->evssModel == EVSS_GRADV) {
+      GOMA_PROF_BEGIN("assemble_stress_fortin");
       err = assemble_stress_fortin(theta, delta_t, &pg_data);
+      GOMA_PROF_END("assemble_stress_fortin");
       err = segregate_stress_update(x_update);
       GOMA_EH(err, "assemble_stress_fortin");
 #ifdef CHECK_FINITE
@@ -1486,8 +1599,10 @@ Revised:         Summer 1998, SY Tam (UNM)
         return -1;
 #endif
     } else if (vn->evssModel == EVSS_G) {
+      GOMA_PROF_BEGIN("assemble_stress");
       err = assemble_stress(theta, delta_t, pg_data.hsquared, pg_data.hhv, pg_data.dhv_dxnode,
                             pg_data.v_avg, pg_data.dv_dnode);
+      GOMA_PROF_END("assemble_stress");
       GOMA_EH(err, "assemble_stress");
 #ifdef CHECK_FINITE
       err = CHECKFINITE("assemble_stress");
@@ -1495,8 +1610,10 @@ Revised:         Summer 1998, SY Tam (UNM)
         return -1;
 #endif
     } else if (vn->evssModel == EVSS_L) {
+      GOMA_PROF_BEGIN("assemble_stress_level_set");
       err = assemble_stress_level_set(theta, delta_t, pg_data.hsquared, pg_data.hhv,
                                       pg_data.dhv_dxnode, pg_data.v_avg, pg_data.dv_dnode);
+      GOMA_PROF_END("assemble_stress_level_set");
       GOMA_EH(err, "assemble_stress_level_set");
 #ifdef CHECK_FINITE
       err = CHECKFINITE("assemble_stress_level_set");
@@ -1504,7 +1621,9 @@ Revised:         Summer 1998, SY Tam (UNM)
         return -1;
 #endif
     } else if (vn->evssModel == LOG_CONF || vn->evssModel == LOG_CONF_GRADV) {
+      GOMA_PROF_BEGIN("assemble_stress_log_conf");
       err = assemble_stress_log_conf(theta, delta_t, &pg_data);
+      GOMA_PROF_END("assemble_stress_log_conf");
 
       GOMA_EH(err, "assemble_stress_log_conf");
       if (err)
@@ -1517,7 +1636,9 @@ Revised:         Summer 1998, SY Tam (UNM)
         return -1;
 #endif
     } else if (vn->evssModel == SQRT_CONF) {
+      GOMA_PROF_BEGIN("assemble_stress_sqrt_conf");
       err = assemble_stress_sqrt_conf(theta, delta_t, &pg_data);
+      GOMA_PROF_END("assemble_stress_sqrt_conf");
       // err = ad_assemble_stress_sqrt_conf(theta, delta_t, &pg_data);
 
       GOMA_EH(err, "assemble_stress_sqrt_conf");
@@ -1531,7 +1652,9 @@ Revised:         Summer 1998, SY Tam (UNM)
         return -1;
 #endif
     } else if (vn->evssModel == CONF) {
+      GOMA_PROF_BEGIN("assemble_stress_conf");
       err = assemble_stress_conf(theta, delta_t, &pg_data);
+      GOMA_PROF_END("assemble_stress_conf");
 
       GOMA_EH(err, "assemble_stress_conf");
       if (err)
@@ -1544,7 +1667,9 @@ Revised:         Summer 1998, SY Tam (UNM)
         return -1;
 #endif
     } else if (vn->evssModel == LOG_CONF_TRANSIENT || vn->evssModel == LOG_CONF_TRANSIENT_GRADV) {
+      GOMA_PROF_BEGIN("assemble_stress_log_conf_transient");
       err = assemble_stress_log_conf_transient(theta, delta_t, &pg_data);
+      GOMA_PROF_END("assemble_stress_log_conf_transient");
 
       GOMA_EH(err, "assemble_stress_log_conf");
       if (err)
@@ -1559,7 +1684,9 @@ Revised:         Summer 1998, SY Tam (UNM)
     }
 
     if (pde[R_SHEAR_RATE] && pd->gv[R_TURB_OMEGA]) {
+      GOMA_PROF_BEGIN("ad_assemble_invariant");
       err = ad_assemble_invariant(theta, delta_t);
+      GOMA_PROF_END("ad_assemble_invariant");
 
       GOMA_EH(err, "assemble_invariant");
 #ifdef CHECK_FINITE
@@ -1568,7 +1695,9 @@ Revised:         Summer 1998, SY Tam (UNM)
         return -1;
 #endif
     } else if (pde[R_SHEAR_RATE]) {
+      GOMA_PROF_BEGIN("assemble_invariant");
       err = assemble_invariant(theta, delta_t);
+      GOMA_PROF_END("assemble_invariant");
 
       GOMA_EH(err, "assemble_invariant");
 #ifdef CHECK_FINITE
@@ -1579,7 +1708,9 @@ Revised:         Summer 1998, SY Tam (UNM)
     }
 
     if (pde[R_ENORM]) {
+      GOMA_PROF_BEGIN("assemble_Enorm");
       err = assemble_Enorm();
+      GOMA_PROF_END("assemble_Enorm");
       GOMA_EH(err, "assemble_Enorm");
 #ifdef CHECK_FINITE
       err = CHECKFINITE("assemble_Enorm");
@@ -1590,9 +1721,13 @@ Revised:         Summer 1998, SY Tam (UNM)
 
     if (pde[R_GRADIENT11]) {
       if (gn->ConstitutiveEquation == BINGHAM_MIXED) {
+        GOMA_PROF_BEGIN("assemble_rate_of_strain");
         err = assemble_rate_of_strain(theta, delta_t);
+        GOMA_PROF_END("assemble_rate_of_strain");
       } else {
+        GOMA_PROF_BEGIN("assemble_gradient");
         err = assemble_gradient(theta, delta_t);
+        GOMA_PROF_END("assemble_gradient");
       }
       GOMA_EH(err, "assemble_gradient");
 #ifdef CHECK_FINITE
@@ -1603,7 +1738,9 @@ Revised:         Summer 1998, SY Tam (UNM)
     }
 
     if (pde[R_MESH1] && cr->MeshFluxModel == ELLIPTIC) {
+      GOMA_PROF_BEGIN("assemble_elliptic_mesh");
       err = assemble_elliptic_mesh();
+      GOMA_PROF_END("assemble_elliptic_mesh");
       GOMA_EH(err, "assemble_elliptic_mesh");
 #ifdef CHECK_FINITE
       err = CHECKFINITE("assemble_elliptic_mesh");
@@ -1613,7 +1750,9 @@ Revised:         Summer 1998, SY Tam (UNM)
       if (neg_elem_volume)
         return -1;
     } else if (pde[R_MESH1] && !pde[R_SHELL_CURVATURE] && !pde[R_SHELL_TENSION]) {
+      GOMA_PROF_BEGIN("assemble_mesh");
       err = assemble_mesh(time_value, theta, delta_t, ielem, ip, ip_total);
+      GOMA_PROF_END("assemble_mesh");
       GOMA_EH(err, "assemble_mesh");
 #ifdef CHECK_FINITE
       err = CHECKFINITE("assemble_mesh");
@@ -1659,9 +1798,13 @@ Revised:         Summer 1998, SY Tam (UNM)
 
     if (pde[R_MASS]) {
       if (pd->MassFluxModel == FICKIAN_SHELL) {
+        GOMA_PROF_BEGIN("assemble_shell_species");
         err = assemble_shell_species(time_value, theta, delta_t, xi, &pg_data, exo);
+        GOMA_PROF_END("assemble_shell_species");
       } else {
+        GOMA_PROF_BEGIN("assemble_mass_transport");
         err = assemble_mass_transport(time_value, theta, delta_t, &pg_data);
+        GOMA_PROF_END("assemble_mass_transport");
         GOMA_EH(err, "assemble_mass_transport");
 #ifdef CHECK_FINITE
         err = CHECKFINITE("assemble_mass_transport");
@@ -1674,7 +1817,9 @@ Revised:         Summer 1998, SY Tam (UNM)
     }
 
     if (pde[R_POR_LIQ_PRES] || pde[R_POR_SATURATION]) {
+      GOMA_PROF_BEGIN("assemble_porous_transport");
       err = assemble_porous_transport(time_value, theta, delta_t);
+      GOMA_PROF_END("assemble_porous_transport");
       GOMA_EH(err, "assemble_porous");
 #ifdef CHECK_FINITE
       err = CHECKFINITE("assemble_porous");
@@ -1686,7 +1831,9 @@ Revised:         Summer 1998, SY Tam (UNM)
     }
 
     if (pde[R_SOLID1] && assemble_rs) {
+      GOMA_PROF_BEGIN("assemble_real_solid");
       err = assemble_real_solid(time_value, theta, delta_t);
+      GOMA_PROF_END("assemble_real_solid");
       GOMA_EH(err, "assemble_mesh");
 #ifdef CHECK_FINITE
       err = CHECKFINITE("assemble_mesh");
@@ -1696,7 +1843,9 @@ Revised:         Summer 1998, SY Tam (UNM)
     }
 
     if (pde[R_ENERGY]) {
+      GOMA_PROF_BEGIN("assemble_energy");
       err = assemble_energy(time_value, theta, delta_t, &pg_data);
+      GOMA_PROF_END("assemble_energy");
       GOMA_EH(err, "assemble_energy");
 #ifdef CHECK_FINITE
       err = CHECKFINITE("assemble_energy");
@@ -1706,7 +1855,9 @@ Revised:         Summer 1998, SY Tam (UNM)
     }
 
     if (pde[R_POTENTIAL]) {
+      GOMA_PROF_BEGIN("assemble_potential");
       err = assemble_potential(time_value, theta, delta_t);
+      GOMA_PROF_END("assemble_potential");
       GOMA_EH(err, "assemble_potential");
 #ifdef CHECK_FINITE
       err = CHECKFINITE("assemble_potential");
@@ -1716,7 +1867,9 @@ Revised:         Summer 1998, SY Tam (UNM)
     }
 
     if (pde[R_ACOUS_PREAL]) {
+      GOMA_PROF_BEGIN("assemble_acoustic");
       err = assemble_acoustic(time_value, theta, delta_t, &pg_data, R_ACOUS_PREAL, ACOUS_PREAL);
+      GOMA_PROF_END("assemble_acoustic");
       GOMA_EH(err, "assemble_acoustic");
 #ifdef CHECK_FINITE
       err = CHECKFINITE("assemble_acoustic");
@@ -1726,7 +1879,9 @@ Revised:         Summer 1998, SY Tam (UNM)
     }
 
     if (pde[R_ACOUS_PIMAG]) {
+      GOMA_PROF_BEGIN("assemble_acoustic");
       err = assemble_acoustic(time_value, theta, delta_t, &pg_data, R_ACOUS_PIMAG, ACOUS_PIMAG);
+      GOMA_PROF_END("assemble_acoustic");
       GOMA_EH(err, "assemble_acoustic");
 #ifdef CHECK_FINITE
       err = CHECKFINITE("assemble_acoustic");
@@ -1736,7 +1891,9 @@ Revised:         Summer 1998, SY Tam (UNM)
     }
 
     if (pde[R_ACOUS_REYN_STRESS]) {
+      GOMA_PROF_BEGIN("assemble_acoustic_reynolds_stress");
       err = assemble_acoustic_reynolds_stress(time_value, theta, delta_t, &pg_data);
+      GOMA_PROF_END("assemble_acoustic_reynolds_stress");
       GOMA_EH(err, "assemble_acoustic_reynolds_stress");
 #ifdef CHECK_FINITE
       err = CHECKFINITE("assemble_acoustic_reynolds_stress");
@@ -1746,7 +1903,9 @@ Revised:         Summer 1998, SY Tam (UNM)
     }
 
     if (pde[R_LIGHT_INTP]) {
+      GOMA_PROF_BEGIN("assemble_poynting");
       err = assemble_poynting(time_value, theta, delta_t, &pg_data, R_LIGHT_INTP, LIGHT_INTP);
+      GOMA_PROF_END("assemble_poynting");
       GOMA_EH(err, "assemble_poynting");
 #ifdef CHECK_FINITE
       err = CHECKFINITE("assemble_poynting");
@@ -1756,7 +1915,9 @@ Revised:         Summer 1998, SY Tam (UNM)
     }
 
     if (pde[R_LIGHT_INTM]) {
+      GOMA_PROF_BEGIN("assemble_poynting");
       err = assemble_poynting(time_value, theta, delta_t, &pg_data, R_LIGHT_INTM, LIGHT_INTM);
+      GOMA_PROF_END("assemble_poynting");
       GOMA_EH(err, "assemble_poynting");
 #ifdef CHECK_FINITE
       err = CHECKFINITE("assemble_poynting");
@@ -1766,7 +1927,9 @@ Revised:         Summer 1998, SY Tam (UNM)
     }
 
     if (pde[R_LIGHT_INTD]) {
+      GOMA_PROF_BEGIN("assemble_poynting");
       err = assemble_poynting(time_value, theta, delta_t, &pg_data, R_LIGHT_INTD, LIGHT_INTD);
+      GOMA_PROF_END("assemble_poynting");
       GOMA_EH(err, "assemble_poynting");
 #ifdef CHECK_FINITE
       err = CHECKFINITE("assemble_poynting");
@@ -1776,7 +1939,9 @@ Revised:         Summer 1998, SY Tam (UNM)
     }
 
     if (pde[R_RESTIME]) {
+      GOMA_PROF_BEGIN("assemble_poynting");
       err = assemble_poynting(time_value, theta, delta_t, &pg_data, R_RESTIME, RESTIME);
+      GOMA_PROF_END("assemble_poynting");
       GOMA_EH(err, "assemble_poynting");
 #ifdef CHECK_FINITE
       err = CHECKFINITE("assemble_poynting");
@@ -1787,7 +1952,9 @@ Revised:         Summer 1998, SY Tam (UNM)
     if (((pde[R_EM_E1_REAL] && !pde[R_EM_H1_REAL]) || (pde[R_EM_E2_REAL] && !pde[R_EM_H2_REAL]) ||
          (pde[R_EM_E3_REAL] && !pde[R_EM_H3_REAL])) &&
         bf[EM_E1_REAL]->interpolation != I_N1) {
+      GOMA_PROF_BEGIN("assemble_ewave_curlcurl");
       err = assemble_ewave_curlcurl(time_value, theta, delta_t, R_EM_E1_REAL, EM_E1_REAL);
+      GOMA_PROF_END("assemble_ewave_curlcurl");
       GOMA_EH(err, "assemble_ewave");
 #ifdef CHECK_FINITE
       err = CHECKFINITE("assemble_ewave");
@@ -1795,7 +1962,9 @@ Revised:         Summer 1998, SY Tam (UNM)
         return -1;
 #endif
     } else if (pde[R_EM_E1_REAL] && bf[EM_E1_REAL]->interpolation == I_N1) {
+      GOMA_PROF_BEGIN("assemble_ewave_nedelec");
       err = assemble_ewave_nedelec(time_value);
+      GOMA_PROF_END("assemble_ewave_nedelec");
       GOMA_EH(err, "assemble_ewave_nedelec");
 #ifdef CHECK_FINITE
       err = CHECKFINITE("assemble_emwave");
@@ -1803,8 +1972,10 @@ Revised:         Summer 1998, SY Tam (UNM)
         return -1;
 #endif
     } else if (pde[R_EM_E1_REAL]) {
+      GOMA_PROF_BEGIN("assemble_emwave");
       err = assemble_emwave(time_value, theta, delta_t, &pg_data, R_EM_E1_REAL, EM_E1_REAL,
                             EM_E1_IMAG);
+      GOMA_PROF_END("assemble_emwave");
       GOMA_EH(err, "assemble_emwave");
 #ifdef CHECK_FINITE
       err = CHECKFINITE("assemble_emwave");
@@ -1814,7 +1985,9 @@ Revised:         Summer 1998, SY Tam (UNM)
     }
 #if 0
     if (pde[R_EM_CONT_REAL]) {
+      GOMA_PROF_BEGIN("assemble_em_continuity");
       err = assemble_em_continuity();
+      GOMA_PROF_END("assemble_em_continuity");
       GOMA_EH(err, "assemble_em_continuity");
 #ifdef CHECK_FINITE
       err = CHECKFINITE("assemble_em_continuity");
@@ -1834,8 +2007,10 @@ Revised:         Summer 1998, SY Tam (UNM)
       //        if (err) return -1;
       // #endif
     } else if (pde[R_EM_E2_REAL]) {
+      GOMA_PROF_BEGIN("assemble_emwave");
       err = assemble_emwave(time_value, theta, delta_t, &pg_data, R_EM_E2_REAL, EM_E2_REAL,
                             EM_E2_IMAG);
+      GOMA_PROF_END("assemble_emwave");
       GOMA_EH(err, "assemble_emwave");
 #ifdef CHECK_FINITE
       err = CHECKFINITE("assemble_emwave");
@@ -1853,8 +2028,10 @@ Revised:         Summer 1998, SY Tam (UNM)
       //        if (err) return -1;
       // #endif
     } else if (pde[R_EM_E3_REAL]) {
+      GOMA_PROF_BEGIN("assemble_emwave");
       err = assemble_emwave(time_value, theta, delta_t, &pg_data, R_EM_E3_REAL, EM_E3_REAL,
                             EM_E3_IMAG);
+      GOMA_PROF_END("assemble_emwave");
       GOMA_EH(err, "assemble_emwave");
 #ifdef CHECK_FINITE
       err = CHECKFINITE("assemble_emwave");
@@ -1872,8 +2049,10 @@ Revised:         Summer 1998, SY Tam (UNM)
       //        if (err) return -1;
       // #endif
     } else if (pde[R_EM_E1_IMAG]) {
+      GOMA_PROF_BEGIN("assemble_emwave");
       err = assemble_emwave(time_value, theta, delta_t, &pg_data, R_EM_E1_IMAG, EM_E1_IMAG,
                             EM_E1_REAL);
+      GOMA_PROF_END("assemble_emwave");
       GOMA_EH(err, "assemble_emwave");
 #ifdef CHECK_FINITE
       err = CHECKFINITE("assemble_emwave");
@@ -1891,8 +2070,10 @@ Revised:         Summer 1998, SY Tam (UNM)
       //        if (err) return -1;
       // #endif
     } else if (pde[R_EM_E2_IMAG]) {
+      GOMA_PROF_BEGIN("assemble_emwave");
       err = assemble_emwave(time_value, theta, delta_t, &pg_data, R_EM_E2_IMAG, EM_E2_IMAG,
                             EM_E2_REAL);
+      GOMA_PROF_END("assemble_emwave");
       GOMA_EH(err, "assemble_emwave");
 #ifdef CHECK_FINITE
       err = CHECKFINITE("assemble_emwave");
@@ -1910,8 +2091,10 @@ Revised:         Summer 1998, SY Tam (UNM)
       //        if (err) return -1;
       // #endif
     } else if (pde[R_EM_E3_IMAG]) {
+      GOMA_PROF_BEGIN("assemble_emwave");
       err = assemble_emwave(time_value, theta, delta_t, &pg_data, R_EM_E3_IMAG, EM_E3_IMAG,
                             EM_E3_REAL);
+      GOMA_PROF_END("assemble_emwave");
       GOMA_EH(err, "assemble_emwave");
 #ifdef CHECK_FINITE
       err = CHECKFINITE("assemble_emwave");
@@ -1921,8 +2104,10 @@ Revised:         Summer 1998, SY Tam (UNM)
     }
 
     if (pde[R_EM_H1_REAL]) {
+      GOMA_PROF_BEGIN("assemble_emwave");
       err = assemble_emwave(time_value, theta, delta_t, &pg_data, R_EM_H1_REAL, EM_H1_REAL,
                             EM_H1_IMAG);
+      GOMA_PROF_END("assemble_emwave");
       GOMA_EH(err, "assemble_emwave");
 #ifdef CHECK_FINITE
       err = CHECKFINITE("assemble_emwave");
@@ -1932,8 +2117,10 @@ Revised:         Summer 1998, SY Tam (UNM)
     }
 
     if (pde[R_EM_H2_REAL]) {
+      GOMA_PROF_BEGIN("assemble_emwave");
       err = assemble_emwave(time_value, theta, delta_t, &pg_data, R_EM_H2_REAL, EM_H2_REAL,
                             EM_H2_IMAG);
+      GOMA_PROF_END("assemble_emwave");
       GOMA_EH(err, "assemble_emwave");
 #ifdef CHECK_FINITE
       err = CHECKFINITE("assemble_emwave");
@@ -1943,8 +2130,10 @@ Revised:         Summer 1998, SY Tam (UNM)
     }
 
     if (pde[R_EM_H3_REAL]) {
+      GOMA_PROF_BEGIN("assemble_emwave");
       err = assemble_emwave(time_value, theta, delta_t, &pg_data, R_EM_H3_REAL, EM_H3_REAL,
                             EM_H3_IMAG);
+      GOMA_PROF_END("assemble_emwave");
       GOMA_EH(err, "assemble_emwave");
 #ifdef CHECK_FINITE
       err = CHECKFINITE("assemble_emwave");
@@ -1954,8 +2143,10 @@ Revised:         Summer 1998, SY Tam (UNM)
     }
 
     if (pde[R_EM_H1_IMAG]) {
+      GOMA_PROF_BEGIN("assemble_emwave");
       err = assemble_emwave(time_value, theta, delta_t, &pg_data, R_EM_H1_IMAG, EM_H1_IMAG,
                             EM_H1_REAL);
+      GOMA_PROF_END("assemble_emwave");
       GOMA_EH(err, "assemble_emwave");
 #ifdef CHECK_FINITE
       err = CHECKFINITE("assemble_emwave");
@@ -1965,8 +2156,10 @@ Revised:         Summer 1998, SY Tam (UNM)
     }
 
     if (pde[R_EM_H2_IMAG]) {
+      GOMA_PROF_BEGIN("assemble_emwave");
       err = assemble_emwave(time_value, theta, delta_t, &pg_data, R_EM_H2_IMAG, EM_H2_IMAG,
                             EM_H2_REAL);
+      GOMA_PROF_END("assemble_emwave");
       GOMA_EH(err, "assemble_emwave");
 #ifdef CHECK_FINITE
       err = CHECKFINITE("assemble_emwave");
@@ -1976,8 +2169,10 @@ Revised:         Summer 1998, SY Tam (UNM)
     }
 
     if (pde[R_EM_H3_IMAG]) {
+      GOMA_PROF_BEGIN("assemble_emwave");
       err = assemble_emwave(time_value, theta, delta_t, &pg_data, R_EM_H3_IMAG, EM_H3_IMAG,
                             EM_H3_REAL);
+      GOMA_PROF_END("assemble_emwave");
       GOMA_EH(err, "assemble_emwave");
 #ifdef CHECK_FINITE
       err = CHECKFINITE("assemble_emwave");
@@ -1987,7 +2182,9 @@ Revised:         Summer 1998, SY Tam (UNM)
     }
 #endif
     if (pde[R_POR_SINK_MASS]) {
+      GOMA_PROF_BEGIN("assemble_pore_sink_mass");
       err = assemble_pore_sink_mass(time_value, theta, delta_t);
+      GOMA_PROF_END("assemble_pore_sink_mass");
       GOMA_EH(err, "assemble_pore_sink_mass");
 #ifdef CHECK_FINITE
       err = CHECKFINITE("assemble_pore_sink_mass");
@@ -1997,7 +2194,9 @@ Revised:         Summer 1998, SY Tam (UNM)
     }
 
     if (pde[R_EFIELD1]) {
+      GOMA_PROF_BEGIN("assemble_electric_field");
       err = assemble_electric_field();
+      GOMA_PROF_END("assemble_electric_field");
       GOMA_EH(err, "assemble_electric_field");
 #ifdef CHECK_FINITE
       err = CHECKFINITE("assemble_electric_field");
@@ -2007,7 +2206,9 @@ Revised:         Summer 1998, SY Tam (UNM)
     }
 
     if (pde[R_SURF_CHARGE]) {
+      GOMA_PROF_BEGIN("assemble_surface_charge");
       err = assemble_surface_charge(time_value, theta, delta_t, wt, xi, exo, R_SURF_CHARGE);
+      GOMA_PROF_END("assemble_surface_charge");
       GOMA_EH(err, "assemble_surface_charge");
 #ifdef CHECK_FINITE
       err = CHECKFINITE("assemble_surface_charge");
@@ -2017,7 +2218,9 @@ Revised:         Summer 1998, SY Tam (UNM)
     }
 
     if (pde[R_SHELL_USER]) {
+      GOMA_PROF_BEGIN("assemble_surface_charge");
       err = assemble_surface_charge(time_value, theta, delta_t, wt, xi, exo, R_SHELL_USER);
+      GOMA_PROF_END("assemble_surface_charge");
       GOMA_EH(err, "assemble_surface_charge");
 #ifdef CHECK_FINITE
       err = CHECKFINITE("assemble_surface_charge");
@@ -2027,7 +2230,9 @@ Revised:         Summer 1998, SY Tam (UNM)
     }
 
     if (pde[R_SHELL_BDYVELO]) {
+      GOMA_PROF_BEGIN("assemble_surface_charge");
       err = assemble_surface_charge(time_value, theta, delta_t, wt, xi, exo, R_SHELL_BDYVELO);
+      GOMA_PROF_END("assemble_surface_charge");
       GOMA_EH(err, "assemble_surface_charge");
 #ifdef CHECK_FINITE
       err = CHECKFINITE("assemble_surface_charge");
@@ -2041,7 +2246,9 @@ Revised:         Summer 1998, SY Tam (UNM)
     }
 
     if (pde[R_LUBP]) {
+      GOMA_PROF_BEGIN("assemble_lubrication");
       err = assemble_lubrication(R_LUBP, time_value, theta, delta_t, xi, exo);
+      GOMA_PROF_END("assemble_lubrication");
       GOMA_EH(err, "assemble_lubrication");
 #ifdef CHECK_FINITE
       err = CHECKFINITE("assemble_lubrication");
@@ -2053,7 +2260,9 @@ Revised:         Summer 1998, SY Tam (UNM)
     }
 
     if (pde[R_LUBP_2]) {
+      GOMA_PROF_BEGIN("assemble_lubrication");
       err = assemble_lubrication(R_LUBP_2, time_value, theta, delta_t, xi, exo);
+      GOMA_PROF_END("assemble_lubrication");
       GOMA_EH(err, "assemble_lubrication");
 #ifdef CHECK_FINITE
       err = CHECKFINITE("assemble_lubrication");
@@ -2065,7 +2274,9 @@ Revised:         Summer 1998, SY Tam (UNM)
     }
 
     if (pde[R_MAX_STRAIN]) {
+      GOMA_PROF_BEGIN("assemble_max_strain");
       err = assemble_max_strain();
+      GOMA_PROF_END("assemble_max_strain");
       GOMA_EH(err, "assemble_max_strain");
 #ifdef CHECK_FINITE
       err = CHECKFINITE("assemble_max_strain");
@@ -2075,7 +2286,9 @@ Revised:         Summer 1998, SY Tam (UNM)
     }
 
     if (pde[R_CUR_STRAIN]) {
+      GOMA_PROF_BEGIN("assemble_cur_strain");
       err = assemble_cur_strain();
+      GOMA_PROF_END("assemble_cur_strain");
       GOMA_EH(err, "assemble_cur_strain");
 #ifdef CHECK_FINITE
       err = CHECKFINITE("assemble_cur_strain");
@@ -2085,7 +2298,9 @@ Revised:         Summer 1998, SY Tam (UNM)
     }
 
     if (pde[R_SHELL_LUB_CURV]) {
+      GOMA_PROF_BEGIN("assemble_lubrication_curvature");
       err = assemble_lubrication_curvature(time_value, theta, delta_t, &pg_data, xi, exo);
+      GOMA_PROF_END("assemble_lubrication_curvature");
       GOMA_EH(err, "assemble_lubrication_curvature");
 #ifdef CHECK_FINITE
       err = CHECKFINITE("assemble_lubrication_curvature");
@@ -2097,7 +2312,9 @@ Revised:         Summer 1998, SY Tam (UNM)
     if (pde[R_SHELL_LUB_CURV_2]) {
       ls_old = ls;
       ls = pfd->ls[0];
+      GOMA_PROF_BEGIN("assemble_lubrication_curvature_2");
       err = assemble_lubrication_curvature_2(time_value, theta, delta_t, &pg_data, xi, exo);
+      GOMA_PROF_END("assemble_lubrication_curvature_2");
       GOMA_EH(err, "assemble_lubrication_curvature_2");
 #ifdef CHECK_FINITE
       err = CHECKFINITE("assemble_lubrication_curvature_2");
@@ -2108,7 +2325,9 @@ Revised:         Summer 1998, SY Tam (UNM)
     }
 
     if (pde[R_SHELL_ENERGY]) {
+      GOMA_PROF_BEGIN("assemble_shell_energy");
       err = assemble_shell_energy(time_value, theta, delta_t, xi, &pg_data, exo);
+      GOMA_PROF_END("assemble_shell_energy");
       GOMA_EH(err, "assemble_shell_energy");
 #ifdef CHECK_FINITE
       err = CHECKFINITE("assemble_shell_energy");
@@ -2118,7 +2337,9 @@ Revised:         Summer 1998, SY Tam (UNM)
     }
 
     if (pde[R_SHELL_DELTAH]) {
+      GOMA_PROF_BEGIN("assemble_shell_deltah");
       err = assemble_shell_deltah(time_value, theta, delta_t, xi, exo);
+      GOMA_PROF_END("assemble_shell_deltah");
       GOMA_EH(err, "assemble_shell_deltah");
 #ifdef CHECK_FINITE
       err = CHECKFINITE("assemble_shell_deltah");
@@ -2131,7 +2352,9 @@ Revised:         Summer 1998, SY Tam (UNM)
 
     if (pde[R_SHELL_FILMP] && pde[R_SHELL_FILMH]) {
       if (ei[pg->imtrx]->ielem_dim == 1) {
+        GOMA_PROF_BEGIN("assemble_film_1D");
         err = assemble_film_1D(time_value, theta, delta_t, xi, exo);
+        GOMA_PROF_END("assemble_film_1D");
         GOMA_EH(err, "assemble_film_1D");
 #ifdef CHECK_FINITE
         err = CHECKFINITE("assemble_film_1D");
@@ -2139,7 +2362,9 @@ Revised:         Summer 1998, SY Tam (UNM)
           return -1;
 #endif
       } else {
+        GOMA_PROF_BEGIN("assemble_film");
         err = assemble_film(time_value, theta, delta_t, xi, exo);
+        GOMA_PROF_END("assemble_film");
         GOMA_EH(err, "assemble_film");
 #ifdef CHECK_FINITE
         err = CHECKFINITE("assemble_film");
@@ -2157,7 +2382,9 @@ Revised:         Summer 1998, SY Tam (UNM)
      * LUBP */
 
     if (pde[R_SHELL_FILMP] && pde[R_SHELL_FILMH] && pde[R_SHELL_PARTC]) {
+      GOMA_PROF_BEGIN("assemble_film_particles");
       err = assemble_film_particles(time_value, theta, delta_t, xi, &pg_data, exo);
+      GOMA_PROF_END("assemble_film_particles");
       GOMA_EH(err, "assemble_film_particles");
 #ifdef CHECK_FINITE
       err = CHECKFINITE("assemble_film_particles");
@@ -2167,7 +2394,9 @@ Revised:         Summer 1998, SY Tam (UNM)
     }
 
     else if (pde[R_LUBP] && pde[R_SHELL_PARTC]) {
+      GOMA_PROF_BEGIN("assemble_film_particles");
       err = assemble_film_particles(time_value, theta, delta_t, xi, &pg_data, exo);
+      GOMA_PROF_END("assemble_film_particles");
       GOMA_EH(err, "assemble_film_particles");
 #ifdef CHECK_FINITE
       err = CHECKFINITE("assemble_film_particles");
@@ -2185,7 +2414,9 @@ Revised:         Summer 1998, SY Tam (UNM)
     }
 
     if (pde[R_SHELL_SAT_CLOSED]) {
+      GOMA_PROF_BEGIN("assemble_porous_shell_closed");
       err = assemble_porous_shell_closed(theta, delta_t, xi, exo);
+      GOMA_PROF_END("assemble_porous_shell_closed");
       GOMA_EH(err, "assemble_porous_shell_closed");
 #ifdef CHECK_FINITE
       err = CHECKFINITE("assemble_porous_shell_closed");
@@ -2197,7 +2428,9 @@ Revised:         Summer 1998, SY Tam (UNM)
     if (pde[R_SHELL_SAT_GASN]) {
       if (!pde[R_SHELL_SAT_CLOSED])
         GOMA_EH(-1, "SHELL_SAT_GASN required SHELL_SAT_CLOSED!");
+      GOMA_PROF_BEGIN("assemble_porous_shell_gasn");
       err = assemble_porous_shell_gasn(theta, delta_t, xi, exo);
+      GOMA_PROF_END("assemble_porous_shell_gasn");
       GOMA_EH(err, "assemble_porous_shell_gasn");
 #ifdef CHECK_FINITE
       err = CHECKFINITE("assemble_porous_shell_gasn");
@@ -2207,7 +2440,9 @@ Revised:         Summer 1998, SY Tam (UNM)
     }
 
     if (pde[R_SHELL_SAT_OPEN]) {
+      GOMA_PROF_BEGIN("assemble_porous_shell_open");
       err = assemble_porous_shell_open(theta, delta_t, xi, exo);
+      GOMA_PROF_END("assemble_porous_shell_open");
       GOMA_EH(err, "assemble_porous_shell_open");
 #ifdef CHECK_FINITE
       err = CHECKFINITE("assemble_porous_shell_open");
@@ -2217,7 +2452,9 @@ Revised:         Summer 1998, SY Tam (UNM)
     }
 
     if (pde[R_SHELL_SAT_OPEN_2]) {
+      GOMA_PROF_BEGIN("assemble_porous_shell_open_2");
       err = assemble_porous_shell_open_2(theta, delta_t, xi, exo);
+      GOMA_PROF_END("assemble_porous_shell_open_2");
       GOMA_EH(err, "assemble_porous_shell_open_2");
 #ifdef CHECK_FINITE
       err = CHECKFINITE("assemble_porous_shell_open_2");
@@ -2227,7 +2464,9 @@ Revised:         Summer 1998, SY Tam (UNM)
     }
 
     if ((pde[R_SHELL_SAT_1]) || (pde[R_SHELL_SAT_2]) || (pde[R_SHELL_SAT_3])) {
+      GOMA_PROF_BEGIN("assemble_porous_shell_saturation");
       err = assemble_porous_shell_saturation(theta, delta_t, xi, exo);
+      GOMA_PROF_END("assemble_porous_shell_saturation");
       GOMA_EH(err, "assemble_porous_shell_saturation");
 #ifdef CHECK_FINITE
       err = CHECKFINITE("assemble_porous_shell_saturation");
@@ -2237,7 +2476,9 @@ Revised:         Summer 1998, SY Tam (UNM)
     }
 
     if (pde[R_SHELL_ANGLE1]) {
+      GOMA_PROF_BEGIN("assemble_shell_angle");
       err = assemble_shell_angle(time_value, theta, delta_t, xi, exo);
+      GOMA_PROF_END("assemble_shell_angle");
       GOMA_EH(err, "assemble_shell_angle");
 #ifdef CHECK_FINITE
       err = CHECKFINITE("assemble_shell_angle");
@@ -2247,7 +2488,9 @@ Revised:         Summer 1998, SY Tam (UNM)
     }
 
     if (pde[R_N_DOT_CURL_V]) {
+      GOMA_PROF_BEGIN("assemble_shell_surface_rheo_pieces");
       err = assemble_shell_surface_rheo_pieces(time_value, theta, delta_t, xi, exo);
+      GOMA_PROF_END("assemble_shell_surface_rheo_pieces");
       GOMA_EH(err, "assemble_shell_surface_rheo_pieces");
 #ifdef CHECK_FINITE
       err = CHECKFINITE("assemble_shell_surface_rheo_pieces");
@@ -2258,7 +2501,9 @@ Revised:         Summer 1998, SY Tam (UNM)
 
     /* Shell structure with both sh_K and sh_tens: */
     if (pde[R_SHELL_CURVATURE] && pde[R_SHELL_TENSION]) {
+      GOMA_PROF_BEGIN("assemble_shell_structure");
       err = assemble_shell_structure(time_value, theta, delta_t, wt, xi, exo);
+      GOMA_PROF_END("assemble_shell_structure");
       GOMA_EH(err, "assemble_shell_structure");
 #ifdef CHECK_FINITE
       err = CHECKFINITE("assemble_shell_structure");
@@ -2266,7 +2511,9 @@ Revised:         Summer 1998, SY Tam (UNM)
         return -1;
 #endif
       if (pde[R_MESH1]) {
+        GOMA_PROF_BEGIN("assemble_shell_coordinates");
         err = assemble_shell_coordinates(time_value, theta, delta_t, wt, xi, exo);
+        GOMA_PROF_END("assemble_shell_coordinates");
         GOMA_EH(err, "assemble_shell_coordinates");
 #ifdef CHECK_FINITE
         err = CHECKFINITE("assemble_shell_coordinates");
@@ -2278,7 +2525,9 @@ Revised:         Summer 1998, SY Tam (UNM)
 
     /* Shell structure with only sh_tens, not sh_K */
     else if (!pde[R_SHELL_CURVATURE] && pde[R_SHELL_TENSION]) {
+      GOMA_PROF_BEGIN("assemble_shell_tension");
       err = assemble_shell_tension(time_value, theta, delta_t, wt, xi, exo);
+      GOMA_PROF_END("assemble_shell_tension");
       GOMA_EH(err, "assemble_shell_tension");
 #ifdef CHECK_FINITE
       err = CHECKFINITE("assemble_shell_tension");
@@ -2286,7 +2535,9 @@ Revised:         Summer 1998, SY Tam (UNM)
         return -1;
 #endif
       if (pde[R_MESH1]) {
+        GOMA_PROF_BEGIN("assemble_shell_coordinates");
         err = assemble_shell_coordinates(time_value, theta, delta_t, wt, xi, exo);
+        GOMA_PROF_END("assemble_shell_coordinates");
         GOMA_EH(err, "assemble_shell_coordinates");
 #ifdef CHECK_FINITE
         err = CHECKFINITE("assemble_shell_coordinates");
@@ -2303,7 +2554,9 @@ Revised:         Summer 1998, SY Tam (UNM)
     }
 
     if (pde[R_SHELL_DIFF_FLUX]) {
+      GOMA_PROF_BEGIN("assemble_shell_diffusion");
       err = assemble_shell_diffusion(time_value, theta, delta_t, wt, xi, exo);
+      GOMA_PROF_END("assemble_shell_diffusion");
       GOMA_EH(err, "assemble_shell_diffusion");
 #ifdef CHECK_FINITE
       err = CHECKFINITE("assemble_shell_diffusion");
@@ -2315,7 +2568,9 @@ Revised:         Summer 1998, SY Tam (UNM)
     /* Web structure with both sh_K and sh_tens: */
     if (pde[R_SHELL_CURVATURE] && pde[R_SHELL_TENSION] &&
         (mp->FSIModel == FSI_SHELL_ONLY || mp->FSIModel == FSI_SHELL_ONLY_MESH)) {
+      GOMA_PROF_BEGIN("assemble_shell_web_structure");
       err = assemble_shell_web_structure(time_value, theta, delta_t, wt, xi, exo);
+      GOMA_PROF_END("assemble_shell_web_structure");
       GOMA_EH(err, "assemble_shell_web_structure");
 #ifdef CHECK_FINITE
       err = CHECKFINITE("assemble_shell_web_structure");
@@ -2323,7 +2578,9 @@ Revised:         Summer 1998, SY Tam (UNM)
         return -1;
 #endif
       if (pde[R_MESH1]) {
+        GOMA_PROF_BEGIN("assemble_shell_web_coordinates");
         err = assemble_shell_web_coordinates(time_value, theta, delta_t, wt, xi, exo);
+        GOMA_PROF_END("assemble_shell_web_coordinates");
         GOMA_EH(err, "assemble_shell_web_coordinates");
 #ifdef CHECK_FINITE
         err = CHECKFINITE("assemble_shell_web_coordinates");
@@ -2339,7 +2596,9 @@ Revised:         Summer 1998, SY Tam (UNM)
         GOMA_EH(GOMA_ERROR,
                 "Both SHELL_NORMAL1 and SHELL_NORMAL2 required with SHELL_DIFF_CURVATURE eqn!");
       }
+      GOMA_PROF_BEGIN("assemble_shell_geometry");
       err = assemble_shell_geometry(time_value, theta, delta_t, wt, xi, exo);
+      GOMA_PROF_END("assemble_shell_geometry");
       GOMA_EH(err, "assemble_shell_geometry");
 #ifdef CHECK_FINITE
       err = CHECKFINITE("assemble_shell_geometry");
@@ -2351,7 +2610,9 @@ Revised:         Summer 1998, SY Tam (UNM)
     if ((pde[R_SHELL_NORMAL1] && pde[R_SHELL_NORMAL2] && pde[R_SHELL_NORMAL3]) ||
         (pde[R_MESH1] && pde[R_SHELL_NORMAL1] && pde[R_SHELL_NORMAL2])) {
 
+      GOMA_PROF_BEGIN("assemble_shell_normal");
       err = assemble_shell_normal(xi, exo);
+      GOMA_PROF_END("assemble_shell_normal");
       GOMA_EH(err, "assemble_shell_normal");
 #ifdef CHECK_FINITE
       err = CHECKFINITE("assemble_shell_normal");
@@ -2361,7 +2622,9 @@ Revised:         Summer 1998, SY Tam (UNM)
     }
 
     if (pde[R_SHELL_CURVATURE] && pde[R_SHELL_CURVATURE2]) {
+      GOMA_PROF_BEGIN("assemble_shell_curvature");
       err = assemble_shell_curvature(xi, exo);
+      GOMA_PROF_END("assemble_shell_curvature");
       GOMA_EH(err, "assemble_shell_curvature");
 #ifdef CHECK_FINITE
       err = CHECKFINITE("assemble_shell_curvature");
@@ -2371,7 +2634,9 @@ Revised:         Summer 1998, SY Tam (UNM)
     }
 
     if ((pde[R_MESH1] && pde[R_SHELL_NORMAL1] && pde[R_SHELL_NORMAL2] && pde[R_SHELL_NORMAL3])) {
+      GOMA_PROF_BEGIN("assemble_shell_mesh");
       err = assemble_shell_mesh(time_value, theta, delta_t, xi, exo);
+      GOMA_PROF_END("assemble_shell_mesh");
       GOMA_EH(err, "assemble_shell_mesh");
 #ifdef CHECK_FINITE
       err = CHECKFINITE("assemble_shell_mesh");
@@ -2381,7 +2646,9 @@ Revised:         Summer 1998, SY Tam (UNM)
     }
 
     if (pde[R_TFMP_MASS] && pde[R_TFMP_BOUND]) {
+      GOMA_PROF_BEGIN("assemble_shell_tfmp");
       err = assemble_shell_tfmp(time_value, theta, delta_t, xi, &pg_data, exo);
+      GOMA_PROF_END("assemble_shell_tfmp");
       GOMA_EH(err, "assemble_shell_tfmp");
 #ifdef CHECK_FINITE
       err = CHECKFINITE("assemble_shell_tfmp");
@@ -2391,7 +2658,9 @@ Revised:         Summer 1998, SY Tam (UNM)
 #endif
     }
     if (!pde[R_TFMP_MASS] && pde[R_TFMP_BOUND]) {
+      GOMA_PROF_BEGIN("assemble_shell_lubrication");
       err = assemble_shell_lubrication(time_value, theta, delta_t, xi, exo);
+      GOMA_PROF_END("assemble_shell_lubrication");
       GOMA_EH(err, "assemble_shell_lubrication");
 #ifdef CHECK_FINITE
       err = CHECKFINITE("assemble_shell_lubrication");
@@ -2410,16 +2679,22 @@ Revised:         Summer 1998, SY Tam (UNM)
 
     if (pde[R_MOMENTUM1]) {
       if (upd->SegregatedSolve) {
+        GOMA_PROF_BEGIN("assemble_momentum_segregated");
         err = assemble_momentum_segregated(time_value, theta, delta_t, &pg_data);
+        GOMA_PROF_END("assemble_momentum_segregated");
         GOMA_EH(err, "assemble_momentum");
 #ifdef CHECK_FINITE
         CHECKFINITE("assemble_momentum");
 #endif
       } else {
         if (upd->AutoDiff) {
+          GOMA_PROF_BEGIN("ad_assemble_momentum");
           err = ad_assemble_momentum(time_value, theta, delta_t, h_elem_avg, &pg_data, xi, exo);
+          GOMA_PROF_END("ad_assemble_momentum");
         } else {
+          GOMA_PROF_BEGIN("assemble_momentum");
           err = assemble_momentum(time_value, theta, delta_t, h_elem_avg, &pg_data, xi, exo);
+          GOMA_PROF_END("assemble_momentum");
         }
         GOMA_EH(err, "assemble_momentum");
 #ifdef CHECK_FINITE
@@ -2429,7 +2704,9 @@ Revised:         Summer 1998, SY Tam (UNM)
     }
 
     if (pde[R_PMOMENTUM1]) {
+      GOMA_PROF_BEGIN("assemble_pmomentum");
       err = assemble_pmomentum(time_value, theta, delta_t);
+      GOMA_PROF_END("assemble_pmomentum");
       GOMA_EH(err, "assemble_pmomentum");
 #ifdef CHECK_FINITE
       err = CHECKFINITE("assemble_pmomentum");
@@ -2439,11 +2716,15 @@ Revised:         Summer 1998, SY Tam (UNM)
     }
 
     if (pde[R_EDDY_NU]) {
+      GOMA_PROF_BEGIN("assemble_spalart_allmaras");
       err = assemble_spalart_allmaras(time_value, theta, delta_t, &pg_data);
+      GOMA_PROF_END("assemble_spalart_allmaras");
 #ifdef GOMA_ENABLE_SACADO
       // err = ad_assemble_spalart_allmaras(time_value, theta, delta_t, &pg_data);
 #else
+      GOMA_PROF_BEGIN("assemble_spalart_allmaras");
       err = assemble_spalart_allmaras(time_value, theta, delta_t, &pg_data);
+      GOMA_PROF_END("assemble_spalart_allmaras");
 #endif
       GOMA_EH(err, "assemble_spalart_allmaras");
 #ifdef CHECK_FINITE
@@ -2453,7 +2734,9 @@ Revised:         Summer 1998, SY Tam (UNM)
 #endif
     }
     if (pde[R_TURB_K] || pde[R_TURB_OMEGA]) {
+      GOMA_PROF_BEGIN("assemble_k_omega_sst_modified");
       err = assemble_k_omega_sst_modified(time_value, theta, delta_t, &pg_data);
+      GOMA_PROF_END("assemble_k_omega_sst_modified");
       // err = ad_assemble_turb_k_omega_modified(time_value, theta, delta_t, &pg_data);
 #ifdef GOMA_ENABLE_SACADO
       // err = ad_assemble_k_omega_sst_modified(time_value, theta, delta_t, &pg_data);
@@ -2546,14 +2829,18 @@ Revised:         Summer 1998, SY Tam (UNM)
     //     }
 
     if (pde[R_MOMENT0] || pde[R_MOMENT1] || pde[R_MOMENT2] || pde[R_MOMENT3]) {
+      GOMA_PROF_BEGIN("assemble_moments");
       err = assemble_moments(time_value, theta, delta_t, &pg_data);
+      GOMA_PROF_END("assemble_moments");
       GOMA_EH(err, "assemble_moments");
 #ifdef CHECK_FINITE
       CHECKFINITE("assemble_moments");
 #endif
     }
     if (pde[R_DENSITY_EQN]) {
+      GOMA_PROF_BEGIN("assemble_density");
       err = assemble_density();
+      GOMA_PROF_END("assemble_density");
       GOMA_EH(err, "assemble_density");
 #ifdef CHECK_FINITE
       CHECKFINITE("assemble_density");
@@ -2562,7 +2849,9 @@ Revised:         Summer 1998, SY Tam (UNM)
 
     if (pde[R_FILL]) {
       if (tran->Fill_Equation == FILL_EQN_EIKONAL) {
+        GOMA_PROF_BEGIN("assemble_fill_gradf");
         err = assemble_fill_gradf(theta, delta_t, pg_data.hsquared, pg_data.hh, pg_data.dh_dxnode);
+        GOMA_PROF_END("assemble_fill_gradf");
         GOMA_EH(err, "assemble_fill_gradf");
 #ifdef CHECK_FINITE
         err = CHECKFINITE("assemble_fill_gradf");
@@ -2581,10 +2870,12 @@ Revised:         Summer 1998, SY Tam (UNM)
     }
 
     if (pde[R_CURVATURE]) {
+      GOMA_PROF_BEGIN("assemble_curvature");
       if (pde[R_NORMAL1])
         err = assemble_div_normals();
       else
         err = assemble_curvature();
+      GOMA_PROF_END("assemble_curvature");
 
       GOMA_EH(err, "assemble curvature projection");
 #ifdef CHECK_FINITE
@@ -2595,7 +2886,9 @@ Revised:         Summer 1998, SY Tam (UNM)
     }
 
     if (pde[R_NORMAL1]) {
+      GOMA_PROF_BEGIN("assemble_normals");
       err = assemble_normals();
+      GOMA_PROF_END("assemble_normals");
       GOMA_EH(err, "assemble_normals");
 #ifdef CHECK_FINITE
       err = CHECKFINITE("assemble_normals");
@@ -2606,7 +2899,9 @@ Revised:         Summer 1998, SY Tam (UNM)
 
     if (pde[R_PRESSURE]) {
       if (upd->SegregatedSolve) {
+        GOMA_PROF_BEGIN("assemble_continuity_segregated");
         err = assemble_continuity_segregated(time_value, theta, delta_t, &pg_data);
+        GOMA_PROF_END("assemble_continuity_segregated");
         GOMA_EH(err, "assemble_continuity");
 #ifdef CHECK_FINITE
         CHECKFINITE("assemble_continuity");
@@ -2615,9 +2910,13 @@ Revised:         Summer 1998, SY Tam (UNM)
           return -1;
       } else {
         if (upd->AutoDiff) {
+          GOMA_PROF_BEGIN("ad_assemble_continuity");
           err = ad_assemble_continuity(time_value, theta, delta_t, &pg_data);
+          GOMA_PROF_END("ad_assemble_continuity");
         } else {
+          GOMA_PROF_BEGIN("assemble_continuity");
           err = assemble_continuity(time_value, theta, delta_t, &pg_data);
+          GOMA_PROF_END("assemble_continuity");
         }
         GOMA_EH(err, "assemble_continuity");
 #ifdef CHECK_FINITE
@@ -2630,7 +2929,9 @@ Revised:         Summer 1998, SY Tam (UNM)
 
     if (pde[R_PSTAR]) {
       if (upd->SegregatedSolve) {
+        GOMA_PROF_BEGIN("assemble_pstar");
         err = assemble_pstar(time_value, theta, delta_t, &pg_data);
+        GOMA_PROF_END("assemble_pstar");
         GOMA_EH(err, "assemble_pstar");
 #ifdef CHECK_FINITE
         CHECKFINITE("assemble_pstar");
@@ -2644,7 +2945,9 @@ Revised:         Summer 1998, SY Tam (UNM)
 
     if (pde[R_USTAR]) {
       if (upd->SegregatedSolve) {
+        GOMA_PROF_BEGIN("assemble_ustar");
         err = assemble_ustar(time_value, theta, delta_t, &pg_data);
+        GOMA_PROF_END("assemble_ustar");
         GOMA_EH(err, "assemble_ustar");
 #ifdef CHECK_FINITE
         CHECKFINITE("assemble_ustar");
@@ -2658,7 +2961,9 @@ Revised:         Summer 1998, SY Tam (UNM)
 
     if (pde[R_VORT_DIR1]) /* Then R_VORT_DIR2 and R_VORT_DIR3 should be on*/
     {
+      GOMA_PROF_BEGIN("assemble_vorticity_direction");
       err = assemble_vorticity_direction();
+      GOMA_PROF_END("assemble_vorticity_direction");
       GOMA_EH(err, "assemble_vorticity_direction");
 #ifdef CHECK_FINITE
       err = CHECKFINITE("assemble_vorticity_direction");
@@ -2668,7 +2973,9 @@ Revised:         Summer 1998, SY Tam (UNM)
     }
 
     if (pde[R_BOND_EVOLUTION]) {
+      GOMA_PROF_BEGIN("assemble_bond_evolution");
       err = assemble_bond_evolution(time_value, theta, delta_t);
+      GOMA_PROF_END("assemble_bond_evolution");
       GOMA_EH(err, "assemble_bond_evolution");
 #ifdef CHECK_FINITE
       err = CHECKFINITE("assemble_bond_evolution");
@@ -2683,7 +2990,9 @@ Revised:         Summer 1998, SY Tam (UNM)
       if (pfd != NULL)
         ls = pfd->ls[0];
 
+      GOMA_PROF_BEGIN("assemble_phase_function");
       err = assemble_phase_function(time_value, theta, delta_t, xi, exo);
+      GOMA_PROF_END("assemble_phase_function");
       GOMA_EH(err, "assemble_phase_functions");
       ls = ls_old;
 
@@ -2693,8 +3002,10 @@ Revised:         Summer 1998, SY Tam (UNM)
         return -1;
 #endif /* CHECK_FINITE */
       if (pfd->Use_Constraint == TRUE) {
+        GOMA_PROF_BEGIN("assemble_pf_constraint");
         err = assemble_pf_constraint(delta_t, &(pfd->Constraint_Integral), augc[0].lm_value,
                                      pfd->jac_info->d_pf_lm, pfd->jac_info->d_lm_pf);
+        GOMA_PROF_END("assemble_pf_constraint");
         GOMA_EH(err, " assemble_pf_constraint \n");
       }
     }
@@ -2702,7 +3013,9 @@ Revised:         Summer 1998, SY Tam (UNM)
     if (pde[R_PHASE1]) {
       ls_old = ls;
       ls = pfd->ls[0];
+      GOMA_PROF_BEGIN("assemble_fill_fake");
       err = assemble_fill_fake(theta, delta_t);
+      GOMA_PROF_END("assemble_fill_fake");
       GOMA_EH(err, "assemble_fill_fake");
 #ifdef CHECK_FINITE
       err = CHECKFINITE("assemble_fill_fake");
@@ -2716,7 +3029,9 @@ Revised:         Summer 1998, SY Tam (UNM)
     if (pd->VolumeIntegral > -1) {
       if (Num_Proc > 1 && dpi->elem_owner[ielem] != ProcID)
         owner = FALSE;
+      GOMA_PROF_BEGIN("assemble_volume");
       err = assemble_volume(owner);
+      GOMA_PROF_END("assemble_volume");
       GOMA_EH(err, "assemble_volume");
 #ifdef CHECK_FINITE
       err = CHECKFINITE("assemble_volume");
@@ -2728,7 +3043,9 @@ Revised:         Summer 1998, SY Tam (UNM)
     if (pd->LSVelocityIntegral > -1) {
       if (Num_Proc > 1 && dpi->elem_owner[ielem] != ProcID)
         owner = FALSE;
+      GOMA_PROF_BEGIN("assemble_LSvelocity");
       err = assemble_LSvelocity(owner, ielem);
+      GOMA_PROF_END("assemble_LSvelocity");
       GOMA_EH(err, "assemble_LSvelocity");
 #ifdef CHECK_FINITE
       err = CHECKFINITE("assemble_LSvelocity");
@@ -2754,6 +3071,7 @@ Revised:         Summer 1998, SY Tam (UNM)
   }
   /* END  for (ip = 0; ip < ip_total; ip++)                               */
 
+  GOMA_PROF_BEGIN("bc");
   if (pd->gv[R_LEVEL_SET] && ls != NULL)
     apply_embedded_colloc_bc(ielem, x, delta_t, theta, time_value, exo, dpi);
 
@@ -3605,6 +3923,7 @@ Revised:         Summer 1998, SY Tam (UNM)
       }
     }
   }
+  GOMA_PROF_END("bc");
 
   /*
    * Load local element stiffness matrix (lec) into global matrix, depending
@@ -3653,7 +3972,9 @@ Revised:         Summer 1998, SY Tam (UNM)
     }
 #endif
 
+  GOMA_PROF_BEGIN("load_lec");
   load_lec(exo, ielem, ams, x, resid_vector, estifm);
+  GOMA_PROF_END("load_lec");
 
   /*  if( pfd != NULL && pfd->Use_Constraint == TRUE )
       {
@@ -3690,27 +4011,9 @@ Revised:         Summer 1998, SY Tam (UNM)
     MMH_ip = -1;
   }
 
-  if (Proc_NS_List_Length > 0 &&
-      ((Linear_Solver != FRONT && ielem == exo->eb_ptr[exo->num_elem_blocks] - 1) ||
-       (Linear_Solver == FRONT && ielem == exo->elem_order_map[exo->num_elem_blocks] - 1))) {
-    if (zeroCA == 0) {
-      int count = 0, Num_CAs_done = 0;
-      for (j = 0; j < MAX_CA; j++) {
-        if (CA_id[j] == -2)
-          Num_CAs_done++;
-        if (CA_proc[j] == ProcID)
-          count++;
-      }
-
-      if (count != Num_CAs_done) {
-        GOMA_WH(-1, "\nNot all contact angle conditions were applied!\n");
-        for (j = 0; j < count; j++) {
-          fprintf(stderr, "CA:%d ID:%d fselem:%d sselem:%d Proc:%d\n", j, CA_id[j], CA_fselem[j],
-                  CA_sselem[j], CA_proc[j]);
-        }
-        fprintf(stderr, "Count=%d  Done=%d\n", count, Num_CAs_done);
-      }
-    }
+  if (Proc_NS_List_Length > 0 && zeroCA == 0 && Linear_Solver == FRONT &&
+      ielem == exo->elem_order_map[exo->num_elem_blocks] - 1) {
+    contact_angle_fill_check();
   }
 
   return 0;
@@ -4202,7 +4505,7 @@ int matrix_fill_stress(struct GomaLinearSolverData *ams,
     err = load_fv();
     GOMA_EH(err, "load_fv");
 
-    if (pde[R_MESH1] || pd->v[pg->imtrx][R_MESH1]) {
+    if (af->Assemble_Jacobian && (pde[R_MESH1] || pd->v[pg->imtrx][R_MESH1])) {
       err = load_bf_mesh_derivs();
       GOMA_EH(err, "load_bf_mesh_derivs");
     }
@@ -4214,7 +4517,7 @@ int matrix_fill_stress(struct GomaLinearSolverData *ams,
     err = load_fv_grads();
     GOMA_EH(err, "load_fv_grads");
 
-    if (pde[R_MESH1] || pd->v[pg->imtrx][R_MESH1]) {
+    if (af->Assemble_Jacobian && (pde[R_MESH1] || pd->v[pg->imtrx][R_MESH1])) {
       err = load_fv_mesh_derivs(1);
       GOMA_EH(err, "load_fv_mesh_derivs");
     }
@@ -5120,11 +5423,9 @@ static void load_lec(Exo_DB *exo, /* ptr to EXODUS II finite element mesh db */
  *************************************************************************/
 {
   int e, v, i, j, pe, pv;
-  int dofs;
   int I, J, K;
-  int gnn, ie, ke, kv, nvdof;
-  int je, ja, ledof;
-  int je_new;
+  int ie, ke, kv;
+  int je, ja;
   struct Element_Indices *ei_ptr;
 #ifdef DEBUG_LEC
   char lec_name[256], ler_name[256];
@@ -5169,243 +5470,62 @@ static void load_lec(Exo_DB *exo, /* ptr to EXODUS II finite element mesh db */
     if (strcmp(Matrix_Format, "msr") == 0) {
       double *a = ams->val;
       int *ija = ams->bindx;
+      int *ja_map = NULL;
+      int r, blk, kk;
+      const struct Lec_Scatter *scatter = lec_scatter_get(ielem, pg->imtrx);
 
-      for (e = V_FIRST; e < V_LAST; e++) {
-        pe = upd->ep[pg->imtrx][e];
-        if (pe != -1) {
-          if (e == R_MASS) {
-            for (ke = 0; ke < upd->Max_Num_Species_Eqn; ke++) {
-              pe = MAX_PROB_VAR + ke;
-              dofs = ei[pg->imtrx]->dof[e];
-              for (i = 0; i < dofs; i++) {
-                /*
-                 * Check to see whether this dof is on a
-                 * node owned by this processor. If it isn't
-                 * there is no need to fill in the processor
-                 * residual and Jacobian row for this variable.
-                 */
-                ledof = ei[pg->imtrx]->lvdof_to_ledof[e][i];
-                if (ei[pg->imtrx]->owned_ledof[ledof]) {
-                  gnn = ei[pg->imtrx]->gnn_list[e][i];
-                  nvdof = ei[pg->imtrx]->Baby_Dolphin[e][i];
-                  je_new = ei[pg->imtrx]->ieqn_ledof[ledof] + ke;
-                  ie = Index_Solution(gnn, e, ke, nvdof, ei[pg->imtrx]->matID_ledof[ledof],
-                                      pg->imtrx);
-
-                  resid_vector[ie] += lec->R[LEC_R_INDEX(MAX_PROB_VAR + ke, i)];
-#ifdef DEBUG_LEC
-                  {
-                    if (fabs(lec->R[LEC_R_INDEX(MAX_PROB_VAR + ke, i)]) > DBL_SMALL ||
-                        Print_Zeroes) {
-                      fprintf(rrrr, "%7d %7d MF%-3d %9d -  %12d - %.10f\n",
-                              DPI_ptr->node_index_global[gnn], gnn, ke, i, ie,
-                              lec->R[LEC_R_INDEX(MAX_PROB_VAR + ke, i)]);
-                    }
-                  }
-#endif
+      /*
+       * ja_map[je] is the position of column je in the current row. It is
+       * filled from ija for each row so that every entry is found in
+       * constant time instead of by a linear search of the row.
+       */
+      if (af->Assemble_Jacobian) {
+        ja_map = lec_scatter_column_map(pg->imtrx,
+                                        NumUnknowns[pg->imtrx] + NumExtUnknowns[pg->imtrx]);
+      }
 
-                  if (af->Assemble_Jacobian) {
-                    for (v = V_FIRST; v < V_LAST; v++) {
-                      pv = upd->vp[pg->imtrx][v];
-                      if (pv != -1 && (Inter_Mask[pg->imtrx][e][v])) {
-                        ei_ptr = ei[pg->imtrx];
-                        if (ei[pg->imtrx]->owningElementForColVar[v] != ielem) {
-                          if (ei[pg->imtrx]->owningElementForColVar[v] != -1) {
-                            ei_ptr = ei[pg->imtrx]->owningElement_ei_ptr[v];
-                            if (ei_ptr == 0) {
-                              printf("ei_ptr == 0\n");
-                              exit(-1);
-                            }
-                          }
-                        }
-                        if (v == MASS_FRACTION) {
-                          for (kv = 0; kv < upd->Max_Num_Species_Eqn; kv++) {
-                            pv = MAX_PROB_VAR + kv;
-                            for (j = 0; j < ei_ptr->dof[v]; j++) {
-                              ledof = ei_ptr->lvdof_to_ledof[v][j];
-                              je_new = ei_ptr->ieqn_ledof[ledof] + kv;
-                              je = Index_Solution(ei_ptr->gnn_list[v][j], v, kv,
-                                                  ei_ptr->Baby_Dolphin[v][j],
-                                                  ei_ptr->matID_ledof[ledof], pg->imtrx);
-                              if (je != je_new) {
-                                /*
-                                 * HKM -> another special case. Until we delineate
-                                 *        the subspecies as individual local
-                                 *        dofs, je_new will be wrong here. je
-                                 *        is correct.
-                                 */
-                                if (Nodes[ei_ptr->gnn_list[v][j]]->Mat_List.Length < 2) {
-                                }
-                              }
-                              GOMA_EH(je, "Bad var index.");
-                              ja = (ie == je) ? ie : in_list(je, ija[ie], ija[ie + 1], ija);
-                              GOMA_EH(ja, "Could not find vbl in sparse matrix.");
-                              a[ja] += lec->J[LEC_J_INDEX(pe, pv, i, j)];
+      for (r = 0; r < scatter->nrows; r++) {
+        ie = scatter->rows[LEC_SCATTER_ROW_SIZE * r + LEC_SCATTER_ROW_INDEX];
+        pe = scatter->rows[LEC_SCATTER_ROW_SIZE * r + LEC_SCATTER_ROW_PE];
+        i = scatter->rows[LEC_SCATTER_ROW_SIZE * r + LEC_SCATTER_ROW_DOF];
+        e = scatter->rows[LEC_SCATTER_ROW_SIZE * r + LEC_SCATTER_ROW_EQN];
 
+        resid_vector[ie] += lec->R[LEC_R_INDEX(pe, i)];
 #ifdef DEBUG_LEC
-                              {
-                                if (fabs(lec->J[LEC_J_INDEX(pe, pv, i, j)]) > DBL_SMALL ||
-                                    Print_Zeroes) {
-                                  fprintf(llll, "%9d %9d %9d %9d -  %12d - %.10f\n", pe, pv, i, j,
-                                          ja, lec->J[LEC_J_INDEX(pe, pv, i, j)]);
-                                }
-                              }
-#endif
-                            }
-                          }
-                        } else {
-                          pv = upd->vp[pg->imtrx][v];
-                          kv = 0;
-                          for (j = 0; j < ei_ptr->dof[v]; j++) {
-                            ledof = ei_ptr->lvdof_to_ledof[v][j];
-                            je_new = ei_ptr->ieqn_ledof[ledof];
-                            je = Index_Solution(ei_ptr->gnn_list[v][j], v, kv,
-                                                ei_ptr->Baby_Dolphin[v][j],
-                                                ei_ptr->matID_ledof[ledof], pg->imtrx);
-                            if (je != je_new) {
-                              fprintf(stderr, "Oh fiddlesticks: je = %d, je_new = %d\n", je,
-                                      je_new);
-                              GOMA_EH(GOMA_ERROR, "LEC Indexing error");
-                            }
-                            GOMA_EH(je, "Bad var index.");
-                            ja = (ie == je) ? ie : in_list(je, ija[ie], ija[ie + 1], ija);
-                            GOMA_EH(ja, "Could not find vbl in sparse matrix.");
-                            a[ja] += lec->J[LEC_J_INDEX(pe, pv, i, j)];
-#ifdef DEBUG_LEC
-                            {
-                              if (fabs(lec->J[LEC_J_INDEX(pe, pv, i, j)]) > DBL_SMALL ||
-                                  Print_Zeroes) {
-                                fprintf(llll, "%9d %9d %9d %9d -  %12d - %.10f\n", pe, pv, i, j, ja,
-                                        lec->J[LEC_J_INDEX(pe, pv, i, j)]);
-                              }
-                            }
-#endif
-                          }
-                        }
-                      }
-                    }
-                  }
-                }
-              }
-            }
-          } else {
-            pe = upd->ep[pg->imtrx][e];
-            dofs = ei[pg->imtrx]->dof[e];
-            for (i = 0; i < dofs; i++) {
-              /*
-               * Check to see whether this dof is on a
-               * node owned by this processor. If it isn't
-               * there is no need to fill in the processor
-               * residual and Jacobian row for this variable.
-               */
-              ledof = ei[pg->imtrx]->lvdof_to_ledof[e][i];
-              if (ei[pg->imtrx]->owned_ledof[ledof]) {
-                ie = ei[pg->imtrx]->gun_list[e][i];
-                resid_vector[ie] += lec->R[LEC_R_INDEX(pe, i)];
-#ifdef DEBUG_LEC
-                {
-                  if (fabs(lec->R[LEC_R_INDEX(pe, i)]) > DBL_SMALL || Print_Zeroes) {
-
-                    fprintf(rrrr, "%9d %9d -  %12d - %.10f\n", pe, i, ie,
-                            lec->R[LEC_R_INDEX(pe, i)]);
-                  }
-                }
+        if (fabs(lec->R[LEC_R_INDEX(pe, i)]) > DBL_SMALL || Print_Zeroes) {
+          fprintf(rrrr, "%9d %9d -  %12d - %.10f\n", pe, i, ie, lec->R[LEC_R_INDEX(pe, i)]);
+        }
 #endif
 
-                if (af->Assemble_Jacobian) {
-                  for (v = V_FIRST; v < V_LAST; v++) {
-                    pv = upd->vp[pg->imtrx][v];
-                    if (pv != -1 && (Inter_Mask[pg->imtrx][e][v])) {
-                      if (v == MASS_FRACTION) {
-
-                        ei_ptr = ei[pg->imtrx];
-                        if (ei[pg->imtrx]->owningElementForColVar[v] != ielem) {
-                          if (ei[pg->imtrx]->owningElementForColVar[v] != -1) {
-                            ei_ptr = ei[pg->imtrx]->owningElement_ei_ptr[v];
-                            if (ei_ptr == 0) {
-                              GOMA_EH(GOMA_ERROR, "ei_ptr == 0\n");
-                              exit(-1);
-                            }
-                          }
-                        }
-                        for (kv = 0; kv < upd->Max_Num_Species_Eqn; kv++) {
-                          pv = MAX_PROB_VAR + kv;
-                          for (j = 0; j < ei_ptr->dof[v]; j++) {
-                            ledof = ei_ptr->lvdof_to_ledof[v][j];
-                            je_new = ei_ptr->ieqn_ledof[ledof] + kv;
-                            je = Index_Solution(ei_ptr->gnn_list[v][j], v, kv,
-                                                ei_ptr->Baby_Dolphin[v][j],
-                                                ei_ptr->matID_ledof[ledof], pg->imtrx);
-                            if (je != je_new) {
-                              /*
-                               * HKM -> another special case. Until we delineate
-                               *        the subspecies as individual local
-                               *        dofs, je_new will be wrong here. je
-                               *        is correct.
-                               */
-                              if (Nodes[ei[pg->imtrx]->gnn_list[v][j]]->Mat_List.Length < 2) {
-                              }
-                            }
-                            GOMA_EH(je, "Bad var index.");
-                            ja = (ie == je) ? ie : in_list(je, ija[ie], ija[ie + 1], ija);
-                            GOMA_EH(ja, "Could not find vbl in sparse matrix.");
-                            a[ja] += lec->J[LEC_J_INDEX(pe, pv, i, j)];
-
-#ifdef DEBUG_LEC
-                            {
-                              if (fabs(lec->J[LEC_J_INDEX(pe, pv, i, j)]) > DBL_SMALL ||
-                                  Print_Zeroes) {
-                                fprintf(llll, "%9d %9d %9d %9d -  %12d - %.10f\n", pe, pv, i, j, ja,
-                                        lec->J[LEC_J_INDEX(pe, pv, i, j)]);
-                              }
-                            }
-#endif
-                          }
-                        }
-                      } else {
-                        kv = 0;
-                        // NEW IMPLEMENTATION
-                        ei_ptr = ei[pg->imtrx];
-                        if (ei[pg->imtrx]->owningElementForColVar[v] != ielem) {
-                          if (ei[pg->imtrx]->owningElementForColVar[v] != -1) {
-                            ei_ptr = ei[pg->imtrx]->owningElement_ei_ptr[v];
-                            if (ei_ptr == 0) {
-                              GOMA_EH(GOMA_ERROR, "ei slave pointer is null");
-                              exit(-1);
-                            }
-                          }
-                        }
-                        for (j = 0; j < ei_ptr->dof[v]; j++) {
-                          ledof = ei_ptr->lvdof_to_ledof[v][j];
-                          je_new = ei_ptr->ieqn_ledof[ledof];
-                          je = Index_Solution(ei_ptr->gnn_list[v][j], v, kv,
-                                              ei_ptr->Baby_Dolphin[v][j],
-                                              ei_ptr->matID_ledof[ledof], pg->imtrx);
-                          if (je != je_new) {
-                            fprintf(stderr, "Oh fiddlesticks: je = %d, je_new = %d\n", je, je_new);
-                            GOMA_EH(GOMA_ERROR, "LEC Indexing error");
-                          }
-                          GOMA_EH(je, "Bad var index.");
-                          ja = (ie == je) ? ie : in_list(je, ija[ie], ija[ie + 1], ija);
-                          GOMA_EH(ja, "Could not find vbl in sparse matrix.");
-                          a[ja] += lec->J[LEC_J_INDEX(pe, pv, i, j)];
+        if (af->Assemble_Jacobian) {
+          for (kk = ija[ie]; kk < ija[ie + 1]; kk++) {
+            ja_map[ija[kk]] = kk;
+          }
+          ja_map[ie] = ie;
+
+          for (blk = 0; blk < scatter->nblocks; blk++) {
+            const int *block = scatter->blocks + LEC_SCATTER_BLK_SIZE * blk;
+            if (!Inter_Mask[pg->imtrx][e][block[LEC_SCATTER_BLK_VAR]])
+              continue;
+            pv = block[LEC_SCATTER_BLK_PV];
+            for (j = 0; j < block[LEC_SCATTER_BLK_NCOL]; j++) {
+              je = scatter->cols[block[LEC_SCATTER_BLK_START] + j];
+              ja = ja_map[je];
+              GOMA_EH(ja, "Could not find vbl in sparse matrix.");
+              a[ja] += lec->J[LEC_J_INDEX(pe, pv, i, j)];
 #ifdef DEBUG_LEC
-                          {
-                            if (fabs(lec->J[LEC_J_INDEX(pe, pv, i, j)]) > DBL_SMALL ||
-                                Print_Zeroes) {
-                              fprintf(llll, "%9d %9d %9d %9d -  %12d - %.10f\n", pe, pv, i, j, ja,
-                                      lec->J[LEC_J_INDEX(pe, pv, i, j)]);
-                            }
-                          }
-#endif
-                        }
-                      }
-                    }
-                  }
-                }
+              if (fabs(lec->J[LEC_J_INDEX(pe, pv, i, j)]) > DBL_SMALL || Print_Zeroes) {
+                fprintf(llll, "%9d %9d %9d %9d -  %12d - %.10f\n", pe, pv, i, j, ja,
+                        lec->J[LEC_J_INDEX(pe, pv, i, j)]);
               }
+#endif
             }
           }
+
+          for (kk = ija[ie]; kk < ija[ie + 1]; kk++) {
+            ja_map[ija[kk]] = -1;
+          }
+          ja_map[ie] = -1;
         }
       }
     } /* Matrix_Format == "msr" */
@@ -5573,14 +5693,29 @@ static void zero_lec(void)
  * zero_lec()
  *
  *  This routine zeroes the local element stiffness vector and Jacobian.
+ *  Only the Jacobian rows of equations in the current matrix are zeroed,
+ *  those are the only rows load_lec() reads. J_stress_neighbor is zeroed
+ *  by the discontinuous stress fill that uses it.
  **************************************************************************/
 {
+  int e, ke;
+  size_t row_block = (size_t)lec->num_desc * lec->max_dof * lec->max_dof;
+
   memset(lec->R, 0, MAX_LOCAL_VAR_DESC * lec->max_dof * sizeof(dbl));
   if (af->Assemble_Jacobian) {
-    memset(lec->J, 0,
-           MAX_LOCAL_VAR_DESC * MAX_LOCAL_VAR_DESC * lec->max_dof * lec->max_dof * sizeof(dbl));
-    memset(lec->J_stress_neighbor, 0,
-           4 * lec->max_dof * MAX_LOCAL_VAR_DESC * lec->max_dof * sizeof(dbl));
+    for (e = V_FIRST; e < V_LAST; e++) {
+      if (upd->ep[pg->imtrx][e] == -1)
+        continue;
+      if (e == R_MASS) {
+        for (ke = 0; ke < upd->Max_Num_Species_Eqn; ke++) {
+          memset(lec->J + row_block * lec->desc_slot[MAX_PROB_VAR + ke], 0,
+                 row_block * sizeof(dbl));
+        }
+      } else {
+        memset(lec->J + row_block * lec->desc_slot[upd->ep[pg->imtrx][e]], 0,
+               row_block * sizeof(dbl));
+      }
+    }
   }
 }
 /****************************************************************************/
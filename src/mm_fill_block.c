@@ -0,0 +1,138 @@
+/************************************************************************ *
+* Goma - Multiphysics finite element software                             *
+* Sandia National Laboratories                                            *
+*                                                                         *
+* Copyright (c) 2022 Goma Developers, National Technology & Engineering   *
+*               Solutions of Sandia, LLC (NTESS)                          *
+*                                                                         *
+* Under the terms of Contract DE-NA0003525, the U.S. Government retains   *
+* certain rights in this software.                                        *
+*                                                                         *
+* This software is distributed under the GNU General Public License.      *
+* See LICENSE file.                                                       *
+\************************************************************************/
+
+/*
+ * mm_fill_block.c -- element block context for block-wise assembly
+ */
+
+#include <stdio.h>
+
+#include "el_elm.h"
+#include "el_elm_info.h"
+#include "exo_struct.h"
+#include "mm_as.h"
+#include "mm_as_const.h"
+#include "mm_as_structs.h"
+#include "mm_eh.h"
+#include "mm_fill_block.h"
+#include "mm_mp.h"
+#include "rf_fem.h"
+#include "rf_fem_const.h"
+#include "std.h"
+
+Element_Block_Context *Current_Block_Context = NULL;
+
+/*
+ * element_block_dg_types -- discontinuous Galerkin flags of a problem
+ *                           description for matrix imtrx
+ *
+ * ielem_type_mass is only set (to the discontinuous species element
+ * type) when discontinuous_mass is TRUE, otherwise it is -1.
+ */
+void element_block_dg_types(const PROBLEM_DESCRIPTION_STRUCT *pd_ptr,
+                            const int imtrx,
+                            int *discontinuous_mass,
+                            int *ielem_type_mass,
+                            int *discontinuous_stress) {
+  *discontinuous_mass = 0;
+  *ielem_type_mass = -1;
+
+  if (pd_ptr->i[imtrx][MASS_FRACTION] == I_P1) {
+    if (pd_ptr->Num_Dim == 2)
+      *ielem_type_mass = P1_QUAD;
+    if (pd_ptr->Num_Dim == 3)
+      *ielem_type_mass = P1_HEX;
+    *discontinuous_mass = 1;
+  } else if (pd_ptr->i[imtrx][MASS_FRACTION] == I_P0) {
+    if (pd_ptr->Num_Dim == 2)
+      *ielem_type_mass = P0_QUAD;
+    if (pd_ptr->Num_Dim == 3)
+      *ielem_type_mass = P0_HEX;
+    *discontinuous_mass = 1;
+  } else if (pd_ptr->i[imtrx][MASS_FRACTION] == I_PQ1) {
+    if (pd_ptr->Num_Dim == 2)
+      *ielem_type_mass = BILINEAR_QUAD;
+    if (pd_ptr->Num_Dim == 3)
+      GOMA_EH(GOMA_ERROR, "Sorry PQ1 interpolation has not been implemented in 3D yet.");
+    *discontinuous_mass = 1;
+  } else if (pd_ptr->i[imtrx][MASS_FRACTION] == I_PQ2) {
+    if (pd_ptr->Num_Dim == 2)
+      *ielem_type_mass = BIQUAD_QUAD;
+    if (pd_ptr->Num_Dim == 3)
+      GOMA_EH(GOMA_ERROR, "Sorry PQ2 interpolation has not been implemented in 3D yet.");
+    *discontinuous_mass = 1;
+  }
+
+  *discontinuous_stress = 0;
+
+  if (pd_ptr->i[imtrx][POLYMER_STRESS11] == I_P1) {
+    *discontinuous_stress = 1;
+  } else if (pd_ptr->i[imtrx][POLYMER_STRESS11] == I_P0) {
+    *discontinuous_stress = 1;
+  } else if (pd_ptr->i[imtrx][POLYMER_STRESS11] == I_PQ1) {
+    if (pd_ptr->Num_Dim == 3)
+      GOMA_EH(GOMA_ERROR, "Sorry PQ1 interpolation has not been implemented in 3D yet.");
+    *discontinuous_stress = 1;
+  } else if (pd_ptr->i[imtrx][POLYMER_STRESS11] == I_PQ2) {
+    if (pd_ptr->Num_Dim == 3)
+      GOMA_EH(GOMA_ERROR, "Sorry PQ2 interpolation has not been implemented in 3D yet.");
+    *discontinuous_stress = 1;
+  }
+}
+
+/*
+ * element_block_context_load -- gather the block invariant data of element
+ *                               block ebn for assembly of matrix imtrx
+ *
+ * Blocks without a material (Matilda[ebn] < 0) get mn = -1 and no problem
+ * description, the caller is expected to skip them.
+ */
+void element_block_context_load(Element_Block_Context *ctx,
+                                const int ebn,
+                                const Exo_DB *exo,
+                                const int imtrx) {
+  if (ebn < 0 || ebn >= exo->num_elem_blocks) {
+    GOMA_EH(GOMA_ERROR, "Element block index %d out of range", ebn);
+    return;
+  }
+
+  ctx->ebn = ebn;
+  ctx->eb_id = exo->eb_id[ebn];
+  ctx->mn = Matilda[ebn];
+  ctx->imtrx = imtrx;
+  ctx->e_start = exo->eb_ptr[ebn];
+  ctx->e_end = exo->eb_ptr[ebn + 1];
+  ctx->ielem_type = exo->eb_elem_itype[ebn];
+  ctx->ielem_shape = type2shape(ctx->ielem_type);
+  ctx->ielem_dim = elem_info(NDIM, ctx->ielem_type);
+  ctx->num_local_nodes = elem_info(NNODES, ctx->ielem_type);
+  ctx->num_sides = shape2sides(ctx->ielem_shape);
+  ctx->ip_total = elem_info(NQUAD, ctx->ielem_type);
+
+  ctx->discontinuous_mass = 0;
+  ctx->ielem_type_mass = -1;
+  ctx->discontinuous_stress = 0;
+  ctx->pd = NULL;
+  ctx->mp = NULL;
+
+  if (ctx->mn < 0) {
+    return;
+  }
+
+  ctx->pd = pd_glob[ctx->mn];
+  ctx->mp = mp_glob[ctx->mn];
+
+  element_block_dg_types(ctx->pd, imtrx, &ctx->discontinuous_mass, &ctx->ielem_type_mass,
+                         &ctx->discontinuous_stress);
+}
@@ -0,0 +1,225 @@
+/************************************************************************ *
+* Goma - Multiphysics finite element software                             *
+* Sandia National Laboratories                                            *
+*                                                                         *
+* Copyright (c) 2022 Goma Developers, National Technology & Engineering   *
+*               Solutions of Sandia, LLC (NTESS)                          *
+*                                                                         *
+* Under the terms of Contract DE-NA0003525, the U.S. Government retains   *
+* certain rights in this software.                                        *
+*                                                                         *
+* This software is distributed under the GNU General Public License.      *
+* See LICENSE file.                                                       *
+\************************************************************************/
+
+/*
+ * mm_fill_geom_cache.c -- element mapping cache for fixed meshes
+ *
+ * An entry holds what beer_belly() produces for a non-deforming element:
+ * the physical coordinates of the point and the mapping J, B = J^-1 and
+ * detJ, which are the same for every basis function. Entries are laid
+ * out element by element in the order of the local element numbering.
+ * Elements that do not fit in upd->Geometry_Cache_Max_MB are simply not
+ * cached and go through beer_belly() every time.
+ *
+ * The cache is tied to the mesh it was built on and must be dropped with
+ * geometry_cache_free() when the mesh changes (teardown and remeshing).
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "el_elm.h"
+#include "el_elm_info.h"
+#include "exo_struct.h"
+#include "mm_as.h"
+#include "mm_as_structs.h"
+#include "mm_eh.h"
+#include "mm_fill_geom_cache.h"
+#include "mm_fill_util.h"
+#include "mm_mp.h"
+#include "mm_mp_const.h"
+#include "mm_mp_structs.h"
+#include "rf_allo.h"
+#include "rf_fem.h"
+#include "rf_fem_const.h"
+#include "std.h"
+
+#define GEOM_ENTRY_X    0
+#define GEOM_ENTRY_J    (GEOM_ENTRY_X + DIM)
+#define GEOM_ENTRY_B    (GEOM_ENTRY_J + DIM * DIM)
+#define GEOM_ENTRY_DETJ (GEOM_ENTRY_B + DIM * DIM)
+#define GEOM_ENTRY_SIZE (GEOM_ENTRY_DETJ + 1)
+
+static struct {
+  const Exo_DB *exo;
+  int num_elems;
+  int precision;
+  int *elem_offset; /* first entry of each element, -1 if not cached */
+  int *elem_nquad;  /* quadrature points of each element */
+  char *valid;      /* entry has been filled */
+  double *dval;     /* entries, GEOMETRY_CACHE_DOUBLE */
+  float *fval;      /* entries, GEOMETRY_CACHE_SINGLE */
+} Geom_Cache = {NULL, 0, GEOMETRY_CACHE_NONE, NULL, NULL, NULL, NULL, NULL};
+
+static void geometry_cache_build(const Exo_DB *exo) {
+  int ebn, e, nq;
+  size_t value_size, max_entries, num_entries = 0;
+
+  geometry_cache_free();
+
+  Geom_Cache.exo = exo;
+  Geom_Cache.num_elems = exo->num_elems;
+  Geom_Cache.precision = upd->Geometry_Cache;
+  Geom_Cache.elem_offset = alloc_int_1(MAX(exo->num_elems, 1), -1);
+  Geom_Cache.elem_nquad = alloc_int_1(MAX(exo->num_elems, 1), 0);
+
+  value_size = (Geom_Cache.precision == GEOMETRY_CACHE_SINGLE) ? sizeof(float) : sizeof(double);
+  max_entries = ((size_t)upd->Geometry_Cache_Max_MB * 1024 * 1024) /
+                (GEOM_ENTRY_SIZE * value_size + sizeof(char));
+
+  for (ebn = 0; ebn < exo->num_elem_blocks; ebn++) {
+    nq = elem_info(NQUAD, exo->eb_elem_itype[ebn]);
+    for (e = exo->eb_ptr[ebn]; e < exo->eb_ptr[ebn + 1]; e++) {
+      Geom_Cache.elem_nquad[e] = nq;
+      if (num_entries + nq <= max_entries) {
+        Geom_Cache.elem_offset[e] = (int)num_entries;
+        num_entries += nq;
+      }
+    }
+  }
+
+  Geom_Cache.valid = calloc(MAX(num_entries, 1), sizeof(char));
+  if (Geom_Cache.precision == GEOMETRY_CACHE_SINGLE) {
+    Geom_Cache.fval = malloc(MAX(num_entries, 1) * GEOM_ENTRY_SIZE * sizeof(float));
+  } else {
+    Geom_Cache.dval = malloc(MAX(num_entries, 1) * GEOM_ENTRY_SIZE * sizeof(double));
+  }
+  if (Geom_Cache.valid == NULL || (Geom_Cache.fval == NULL && Geom_Cache.dval == NULL)) {
+    GOMA_EH(GOMA_ERROR, "Could not allocate geometry cache of %zu entries", num_entries);
+  }
+}
+
+/*
+ * The mapping at a point is fixed when neither this element nor a
+ * neighbouring bulk element moves the mesh. Shell mappings are left alone,
+ * beer_belly() patches them up with problem specific values.
+ */
+static int geometry_cache_applies(void) {
+  int imtrx = upd->matrix_index[pd->ShapeVar];
+  int shape;
+
+  if (pd->gv[MESH_DISPLACEMENT1] || ei[imtrx]->deforming_mesh) {
+    return FALSE;
+  }
+  shape = ei[imtrx]->ielem_shape;
+  if (shape == SHELL || shape == TRISHELL || mp->ehl_integration_kind == SIK_S) {
+    return FALSE;
+  }
+  return TRUE;
+}
+
+static void geometry_cache_store(const size_t entry) {
+  int si, i, j;
+  struct Basis_Functions *MapBf;
+  double val[GEOM_ENTRY_SIZE];
+
+  si = in_list(pd->IntegrationMap, 0, Num_Interpolations, Unique_Interpolations);
+  MapBf = bfd[si];
+
+  for (i = 0; i < DIM; i++) {
+    val[GEOM_ENTRY_X + i] = fv->x[i];
+    for (j = 0; j < DIM; j++) {
+      val[GEOM_ENTRY_J + DIM * i + j] = MapBf->J[i][j];
+      val[GEOM_ENTRY_B + DIM * i + j] = MapBf->B[i][j];
+    }
+  }
+  val[GEOM_ENTRY_DETJ] = MapBf->detJ;
+
+  if (Geom_Cache.precision == GEOMETRY_CACHE_SINGLE) {
+    for (i = 0; i < GEOM_ENTRY_SIZE; i++) {
+      Geom_Cache.fval[entry * GEOM_ENTRY_SIZE + i] = (float)val[i];
+    }
+  } else {
+    memcpy(Geom_Cache.dval + entry * GEOM_ENTRY_SIZE, val, sizeof(val));
+  }
+  Geom_Cache.valid[entry] = TRUE;
+}
+
+static void geometry_cache_load(const size_t entry) {
+  int t, i, j;
+  double val[GEOM_ENTRY_SIZE];
+
+  if (Geom_Cache.precision == GEOMETRY_CACHE_SINGLE) {
+    for (i = 0; i < GEOM_ENTRY_SIZE; i++) {
+      val[i] = Geom_Cache.fval[entry * GEOM_ENTRY_SIZE + i];
+    }
+  } else {
+    memcpy(val, Geom_Cache.dval + entry * GEOM_ENTRY_SIZE, sizeof(val));
+  }
+
+  for (i = 0; i < DIM; i++) {
+    fv->x[i] = val[GEOM_ENTRY_X + i];
+    fv_old->x[i] = val[GEOM_ENTRY_X + i];
+  }
+
+  for (t = 0; t < Num_Basis_Functions; t++) {
+    for (i = 0; i < DIM; i++) {
+      for (j = 0; j < DIM; j++) {
+        bfd[t]->J[i][j] = val[GEOM_ENTRY_J + DIM * i + j];
+        bfd[t]->B[i][j] = val[GEOM_ENTRY_B + DIM * i + j];
+      }
+    }
+    bfd[t]->detJ = val[GEOM_ENTRY_DETJ];
+  }
+}
+
+/*
+ * geometry_cache_beer_belly -- beer_belly() for volume quadrature point ip
+ *                              of element ielem, through the cache
+ *
+ * ip must be the index of a regular Gauss point (find_stu(ip, ...)) or -1
+ * for anything else (subgrid, subelement or XFEM points), which bypasses
+ * the cache. Returns the beer_belly() status.
+ */
+int geometry_cache_beer_belly(const int ielem, const int ip, const Exo_DB *exo) {
+  int status;
+  size_t entry;
+
+  if (upd->Geometry_Cache == GEOMETRY_CACHE_NONE || ip < 0 || !geometry_cache_applies()) {
+    return beer_belly();
+  }
+
+  if (Geom_Cache.exo != exo || Geom_Cache.num_elems != exo->num_elems ||
+      Geom_Cache.precision != upd->Geometry_Cache) {
+    geometry_cache_build(exo);
+  }
+
+  if (Geom_Cache.elem_offset[ielem] < 0 || ip >= Geom_Cache.elem_nquad[ielem]) {
+    return beer_belly();
+  }
+
+  entry = (size_t)Geom_Cache.elem_offset[ielem] + ip;
+  if (Geom_Cache.valid[entry]) {
+    geometry_cache_load(entry);
+    return 0;
+  }
+
+  status = beer_belly();
+  if (status == 0 && !neg_elem_volume && !zero_detJ) {
+    geometry_cache_store(entry);
+  }
+  return status;
+}
+
+void geometry_cache_free(void) {
+  safer_free((void **)&Geom_Cache.elem_offset);
+  safer_free((void **)&Geom_Cache.elem_nquad);
+  safer_free((void **)&Geom_Cache.valid);
+  safer_free((void **)&Geom_Cache.dval);
+  safer_free((void **)&Geom_Cache.fval);
+  Geom_Cache.exo = NULL;
+  Geom_Cache.num_elems = 0;
+  Geom_Cache.precision = GEOMETRY_CACHE_NONE;
+}
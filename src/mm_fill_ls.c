@@ -20,6 +20,7 @@
  *$Id: mm_fill_ls.c,v 5.21 2009-11-13 23:20:08 prschun Exp $
  */
 
+#include <float.h>
 #include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -113,6 +114,14 @@ static struct LS_Surf_List *create_surfs_from_iso(int, double, double *, Exo_DB
 
 static void initialize_sign(int, double *, Exo_DB *);
 
+static void build_surf_tree(struct LS_Surf_List *);
+
+static void free_surf_tree(struct LS_Surf_Search_Tree **);
+
+static int surf_list_within_band(struct LS_Surf_List *, double *, Exo_DB *, double[DIM], double);
+
+static void fast_marching_renormalization(double *, Exo_DB *, Dpi *, int, struct LS_Surf_List *);
+
 static double initial_level_set(double, double, double);
 
 static double gradient_norm_err(dbl *, Exo_DB *, Dpi *, dbl);
@@ -527,7 +536,11 @@ huygens_renormalization ( double *x,
       DPRINTF(stdout, "\n\t Maximum number of steps without renormalization reached: %d",
               ls->Renorm_Freq);
     }
-    DPRINTF(stdout, "\n\t Huygens renormalization : ");
+    if (ls->Renorm_Method == FAST_MARCHING) {
+      DPRINTF(stdout, "\n\t Fast marching renormalization : ");
+    } else {
+      DPRINTF(stdout, "\n\t Huygens renormalization : ");
+    }
 
     /* this call cleanses the LS field of "droplets" that surround exactly one
      * node */
@@ -558,6 +571,8 @@ huygens_renormalization ( double *x,
     } else if (ls->Renorm_Method == SMOLIANSKI_ONLY) {
       Hrenorm_smolianksi_only(exo, cx, dpi, x, list, num_total_nodes, num_ls_unkns, num_total_unkns,
                               time);
+    } else if (ls->Renorm_Method == FAST_MARCHING) {
+      fast_marching_renormalization(x, exo, dpi, num_total_nodes, list);
     } else {
       GOMA_EH(GOMA_ERROR, "You shouldn't actually be here. \n");
     }
@@ -832,6 +847,21 @@ void surf_based_initialization(double *x,
     ie = Index_Solution(I, ls->var, 0, 0, -2, pg->imtrx);
 
     if (ie != -1) {
+      /* Outside the narrow band the distance is clipped to the band width */
+      if (ls->Renorm_Band > 0. && !ls->Periodic_Planes &&
+          !surf_list_within_band(list, x, exo, r, ls->Renorm_Band)) {
+        struct LS_Surf_Iso_Data *s = (struct LS_Surf_Iso_Data *)list->start->data;
+        double band_distance = (x[ie] - s->isoval < 0.) ? -ls->Renorm_Band : ls->Renorm_Band;
+
+        if (delta_x != NULL)
+          delta_x[ie] = x[ie] - band_distance;
+        if (xdot != NULL)
+          xdot[ie] -= delta_x[ie] * (1.0 + 2 * theta) / delta_t;
+
+        x[ie] = band_distance;
+        continue;
+      }
+
       closest = closest_surf(list, x, exo, r);
 
       /* Crude support for periodic level set function during redistancing
@@ -1005,6 +1035,220 @@ void surf_based_initialization(double *x,
   return;
 }
 
+/*
+ * Binary min heap of nodes keyed by their tentative distance, used by the
+ * fast marching renormalization.  pos[I] is the heap slot of node I or -1.
+ */
+struct FM_Heap {
+  int size;
+  int *node;
+  int *pos;
+  double *key;
+};
+
+static void fm_heap_swap(struct FM_Heap *h, int i, int j) {
+  int tmp = h->node[i];
+  h->node[i] = h->node[j];
+  h->node[j] = tmp;
+  h->pos[h->node[i]] = i;
+  h->pos[h->node[j]] = j;
+}
+
+static void fm_heap_up(struct FM_Heap *h, int i) {
+  while (i > 0 && h->key[h->node[(i - 1) / 2]] > h->key[h->node[i]]) {
+    fm_heap_swap(h, i, (i - 1) / 2);
+    i = (i - 1) / 2;
+  }
+}
+
+static void fm_heap_down(struct FM_Heap *h, int i) {
+  for (;;) {
+    int smallest = i;
+    int l = 2 * i + 1;
+    int r = 2 * i + 2;
+
+    if (l < h->size && h->key[h->node[l]] < h->key[h->node[smallest]])
+      smallest = l;
+    if (r < h->size && h->key[h->node[r]] < h->key[h->node[smallest]])
+      smallest = r;
+    if (smallest == i)
+      return;
+    fm_heap_swap(h, i, smallest);
+    i = smallest;
+  }
+}
+
+/* insert node I, or move it up after its key decreased */
+static void fm_heap_update(struct FM_Heap *h, int I) {
+  if (h->pos[I] == -1) {
+    h->node[h->size] = I;
+    h->pos[I] = h->size++;
+  }
+  fm_heap_up(h, h->pos[I]);
+}
+
+static int fm_heap_pop(struct FM_Heap *h) {
+  int I = h->node[0];
+
+  h->pos[I] = -1;
+  h->size--;
+  if (h->size > 0) {
+    h->node[0] = h->node[h->size];
+    h->pos[h->node[0]] = 0;
+    fm_heap_down(h, 0);
+  }
+  return I;
+}
+
+/*
+ * fast_marching_renormalization -- Reinitialize the level set function to a
+ * signed distance by fast marching outward from the interface.
+ *
+ * Nodes of elements crossed by the isosurface (and, in parallel, processor
+ * boundary nodes within the band) are seeded with their exact distance to
+ * the reconstructed interface.  The remaining nodes are accepted in order of
+ * increasing distance, each taking the closest interface point of an
+ * accepted neighbor (closest point propagation), which works for any element
+ * shape.  Marching stops at ls->Renorm_Band, nodes outside the band are set
+ * to plus or minus the band width.  Without a band the whole mesh is marched.
+ */
+static void fast_marching_renormalization(double *x,
+                                          Exo_DB *exo,
+                                          Dpi *dpi,
+                                          int num_total_nodes,
+                                          struct LS_Surf_List *list) {
+  int a, e, I, J, ie, k, l;
+  int DeformingMesh = upd->ep[pg->imtrx][R_MESH1];
+  double band = (ls->Renorm_Band > 0.) ? ls->Renorm_Band : DBL_MAX;
+  double isoval = ((struct LS_Surf_Iso_Data *)list->start->data)->isoval;
+  double **Disp = NULL;
+  double *coord, *dist, *cp;
+  int *accepted;
+  struct FM_Heap heap;
+
+  if (ls->Periodic_Planes) {
+    GOMA_EH(GOMA_ERROR, "Fast_Marching renormalization does not support periodic planes");
+  }
+
+  create_subsurfs(list, x, exo);
+
+  if (DeformingMesh != -1) {
+    Disp = (double **)smalloc(DIM * sizeof(double *));
+
+    for (a = 0; a < pd->Num_Dim; a++)
+      Disp[a] = (double *)smalloc(num_total_nodes * sizeof(double));
+
+    stash_node_displacements(Disp, num_total_nodes, x, exo);
+  }
+
+  coord = (double *)smalloc(DIM * num_total_nodes * sizeof(double));
+  cp = (double *)smalloc(DIM * num_total_nodes * sizeof(double));
+  dist = (double *)smalloc(num_total_nodes * sizeof(double));
+  accepted = (int *)smalloc(num_total_nodes * sizeof(int));
+  heap.node = (int *)smalloc(num_total_nodes * sizeof(int));
+  heap.pos = (int *)smalloc(num_total_nodes * sizeof(int));
+  heap.key = dist;
+  heap.size = 0;
+
+  for (I = 0; I < num_total_nodes; I++) {
+    retrieve_node_coordinates(I, x, &coord[DIM * I], Disp);
+    dist[I] = DBL_MAX;
+    accepted[I] = FALSE;
+    heap.pos[I] = -1;
+  }
+
+  /* seed the nodes of the interface elements */
+  for (e = 0; e < exo->num_elems; e++) {
+    if (!elem_on_isosurface(e, x, exo, ls->var, isoval))
+      continue;
+
+    for (k = exo->elem_node_pntr[e]; k < exo->elem_node_pntr[e + 1]; k++) {
+      I = exo->elem_node_list[k];
+      ie = Index_Solution(I, ls->var, 0, 0, -2, pg->imtrx);
+      if (ie != -1 && heap.pos[I] == -1) {
+        struct LS_Surf *closest = closest_surf(list, x, exo, &coord[DIM * I]);
+        dist[I] = fabs(closest->closest_point->distance);
+        for (a = 0; a < DIM; a++) {
+          cp[DIM * I + a] = closest->closest_point->x[a];
+        }
+        fm_heap_update(&heap, I);
+      }
+    }
+  }
+
+  /* the nearest interface of a processor boundary node may be off processor */
+  if (Num_Proc > 1) {
+    for (I = dpi->num_internal_nodes; I < num_total_nodes; I++) {
+      ie = Index_Solution(I, ls->var, 0, 0, -2, pg->imtrx);
+      if (ie != -1 && heap.pos[I] == -1 &&
+          (band == DBL_MAX || surf_list_within_band(list, x, exo, &coord[DIM * I], band))) {
+        struct LS_Surf *closest = closest_surf(list, x, exo, &coord[DIM * I]);
+        dist[I] = fabs(closest->closest_point->distance);
+        for (a = 0; a < DIM; a++) {
+          cp[DIM * I + a] = closest->closest_point->x[a];
+        }
+        fm_heap_update(&heap, I);
+      }
+    }
+  }
+
+  while (heap.size > 0) {
+    I = fm_heap_pop(&heap);
+    if (dist[I] > band)
+      break;
+    accepted[I] = TRUE;
+
+    for (l = exo->node_elem_pntr[I]; l < exo->node_elem_pntr[I + 1]; l++) {
+      e = exo->node_elem_list[l];
+      for (k = exo->elem_node_pntr[e]; k < exo->elem_node_pntr[e + 1]; k++) {
+        double d = 0.;
+
+        J = exo->elem_node_list[k];
+        if (accepted[J] || Index_Solution(J, ls->var, 0, 0, -2, pg->imtrx) == -1)
+          continue;
+
+        for (a = 0; a < pd->Num_Dim; a++) {
+          d += (coord[DIM * J + a] - cp[DIM * I + a]) * (coord[DIM * J + a] - cp[DIM * I + a]);
+        }
+        d = sqrt(d);
+        if (d < dist[J]) {
+          dist[J] = d;
+          for (a = 0; a < DIM; a++) {
+            cp[DIM * J + a] = cp[DIM * I + a];
+          }
+          fm_heap_update(&heap, J);
+        }
+      }
+    }
+  }
+
+  for (I = 0; I < num_total_nodes; I++) {
+    ie = Index_Solution(I, ls->var, 0, 0, -2, pg->imtrx);
+    if (ie != -1) {
+      double sign = (x[ie] - isoval < 0.) ? -1. : 1.;
+      if (accepted[I]) {
+        x[ie] = sign * dist[I];
+      } else if (band < DBL_MAX) {
+        x[ie] = sign * band;
+      }
+    }
+  }
+
+  safe_free((void *)coord);
+  safe_free((void *)cp);
+  safe_free((void *)dist);
+  safe_free((void *)accepted);
+  safe_free((void *)heap.node);
+  safe_free((void *)heap.pos);
+
+  if (DeformingMesh != -1) {
+    for (a = 0; a < pd->Num_Dim; a++)
+      safe_free((void *)Disp[a]);
+
+    safe_free((void *)Disp);
+  }
+}
+
 /***************************************************************************************/
 /***************************************************************************************/
 
@@ -1028,6 +1272,7 @@ void free_surf_list(struct LS_Surf_List **list_p) {
       list->start = list->current;
     }
 
+    free_surf_tree(&list->tree);
     safer_free((void **)list_p);
   }
 }
@@ -1047,12 +1292,354 @@ void free_subsurfs(struct LS_Surf_List *list) {
   return;
 }
 
+/*
+ * Closest surface searches over point and facet subsurfaces use a bounding
+ * volume hierarchy built once the (global) subsurface list is complete, so
+ * each query costs O(log facets) instead of a walk over the whole list.
+ */
+
+#define LS_SURF_TREE_MIN_SIZE  16
+#define LS_SURF_TREE_LEAF_SIZE 4
+
+/* Magnitude tolerance used when the closest surface is picked by confidence */
+#define LS_SURF_CONFIDENCE_TOL 1.e-5
+
+struct LS_Surf_Tree_Node {
+  double lo[DIM];
+  double hi[DIM];
+  int first; /* first entry of the tree order in this node */
+  int count; /* number of surfaces in a leaf, 0 for interior nodes */
+  int child[2];
+};
+
+struct LS_Surf_Search_Tree {
+  int dim;
+  int num_surfs;
+  struct LS_Surf **surfs; /* in list order */
+  double *lo;             /* [num_surfs * DIM] surface bounding boxes */
+  double *hi;
+  double *center;
+  int *order; /* list indices arranged by tree node */
+  int num_nodes;
+  struct LS_Surf_Tree_Node *nodes;
+  int *stack;
+  int *candidates;
+};
+
+/*
+ * To avoid sign errors we need to permit the possibility of making a very
+ * small magnitude error.  We need to pick the right surface when two
+ * surfaces are nominally the same distance away but one is more confident
+ * than the other about the sign of the distance function.  If the
+ * tolerance is too small, we may pick a surface that has incorrect sign
+ * information resulting in a large error in the distance function.  If it
+ * is too large, we may make too large of errors in the magnitude of the
+ * distance function by picking a surface that is further away just cuz it
+ * is more confident about the sign.
+ */
+static int surf_is_closer(double distance,
+                          double confidence,
+                          double closest_distance,
+                          double closest_confidence) {
+  double tol = LS_SURF_CONFIDENCE_TOL;
+  double abs_closest_distance = fabs(closest_distance);
+  double abs_distance = fabs(distance);
+
+  if (confidence == closest_confidence)
+    return (abs_distance < abs_closest_distance);
+  if (confidence < closest_confidence)
+    return (abs_distance < (1. - tol) * abs_closest_distance);
+  if (confidence > closest_confidence)
+    return (abs_distance < (1. + tol) * abs_closest_distance);
+  return FALSE;
+}
+
+static int surf_bounding_box(struct LS_Surf *surf, double lo[DIM], double hi[DIM]) {
+  int a;
+
+  switch (surf->type) {
+  case LS_SURF_POINT: {
+    struct LS_Surf_Point_Data *s = (struct LS_Surf_Point_Data *)surf->data;
+    for (a = 0; a < DIM; a++) {
+      lo[a] = hi[a] = s->x[a];
+    }
+  }
+    return TRUE;
+
+  case LS_SURF_FACET: {
+    struct LS_Surf_Facet_Data *s = (struct LS_Surf_Facet_Data *)surf->data;
+    struct LS_Surf_Point_Data *s1, *s2;
+
+    if (s->num_points != 2 || surf->subsurf_list == NULL || surf->subsurf_list->size != 2)
+      return FALSE;
+
+    s1 = (struct LS_Surf_Point_Data *)surf->subsurf_list->start->data;
+    s2 = (struct LS_Surf_Point_Data *)surf->subsurf_list->start->next->data;
+    for (a = 0; a < DIM; a++) {
+      lo[a] = MIN(s1->x[a], s2->x[a]);
+      hi[a] = MAX(s1->x[a], s2->x[a]);
+    }
+  }
+    return TRUE;
+
+  default:
+    return FALSE;
+  }
+}
+
+static double *Surf_Tree_Sort_Center = NULL;
+static int Surf_Tree_Sort_Axis = 0;
+
+static int compare_surf_tree_center(const void *a, const void *b) {
+  double ca = Surf_Tree_Sort_Center[DIM * (*(const int *)a) + Surf_Tree_Sort_Axis];
+  double cb = Surf_Tree_Sort_Center[DIM * (*(const int *)b) + Surf_Tree_Sort_Axis];
+
+  return (ca < cb) ? -1 : ((ca > cb) ? 1 : 0);
+}
+
+/* top down build, splitting at the median center along the longest axis */
+static int build_surf_tree_node(struct LS_Surf_Search_Tree *tree, int first, int count) {
+  int a, i, axis;
+  int n = tree->num_nodes++;
+  struct LS_Surf_Tree_Node *node = &tree->nodes[n];
+  double clo[DIM], chi[DIM];
+
+  node->first = first;
+  for (a = 0; a < DIM; a++) {
+    node->lo[a] = clo[a] = DBL_MAX;
+    node->hi[a] = chi[a] = -DBL_MAX;
+  }
+  for (i = first; i < first + count; i++) {
+    int k = tree->order[i];
+    for (a = 0; a < DIM; a++) {
+      node->lo[a] = MIN(node->lo[a], tree->lo[DIM * k + a]);
+      node->hi[a] = MAX(node->hi[a], tree->hi[DIM * k + a]);
+      clo[a] = MIN(clo[a], tree->center[DIM * k + a]);
+      chi[a] = MAX(chi[a], tree->center[DIM * k + a]);
+    }
+  }
+
+  if (count <= LS_SURF_TREE_LEAF_SIZE) {
+    node->count = count;
+    node->child[0] = node->child[1] = -1;
+    return n;
+  }
+
+  axis = 0;
+  for (a = 1; a < tree->dim; a++) {
+    if (chi[a] - clo[a] > chi[axis] - clo[axis])
+      axis = a;
+  }
+  Surf_Tree_Sort_Center = tree->center;
+  Surf_Tree_Sort_Axis = axis;
+  qsort(&tree->order[first], count, sizeof(int), compare_surf_tree_center);
+
+  node->count = 0;
+  node->child[0] = build_surf_tree_node(tree, first, count / 2);
+  node->child[1] = build_surf_tree_node(tree, first + count / 2, count - count / 2);
+  return n;
+}
+
+static void free_surf_tree(struct LS_Surf_Search_Tree **tree_p) {
+  struct LS_Surf_Search_Tree *tree = *tree_p;
+
+  if (tree != NULL) {
+    safer_free((void **)&tree->surfs);
+    safer_free((void **)&tree->lo);
+    safer_free((void **)&tree->hi);
+    safer_free((void **)&tree->center);
+    safer_free((void **)&tree->order);
+    safer_free((void **)&tree->nodes);
+    safer_free((void **)&tree->stack);
+    safer_free((void **)&tree->candidates);
+    safer_free((void **)tree_p);
+  }
+}
+
+/*
+ * Build the search tree for a list of point or 2-D facet subsurfaces.  Small
+ * lists and lists with other surface types are left to the linear search.
+ */
+static void build_surf_tree(struct LS_Surf_List *list) {
+  int a, k;
+  struct LS_Surf *surf;
+  struct LS_Surf_Search_Tree *tree;
+
+  free_surf_tree(&list->tree);
+
+  if (list->size < LS_SURF_TREE_MIN_SIZE)
+    return;
+
+  tree = (struct LS_Surf_Search_Tree *)smalloc(sizeof(struct LS_Surf_Search_Tree));
+  tree->dim = pd->Num_Dim;
+  tree->num_surfs = list->size;
+  tree->surfs = (struct LS_Surf **)smalloc(list->size * sizeof(struct LS_Surf *));
+  tree->lo = (double *)smalloc(DIM * list->size * sizeof(double));
+  tree->hi = (double *)smalloc(DIM * list->size * sizeof(double));
+  tree->center = (double *)smalloc(DIM * list->size * sizeof(double));
+  tree->order = (int *)smalloc(list->size * sizeof(int));
+  tree->nodes =
+      (struct LS_Surf_Tree_Node *)smalloc(2 * list->size * sizeof(struct LS_Surf_Tree_Node));
+  tree->stack = (int *)smalloc(2 * list->size * sizeof(int));
+  tree->candidates = (int *)smalloc(list->size * sizeof(int));
+  tree->num_nodes = 0;
+
+  for (surf = list->start, k = 0; surf != NULL; surf = surf->next, k++) {
+    if (!surf_bounding_box(surf, &tree->lo[DIM * k], &tree->hi[DIM * k])) {
+      free_surf_tree(&tree);
+      return;
+    }
+    tree->surfs[k] = surf;
+    tree->order[k] = k;
+    for (a = 0; a < DIM; a++) {
+      tree->center[DIM * k + a] = 0.5 * (tree->lo[DIM * k + a] + tree->hi[DIM * k + a]);
+    }
+  }
+
+  build_surf_tree_node(tree, 0, tree->num_surfs);
+  list->tree = tree;
+}
+
+static double surf_tree_box_distance(const struct LS_Surf_Search_Tree *tree,
+                                     const struct LS_Surf_Tree_Node *node,
+                                     const double r[DIM]) {
+  int a;
+  double d2 = 0.;
+
+  for (a = 0; a < tree->dim; a++) {
+    double gap = MAX(0., MAX(node->lo[a] - r[a], r[a] - node->hi[a]));
+    d2 += gap * gap;
+  }
+  return sqrt(d2);
+}
+
+static int compare_int(const void *a, const void *b) {
+  return *(const int *)a - *(const int *)b;
+}
+
+/*
+ * Tree version of the linear search in closest_surf: every surface whose
+ * distance magnitude could win the confidence comparison against the
+ * nearest one is collected and compared in list order.
+ */
+static struct LS_Surf *
+closest_surf_tree(struct LS_Surf_Search_Tree *tree, double *x, Exo_DB *exo, double r[DIM]) {
+  double tol = LS_SURF_CONFIDENCE_TOL;
+  double slack = (1. + tol) / (1. - tol);
+  double best = DBL_MAX;
+  int num_candidates = 0;
+  int top = 0;
+  int i, n;
+  struct LS_Surf *closest;
+
+  tree->stack[top++] = 0;
+  while (top > 0) {
+    struct LS_Surf_Tree_Node *node = &tree->nodes[tree->stack[--top]];
+
+    if (best < DBL_MAX && surf_tree_box_distance(tree, node, r) > slack * best)
+      continue;
+
+    if (node->count > 0) {
+      for (i = node->first; i < node->first + node->count; i++) {
+        int k = tree->order[i];
+        double abs_distance;
+
+        find_surf_closest_point(tree->surfs[k], x, exo, r);
+        abs_distance = fabs(tree->surfs[k]->closest_point->distance);
+        best = MIN(best, abs_distance);
+        if (abs_distance <= slack * best) {
+          tree->candidates[num_candidates++] = k;
+        }
+      }
+    } else {
+      /* visit the nearer child first */
+      struct LS_Surf_Tree_Node *c0 = &tree->nodes[node->child[0]];
+      struct LS_Surf_Tree_Node *c1 = &tree->nodes[node->child[1]];
+      if (surf_tree_box_distance(tree, c0, r) <= surf_tree_box_distance(tree, c1, r)) {
+        tree->stack[top++] = node->child[1];
+        tree->stack[top++] = node->child[0];
+      } else {
+        tree->stack[top++] = node->child[0];
+        tree->stack[top++] = node->child[1];
+      }
+    }
+  }
+
+  for (i = 0, n = 0; i < num_candidates; i++) {
+    int k = tree->candidates[i];
+    if (fabs(tree->surfs[k]->closest_point->distance) <= slack * best) {
+      tree->candidates[n++] = k;
+    }
+  }
+  qsort(tree->candidates, n, sizeof(int), compare_int);
+
+  closest = tree->surfs[tree->candidates[0]];
+  for (i = 1; i < n; i++) {
+    struct LS_Surf *surf = tree->surfs[tree->candidates[i]];
+    if (surf_is_closer(surf->closest_point->distance, surf->closest_point->confidence,
+                       closest->closest_point->distance, closest->closest_point->confidence)) {
+      closest = surf;
+    }
+  }
+  return (closest);
+}
+
+/* TRUE if some surface of the tree lies within band of r */
+static int surf_tree_within(
+    struct LS_Surf_Search_Tree *tree, double *x, Exo_DB *exo, double r[DIM], double band) {
+  int i;
+  int top = 0;
+
+  tree->stack[top++] = 0;
+  while (top > 0) {
+    struct LS_Surf_Tree_Node *node = &tree->nodes[tree->stack[--top]];
+
+    if (surf_tree_box_distance(tree, node, r) > band)
+      continue;
+
+    if (node->count > 0) {
+      for (i = node->first; i < node->first + node->count; i++) {
+        struct LS_Surf *surf = tree->surfs[tree->order[i]];
+        find_surf_closest_point(surf, x, exo, r);
+        if (fabs(surf->closest_point->distance) <= band)
+          return TRUE;
+      }
+    } else {
+      tree->stack[top++] = node->child[0];
+      tree->stack[top++] = node->child[1];
+    }
+  }
+  return FALSE;
+}
+
+/*
+ * Narrow band test for renormalization, TRUE unless every surface in the list
+ * is an isosurface with a search tree and none of them comes within band of r.
+ */
+static int surf_list_within_band(
+    struct LS_Surf_List *list, double *x, Exo_DB *exo, double r[DIM], double band) {
+  struct LS_Surf *surf;
+
+  for (surf = list->start; surf != NULL; surf = surf->next) {
+    if (surf->type != LS_SURF_ISOSURFACE || surf->subsurf_list == NULL ||
+        surf->subsurf_list->tree == NULL)
+      return TRUE;
+  }
+  for (surf = list->start; surf != NULL; surf = surf->next) {
+    if (surf_tree_within(surf->subsurf_list->tree, x, exo, r, band))
+      return TRUE;
+  }
+  return FALSE;
+}
+
 struct LS_Surf *closest_surf(struct LS_Surf_List *list, double *x, Exo_DB *exo, double r[DIM]) {
   struct LS_Surf *surf, *closest;
   double distance, closest_distance;
   double confidence, closest_confidence;
-  double abs_closest_distance, abs_distance;
-  double tol = 1.e-5;
+
+  if (list->tree != NULL) {
+    return closest_surf_tree(list->tree, x, exo, r);
+  }
 
   surf = list->start;
   find_surf_closest_point(surf, x, exo, r);
@@ -1067,27 +1654,11 @@ struct LS_Surf *closest_surf(struct LS_Surf_List *list, double *x, Exo_DB *exo,
     distance = surf->closest_point->distance;
     confidence = surf->closest_point->confidence;
 
-    /* Hopefully not too confusing here.
-     * To avoid sign errors we need to permit the possibility of making
-     * a very small magnitude error.  We need to catch pick the right
-     * surface when two surface are nominally the same distance away
-     * but one is more confident than the other about the sign of the
-     * distance function.  The tolerance for error in the magnitude is
-     * set in the variable tol.  If it is too small, we may pick a surface
-     * that has incorrect sign information resulting in a large error in
-     * the distance function.  If it is too large, we may make too large
-     * or errors in the magnitude of the distance function by picking a
-     * surface that is further away just cuz it is more confident about the
-     * sign.
-     * If we had a narrow band approach this just wouldn't matter since
-     * the magnitude errors will only happen relatively far from the interface.
+    /* If we had a narrow band approach the confidence comparison just
+     * wouldn't matter since the magnitude errors will only happen
+     * relatively far from the interface.
      */
-
-    abs_closest_distance = fabs(closest_distance);
-    abs_distance = fabs(distance);
-    if (((confidence == closest_confidence) && (abs_distance < abs_closest_distance)) ||
-        ((confidence < closest_confidence) && (abs_distance < (1. - tol) * abs_closest_distance)) ||
-        ((confidence > closest_confidence) && (abs_distance < (1. + tol) * abs_closest_distance))) {
+    if (surf_is_closer(distance, confidence, closest_distance, closest_confidence)) {
       closest = surf;
       closest_distance = distance;
       closest_confidence = confidence;
@@ -1738,6 +2309,9 @@ void create_subsurfs(struct LS_Surf_List *list, double *x, Exo_DB *exo) {
         assemble_Global_surf_list(surf->subsurf_list);
     }
 
+    if (surf->subsurf_list != NULL)
+      build_surf_tree(surf->subsurf_list);
+
     surf = surf->next;
   }
 
@@ -3810,6 +4384,9 @@ struct LS_Surf *create_surf(int type)
 void append_surf(struct LS_Surf_List *list, struct LS_Surf *surf)
 /* append surface to list */
 {
+  /* the search tree no longer covers the list */
+  free_surf_tree(&list->tree);
+
   if (list->size == 0) {
     list->start = surf;
   } else {
@@ -3883,6 +4460,7 @@ struct LS_Surf_List *create_surf_list(void)
 
   list->size = 0;
   list->start = list->end = list->current = NULL;
+  list->tree = NULL;
 
   return list;
 }
@@ -10620,6 +11198,9 @@ void check_xfem_contribution(
       }
     }
   } else if (ams->GomaMatrixData != NULL) {
+    GomaSparseMatrix matrix = (GomaSparseMatrix)ams->GomaMatrixData;
+    int num_zero_rows = 0;
+    int *zero_rows = alloc_int_1(N, 0);
     for (irow = 0; irow < N; irow++) {
       eqn = idv[pg->imtrx][irow][0];
       if (eqn == R_MASS || eqn == R_ENERGY) {
@@ -10628,8 +11209,7 @@ void check_xfem_contribution(
         eps = eps_standard;
       }
       if (fabs(xfem->active_vol[irow]) < eps * xfem->tot_vol[irow]) {
-        GomaSparseMatrix matrix = (GomaSparseMatrix)ams->GomaMatrixData;
-        matrix->zero_global_row_set_diag(matrix, matrix->global_ids[irow]);
+        zero_rows[num_zero_rows++] = irow;
         resid[irow] = x[irow] - x_old_static[irow];
 
         if (FALSE && xfem->active_vol[irow] != 0.) /* debugging */
@@ -10639,6 +11219,15 @@ void check_xfem_contribution(
         }
       }
     }
+    /* zero the rows in one pass when the format supports it */
+    if (matrix->zero_local_rows != NULL) {
+      matrix->zero_local_rows(matrix, num_zero_rows, zero_rows, TRUE);
+    } else {
+      for (int i = 0; i < num_zero_rows; i++) {
+        matrix->zero_global_row_set_diag(matrix, matrix->global_ids[zero_rows[i]]);
+      }
+    }
+    safer_free((void **)&zero_rows);
   } else {
     GOMA_EH(GOMA_ERROR, "Unsupported matrix format in check_xfem_contribution");
   }
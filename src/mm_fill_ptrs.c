@@ -34,6 +34,7 @@
 #include "mm_as_const.h"
 #include "mm_as_structs.h"
 #include "mm_elem_block_structs.h"
+#include "mm_fill_block.h"
 #include "mm_fill_ls.h"
 #include "mm_fill_stress.h"
 #include "mm_mp.h"
@@ -209,6 +210,7 @@ int load_ei(const int elem, const Exo_DB *exo, struct Element_Indices *ei_ptr_fi
   int iconnect_ptr_Parent;
   int num_local_nodes_Parent;
   struct Element_Indices *ei_ptr;
+  const Element_Block_Context *block_ctx;
 
   int mode = 0;
   ei_ptr = ei[imtrx];
@@ -228,10 +230,15 @@ int load_ei(const int elem, const Exo_DB *exo, struct Element_Indices *ei_ptr_fi
   }
 
   /*
-   * Look up the element block index for the current element
+   * Look up the element block index for the current element, inside the
+   * block loop of matrix_fill_full it is known from the block context
    */
-
-  ei_ptr->elem_blk_index = find_elemblock_index(elem, exo);
+  block_ctx = BLOCK_CONTEXT_HAS_ELEM(elem) ? Current_Block_Context : NULL;
+  if (block_ctx != NULL) {
+    ei_ptr->elem_blk_index = block_ctx->ebn;
+  } else {
+    ei_ptr->elem_blk_index = find_elemblock_index(elem, exo);
+  }
 
   /*
    * Store the  variable, current_EB_ptr, which points to the
@@ -283,18 +290,25 @@ int load_ei(const int elem, const Exo_DB *exo, struct Element_Indices *ei_ptr_fi
    */
   ei_ptr->mn = mn;
   ei_ptr->ielem = elem;
-  ei_ptr->ielem_type = Elem_Type(exo, elem);
-  ei_ptr->ielem_shape = type2shape(ei_ptr->ielem_type);
-  ei_ptr->elem_blk_index = find_elemblock_index(elem, exo);
   ei_ptr->elem_blk_id = exo->eb_id[ei_ptr->elem_blk_index];
-  ei_ptr->ielem_dim = elem_info(NDIM, ei_ptr->ielem_type);
+  if (block_ctx != NULL) {
+    ei_ptr->ielem_type = block_ctx->ielem_type;
+    ei_ptr->ielem_shape = block_ctx->ielem_shape;
+    ei_ptr->ielem_dim = block_ctx->ielem_dim;
+    ei_ptr->num_local_nodes = block_ctx->num_local_nodes;
+    ei_ptr->num_sides = block_ctx->num_sides;
+  } else {
+    ei_ptr->ielem_type = Elem_Type(exo, elem);
+    ei_ptr->ielem_shape = type2shape(ei_ptr->ielem_type);
+    ei_ptr->ielem_dim = elem_info(NDIM, ei_ptr->ielem_type);
+    ei_ptr->num_local_nodes = elem_info(NNODES, ei_ptr->ielem_type);
+    ei_ptr->num_sides = shape2sides(ei_ptr->ielem_shape);
+  }
   /*
    *   Store the pointer to the beginning of this element's
    *   connectivity list
    */
   ei_ptr->iconnect_ptr = Proc_Connect_Ptr[elem];
-  ei_ptr->num_local_nodes = elem_info(NNODES, ei_ptr->ielem_type);
-  ei_ptr->num_sides = shape2sides(ei_ptr->ielem_shape);
 
   /*
    *  ei_ptr->deforming_mesh is TRUE if there are mesh equations on
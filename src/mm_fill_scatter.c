@@ -0,0 +1,260 @@
+/************************************************************************ *
+* Goma - Multiphysics finite element software                             *
+* Sandia National Laboratories                                            *
+*                                                                         *
+* Copyright (c) 2022 Goma Developers, National Technology & Engineering   *
+*               Solutions of Sandia, LLC (NTESS)                          *
+*                                                                         *
+* Under the terms of Contract DE-NA0003525, the U.S. Government retains   *
+* certain rights in this software.                                        *
+*                                                                         *
+* This software is distributed under the GNU General Public License.      *
+* See LICENSE file.                                                       *
+\************************************************************************/
+
+/*
+ * mm_fill_scatter.c -- element to global scatter maps for loading the lec
+ *
+ * A scatter map is built the first time an element is loaded for a given
+ * matrix, from the same ei[] information and Index_Solution() lookups
+ * that load_lec() used to repeat on every assembly. Rows and column
+ * blocks are stored in the order load_lec() visits them, so the order in
+ * which contributions are summed into the global system is unchanged.
+ *
+ * The maps are dropped by lec_scatter_free(), which must be called
+ * whenever the unknown map changes (problem teardown and remeshing).
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "mm_as.h"
+#include "mm_as_const.h"
+#include "mm_as_structs.h"
+#include "mm_eh.h"
+#include "mm_fill_scatter.h"
+#include "mm_unknown_map.h"
+#include "rf_allo.h"
+#include "rf_fem.h"
+#include "rf_fem_const.h"
+#include "rf_masks.h"
+#include "std.h"
+
+static struct Lec_Scatter **Lec_Scatter_Table[MAX_NUM_MATRICES];
+static int Lec_Scatter_Table_Size[MAX_NUM_MATRICES];
+
+static int *Lec_Scatter_Column_Map[MAX_NUM_MATRICES];
+static int Lec_Scatter_Column_Map_Size[MAX_NUM_MATRICES];
+
+/*
+ * Element indices that own the columns of variable v. For most elements
+ * this is the element itself; shell and multi-block couplings may point
+ * at a neighboring element.
+ */
+static struct Element_Indices *column_ei(const int ielem, const int imtrx, const int v) {
+  struct Element_Indices *ei_ptr = ei[imtrx];
+  if (ei[imtrx]->owningElementForColVar[v] != ielem) {
+    if (ei[imtrx]->owningElementForColVar[v] != -1) {
+      ei_ptr = ei[imtrx]->owningElement_ei_ptr[v];
+      if (ei_ptr == NULL) {
+        GOMA_EH(GOMA_ERROR, "ei slave pointer is null");
+      }
+    }
+  }
+  return ei_ptr;
+}
+
+/*
+ * Does any owned row of the element couple to variable v?
+ */
+static int column_needed(const struct Lec_Scatter *scatter, const int v, const int imtrx) {
+  int r;
+  for (r = 0; r < scatter->nrows; r++) {
+    if (Inter_Mask[imtrx][scatter->rows[LEC_SCATTER_ROW_SIZE * r + LEC_SCATTER_ROW_EQN]][v]) {
+      return TRUE;
+    }
+  }
+  return FALSE;
+}
+
+static struct Lec_Scatter *lec_scatter_build(const int ielem, const int imtrx) {
+  int e, v, i, j, k, pe, pv, ke, kv, ledof, nspec;
+  int row, blk, col, je;
+  struct Element_Indices *eip = ei[imtrx];
+  struct Element_Indices *ei_ptr;
+  struct Lec_Scatter *scatter;
+
+  scatter = calloc(1, sizeof(struct Lec_Scatter));
+  if (scatter == NULL) {
+    GOMA_EH(GOMA_ERROR, "Could not allocate lec scatter map");
+    return NULL;
+  }
+
+  /*
+   * Size the map
+   */
+  for (e = V_FIRST; e < V_LAST; e++) {
+    if (upd->ep[imtrx][e] == -1)
+      continue;
+    nspec = (e == R_MASS) ? upd->Max_Num_Species_Eqn : 1;
+    for (i = 0; i < eip->dof[e]; i++) {
+      ledof = eip->lvdof_to_ledof[e][i];
+      if (eip->owned_ledof[ledof]) {
+        scatter->nrows += nspec;
+      }
+    }
+  }
+
+  scatter->rows = alloc_int_1(MAX(LEC_SCATTER_ROW_SIZE * scatter->nrows, 1), -1);
+
+  /*
+   * Rows, in the order load_lec visits them
+   */
+  row = 0;
+  for (e = V_FIRST; e < V_LAST; e++) {
+    pe = upd->ep[imtrx][e];
+    if (pe == -1)
+      continue;
+    if (e == R_MASS) {
+      for (ke = 0; ke < upd->Max_Num_Species_Eqn; ke++) {
+        pe = MAX_PROB_VAR + ke;
+        for (i = 0; i < eip->dof[e]; i++) {
+          ledof = eip->lvdof_to_ledof[e][i];
+          if (eip->owned_ledof[ledof]) {
+            k = LEC_SCATTER_ROW_SIZE * row++;
+            scatter->rows[k + LEC_SCATTER_ROW_INDEX] =
+                Index_Solution(eip->gnn_list[e][i], e, ke, eip->Baby_Dolphin[e][i],
+                               eip->matID_ledof[ledof], imtrx);
+            GOMA_EH(scatter->rows[k + LEC_SCATTER_ROW_INDEX], "Bad eqn index.");
+            scatter->rows[k + LEC_SCATTER_ROW_PE] = pe;
+            scatter->rows[k + LEC_SCATTER_ROW_DOF] = i;
+            scatter->rows[k + LEC_SCATTER_ROW_EQN] = e;
+          }
+        }
+      }
+    } else {
+      for (i = 0; i < eip->dof[e]; i++) {
+        ledof = eip->lvdof_to_ledof[e][i];
+        if (eip->owned_ledof[ledof]) {
+          k = LEC_SCATTER_ROW_SIZE * row++;
+          scatter->rows[k + LEC_SCATTER_ROW_INDEX] = eip->gun_list[e][i];
+          scatter->rows[k + LEC_SCATTER_ROW_PE] = pe;
+          scatter->rows[k + LEC_SCATTER_ROW_DOF] = i;
+          scatter->rows[k + LEC_SCATTER_ROW_EQN] = e;
+        }
+      }
+    }
+  }
+
+  /*
+   * Column blocks, one per variable (and species) that some row couples to
+   */
+  for (v = V_FIRST; v < V_LAST; v++) {
+    if (upd->vp[imtrx][v] == -1 || !column_needed(scatter, v, imtrx))
+      continue;
+    ei_ptr = column_ei(ielem, imtrx, v);
+    nspec = (v == MASS_FRACTION) ? upd->Max_Num_Species_Eqn : 1;
+    scatter->nblocks += nspec;
+    scatter->ncols += nspec * ei_ptr->dof[v];
+  }
+
+  scatter->blocks = alloc_int_1(MAX(LEC_SCATTER_BLK_SIZE * scatter->nblocks, 1), -1);
+  scatter->cols = alloc_int_1(MAX(scatter->ncols, 1), -1);
+
+  blk = 0;
+  col = 0;
+  for (v = V_FIRST; v < V_LAST; v++) {
+    pv = upd->vp[imtrx][v];
+    if (pv == -1 || !column_needed(scatter, v, imtrx))
+      continue;
+    ei_ptr = column_ei(ielem, imtrx, v);
+    nspec = (v == MASS_FRACTION) ? upd->Max_Num_Species_Eqn : 1;
+    for (kv = 0; kv < nspec; kv++) {
+      k = LEC_SCATTER_BLK_SIZE * blk++;
+      scatter->blocks[k + LEC_SCATTER_BLK_VAR] = v;
+      scatter->blocks[k + LEC_SCATTER_BLK_PV] = (v == MASS_FRACTION) ? MAX_PROB_VAR + kv : pv;
+      scatter->blocks[k + LEC_SCATTER_BLK_START] = col;
+      scatter->blocks[k + LEC_SCATTER_BLK_NCOL] = ei_ptr->dof[v];
+      for (j = 0; j < ei_ptr->dof[v]; j++) {
+        ledof = ei_ptr->lvdof_to_ledof[v][j];
+        je = Index_Solution(ei_ptr->gnn_list[v][j], v, kv, ei_ptr->Baby_Dolphin[v][j],
+                            ei_ptr->matID_ledof[ledof], imtrx);
+        GOMA_EH(je, "Bad var index.");
+        if (v != MASS_FRACTION && je != ei_ptr->ieqn_ledof[ledof]) {
+          fprintf(stderr, "Oh fiddlesticks: je = %d, je_new = %d\n", je,
+                  ei_ptr->ieqn_ledof[ledof]);
+          GOMA_EH(GOMA_ERROR, "LEC Indexing error");
+        }
+        scatter->cols[col++] = je;
+      }
+    }
+  }
+
+  return scatter;
+}
+
+/*
+ * Return the scatter map of element ielem for matrix imtrx, building it
+ * from the current ei[imtrx] if this is the first time the element is
+ * seen.
+ */
+const struct Lec_Scatter *lec_scatter_get(const int ielem, const int imtrx) {
+  int n;
+
+  if (ielem >= Lec_Scatter_Table_Size[imtrx]) {
+    n = MAX(2 * Lec_Scatter_Table_Size[imtrx], ielem + 1);
+    Lec_Scatter_Table[imtrx] =
+        realloc(Lec_Scatter_Table[imtrx], n * sizeof(struct Lec_Scatter *));
+    if (Lec_Scatter_Table[imtrx] == NULL) {
+      GOMA_EH(GOMA_ERROR, "Could not allocate lec scatter table");
+      return NULL;
+    }
+    for (int i = Lec_Scatter_Table_Size[imtrx]; i < n; i++) {
+      Lec_Scatter_Table[imtrx][i] = NULL;
+    }
+    Lec_Scatter_Table_Size[imtrx] = n;
+  }
+
+  if (Lec_Scatter_Table[imtrx][ielem] == NULL) {
+    Lec_Scatter_Table[imtrx][ielem] = lec_scatter_build(ielem, imtrx);
+  }
+
+  return Lec_Scatter_Table[imtrx][ielem];
+}
+
+/*
+ * Work array mapping a processor unknown number to a position in a
+ * sparse matrix row. Entries are -1 on return and must be reset to -1 by
+ * the caller after use.
+ */
+int *lec_scatter_column_map(const int imtrx, const int ncols) {
+  if (ncols > Lec_Scatter_Column_Map_Size[imtrx]) {
+    safer_free((void **)&Lec_Scatter_Column_Map[imtrx]);
+    Lec_Scatter_Column_Map[imtrx] = alloc_int_1(ncols, -1);
+    Lec_Scatter_Column_Map_Size[imtrx] = ncols;
+  }
+  return Lec_Scatter_Column_Map[imtrx];
+}
+
+void lec_scatter_free(void) {
+  int imtrx, i;
+  struct Lec_Scatter *scatter;
+
+  for (imtrx = 0; imtrx < MAX_NUM_MATRICES; imtrx++) {
+    for (i = 0; i < Lec_Scatter_Table_Size[imtrx]; i++) {
+      scatter = Lec_Scatter_Table[imtrx][i];
+      if (scatter != NULL) {
+        safer_free((void **)&scatter->rows);
+        safer_free((void **)&scatter->blocks);
+        safer_free((void **)&scatter->cols);
+        free(scatter);
+      }
+    }
+    free(Lec_Scatter_Table[imtrx]);
+    Lec_Scatter_Table[imtrx] = NULL;
+    Lec_Scatter_Table_Size[imtrx] = 0;
+
+    safer_free((void **)&Lec_Scatter_Column_Map[imtrx]);
+    Lec_Scatter_Column_Map_Size[imtrx] = 0;
+  }
+}
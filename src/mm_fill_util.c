@@ -138,7 +138,7 @@ static int var_if_interp_type_enabled(PROBLEM_DESCRIPTION_STRUCT *pd_ptr, int in
  */
 int beer_belly(void) {
   int status = 0, i, j, k, n, t, dim, pdim, mdof, index, node, si;
-  int DeformingMesh, ShapeVar;
+  int DeformingMesh, MeshDerivs, ShapeVar;
   struct Basis_Functions *MapBf;
   size_t v_length;
   dbl f, g, sum;
@@ -167,6 +167,12 @@ int beer_belly(void) {
     DeformingMesh = ei[imtrx]->deforming_mesh;
   }
 
+  /*
+   * The mesh derivatives of J, B and detJ only feed Jacobian entries, a
+   * residual-only fill skips them.
+   */
+  MeshDerivs = DeformingMesh && af->Assemble_Jacobian;
+
   if ((si = in_list(pd->IntegrationMap, 0, Num_Interpolations, Unique_Interpolations)) == -1) {
     GOMA_EH(GOMA_ERROR, "Seems to be a problem finding the IntegrationMap interpolation.");
   }
@@ -365,7 +371,7 @@ int beer_belly(void) {
     }
     MapBf->detJ = sqrt(sum);
 
-    if (DeformingMesh) {
+    if (MeshDerivs) {
       for (j = 0; j < pdim; j++) {
         for (k = 0; k < ei[upd->matrix_index[R_MESH1]]->dof[R_MESH1]; k++) {
           MapBf->dJ[0][j][j][k] = bf[R_MESH1]->dphidxi[k][0];
@@ -394,7 +400,7 @@ int beer_belly(void) {
      * to each degree of freedom for mesh displacement components.
      */
 
-    if (DeformingMesh) {
+    if (MeshDerivs) {
       for (i = 0; i < dim; i++) {
         for (j = 0; j < pdim; j++) {
           for (n = 0; n < ei[upd->matrix_index[R_MESH1]]->dof[R_MESH1]; n++) {
@@ -478,7 +484,7 @@ int beer_belly(void) {
     MapBf->B[2][2] =
         (MapBf->J[0][0] * MapBf->J[1][1] - MapBf->J[1][0] * MapBf->J[0][1]) / (MapBf->detJ);
 
-    if (DeformingMesh) {
+    if (MeshDerivs) {
       /*
        * Derivatives of elemental Jacobian matrix with respect
        * to each degree of freedom for mesh displacement components.
@@ -610,7 +616,7 @@ int beer_belly(void) {
         for (j = 0; j < pdim; j++) {
           bfd[t]->B[i][j] = MapBf->B[i][j];
 
-          if (DeformingMesh) {
+          if (MeshDerivs) {
             for (k = 0; k < pdim; k++) {
               for (n = 0; n < ei[upd->matrix_index[R_MESH1]]->dof[R_MESH1]; n++) {
                 bfd[t]->d_det_J_dm[k][n] = MapBf->d_det_J_dm[k][n];
@@ -2604,6 +2610,105 @@ int load_bf_mesh_derivs(void) {
 /****************************************************************************/
 /****************************************************************************/
 
+/*
+ * Reference element basis function table.
+ *
+ * For all but a few interpolations the values of phi and d(phi)/d(xi) at
+ * a point depend only on the element type, shape, interpolation and the
+ * local coordinates of the point. Since the same Gauss points are visited
+ * for every element on every Newton iteration, load_basis_functions()
+ * remembers the values the first time a point is seen and copies them
+ * afterwards. Entries are keyed on the exact bit pattern of xi, so
+ * quadrature points whose location varies from element to element (level
+ * set subgrid and subelement integration) simply never hit; for those
+ * cases the table is bypassed altogether so that it does not fill up.
+ *
+ * Interpolations that depend on more than the reference element (XFEM
+ * enrichment, subparametric I_SP which looks at the element's edge nodes)
+ * are always evaluated on the fly.
+ */
+
+#define BASIS_TAB_SIZE  1024 /* Number of table slots, power of two */
+#define BASIS_TAB_PROBE 8    /* Slots examined before giving up */
+
+struct Basis_Tab_Entry {
+  int used;
+  int ielem_type;
+  int element_shape;
+  int interpolation;
+  int dim;
+  dbl xi[DIM];
+  int ndof; /* -1 until filled */
+  int node[MDE];
+  int jdof[MDE];
+  dbl phi[MDE];
+  dbl dphidxi[MDE][DIM];
+};
+
+static struct Basis_Tab_Entry *Basis_Tab = NULL;
+
+static unsigned int basis_tab_hash(const double xi[], int ielem_type, int interpolation) {
+  unsigned long long bits, h = 1469598103934665603ULL;
+  int k;
+  for (k = 0; k < DIM; k++) {
+    memcpy(&bits, &xi[k], sizeof(bits));
+    h = (h ^ bits) * 1099511628211ULL;
+  }
+  h = (h ^ (unsigned long long)ielem_type) * 1099511628211ULL;
+  h = (h ^ (unsigned long long)interpolation) * 1099511628211ULL;
+  return (unsigned int)(h ^ (h >> 32));
+}
+
+static struct Basis_Tab_Entry *
+basis_tab_find(const double xi[], int ielem_type, const struct Basis_Functions *bf_ptr) {
+  int k, slot;
+  struct Basis_Tab_Entry *e;
+
+  if (is_xfem_interp(bf_ptr->interpolation) || bf_ptr->interpolation == I_SP) {
+    return NULL;
+  }
+  if (ls != NULL && (ls->Integration_Depth > 0 || ls->SubElemIntegration)) {
+    return NULL;
+  }
+
+  if (Basis_Tab == NULL) {
+    Basis_Tab = calloc(BASIS_TAB_SIZE, sizeof(struct Basis_Tab_Entry));
+    if (Basis_Tab == NULL) {
+      return NULL;
+    }
+  }
+
+  slot = (int)(basis_tab_hash(xi, ielem_type, bf_ptr->interpolation) & (BASIS_TAB_SIZE - 1));
+  for (k = 0; k < BASIS_TAB_PROBE; k++) {
+    e = &Basis_Tab[(slot + k) & (BASIS_TAB_SIZE - 1)];
+    if (!e->used) {
+      e->used = TRUE;
+      e->ielem_type = ielem_type;
+      e->element_shape = bf_ptr->element_shape;
+      e->interpolation = bf_ptr->interpolation;
+      e->dim = pd->Num_Dim;
+      memcpy(e->xi, xi, DIM * sizeof(dbl));
+      e->ndof = -1;
+      return e;
+    }
+    if (e->ielem_type == ielem_type && e->element_shape == bf_ptr->element_shape &&
+        e->interpolation == bf_ptr->interpolation && e->dim == pd->Num_Dim &&
+        memcmp(e->xi, xi, DIM * sizeof(dbl)) == 0) {
+      return e;
+    }
+  }
+  return NULL;
+}
+
+/*
+ * Release the reference element basis function table. It is rebuilt on
+ * demand by load_basis_functions().
+ */
+void basis_tab_free(void) {
+  free(Basis_Tab);
+  Basis_Tab = NULL;
+}
+
 int load_basis_functions(const double xi[],            /*  [DIM]               */
                          struct Basis_Functions **bfa) /* ptr to basis function
                                                         * * array of interest */
@@ -2726,74 +2831,56 @@ int load_basis_functions(const double xi[],            /*  [DIM]               *
          */
         if (v != -1 && bf_ptr->element_shape == ei[imtrx]->ielem_shape) {
           /*
-           * Now, case the dimensionality and look up basis functions
-           * and their derivatives at the quadrature point
-           * using elemental coordinates
+           * Look up basis functions and their derivatives at the
+           * quadrature point using elemental coordinates, either from the
+           * reference element table or by evaluating newshape() directly.
            */
+          struct Basis_Tab_Entry *tab = basis_tab_find(xi, ei[imtrx]->ielem_type, bf_ptr);
+          int ndim = pd->Num_Dim;
+          int fill_tab = (tab != NULL && tab->ndof < 0);
           jdof = 0;
-          switch (pd->Num_Dim) {
-          case 1:
-            for (i = 0; i < ei[imtrx]->dof[v]; i++) {
-              ledof = ei[imtrx]->lvdof_to_ledof[v][i];
-              if (ei[imtrx]->active_interp_ledof[ledof]) {
-                bf_ptr->phi[i] = newshape(xi, ei[imtrx]->ielem_type, PSI, ei[imtrx]->dof_list[v][i],
-                                          bf_ptr->element_shape, bf_ptr->interpolation, jdof);
-                bf_ptr->dphidxi[i][0] =
-                    newshape(xi, ei[imtrx]->ielem_type, DPSI_S, ei[imtrx]->dof_list[v][i],
-                             bf_ptr->element_shape, bf_ptr->interpolation, jdof);
-                jdof++;
+          for (i = 0; i < ei[imtrx]->dof[v]; i++) {
+            int q;
+            ledof = ei[imtrx]->lvdof_to_ledof[v][i];
+            if (ei[imtrx]->active_interp_ledof[ledof]) {
+              int inode = ei[imtrx]->dof_list[v][i];
+              if (tab != NULL && !fill_tab && i < tab->ndof && tab->node[i] == inode &&
+                  tab->jdof[i] == jdof) {
+                bf_ptr->phi[i] = tab->phi[i];
+                for (q = 0; q < ndim; q++) {
+                  bf_ptr->dphidxi[i][q] = tab->dphidxi[i][q];
+                }
               } else {
-                bf_ptr->phi[i] = 0.0;
-                bf_ptr->dphidxi[i][0] = 0.0;
-              }
-            }
-            break;
-
-          case 2:
-            for (i = 0; i < ei[imtrx]->dof[v]; i++) {
-              ledof = ei[imtrx]->lvdof_to_ledof[v][i];
-              if (ei[imtrx]->active_interp_ledof[ledof]) {
-                bf_ptr->phi[i] = newshape(xi, ei[imtrx]->ielem_type, PSI, ei[imtrx]->dof_list[v][i],
+                bf_ptr->phi[i] = newshape(xi, ei[imtrx]->ielem_type, PSI, inode,
                                           bf_ptr->element_shape, bf_ptr->interpolation, jdof);
-                bf_ptr->dphidxi[i][0] =
-                    newshape(xi, ei[imtrx]->ielem_type, DPSI_S, ei[imtrx]->dof_list[v][i],
-                             bf_ptr->element_shape, bf_ptr->interpolation, jdof);
-                bf_ptr->dphidxi[i][1] =
-                    newshape(xi, ei[imtrx]->ielem_type, DPSI_T, ei[imtrx]->dof_list[v][i],
-                             bf_ptr->element_shape, bf_ptr->interpolation, jdof);
-                jdof++;
-              } else {
-                bf_ptr->phi[i] = 0.0;
-                bf_ptr->dphidxi[i][0] = 0.0;
-                bf_ptr->dphidxi[i][1] = 0.0;
+                for (q = 0; q < ndim; q++) {
+                  bf_ptr->dphidxi[i][q] =
+                      newshape(xi, ei[imtrx]->ielem_type, DPSI_S + q, inode,
+                               bf_ptr->element_shape, bf_ptr->interpolation, jdof);
+                }
+                if (fill_tab) {
+                  tab->node[i] = inode;
+                  tab->jdof[i] = jdof;
+                  tab->phi[i] = bf_ptr->phi[i];
+                  for (q = 0; q < ndim; q++) {
+                    tab->dphidxi[i][q] = bf_ptr->dphidxi[i][q];
+                  }
+                }
               }
-            }
-            break;
-
-          case 3:
-            for (i = 0; i < ei[imtrx]->dof[v]; i++) {
-              ledof = ei[imtrx]->lvdof_to_ledof[v][i];
-              if (ei[imtrx]->active_interp_ledof[ledof]) {
-                bf_ptr->phi[i] = newshape(xi, ei[imtrx]->ielem_type, PSI, ei[imtrx]->dof_list[v][i],
-                                          bf_ptr->element_shape, bf_ptr->interpolation, jdof);
-                bf_ptr->dphidxi[i][0] =
-                    newshape(xi, ei[imtrx]->ielem_type, DPSI_S, ei[imtrx]->dof_list[v][i],
-                             bf_ptr->element_shape, bf_ptr->interpolation, jdof);
-                bf_ptr->dphidxi[i][1] =
-                    newshape(xi, ei[imtrx]->ielem_type, DPSI_T, ei[imtrx]->dof_list[v][i],
-                             bf_ptr->element_shape, bf_ptr->interpolation, jdof);
-                bf_ptr->dphidxi[i][2] =
-                    newshape(xi, ei[imtrx]->ielem_type, DPSI_U, ei[imtrx]->dof_list[v][i],
-                             bf_ptr->element_shape, bf_ptr->interpolation, jdof);
-                jdof++;
-              } else {
-                bf_ptr->phi[i] = 0.0;
-                bf_ptr->dphidxi[i][0] = 0.0;
-                bf_ptr->dphidxi[i][1] = 0.0;
-                bf_ptr->dphidxi[i][2] = 0.0;
+              jdof++;
+            } else {
+              bf_ptr->phi[i] = 0.0;
+              for (q = 0; q < ndim; q++) {
+                bf_ptr->dphidxi[i][q] = 0.0;
+              }
+              if (fill_tab) {
+                tab->node[i] = -1;
+                tab->jdof[i] = -1;
               }
             }
-            break;
+          }
+          if (fill_tab) {
+            tab->ndof = ei[imtrx]->dof[v];
           }
         }
       }
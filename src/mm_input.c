@@ -31,11 +31,13 @@
 #include "ac_stability_util.h"
 #include "el_elm.h"
 #include "el_elm_info.h"
+#include "md_timer.h"
 #include "mm_as.h"
 #include "mm_as_const.h"
 #include "mm_as_structs.h"
 #include "mm_augc_util.h"
 #include "mm_eh.h"
+#include "mm_fill_geom_cache.h"
 #include "mm_fill_ls.h"
 #include "mm_fill_util.h"
 #include "mm_mp.h"
@@ -73,6 +75,7 @@ static char aprepro_command[1024];
 
 static int look_forward_optional_until(
     FILE *ifp, const char *string, char *untilstring, char input[], const char ch_term);
+static void read_linear_solve_precision(char *input, int imtrx);
 /*
  * Hey! This is the *one* place where these are defined. All other locations
  * have a mm_mp_structs and mm_mp.h to declare what these are.
@@ -670,6 +673,33 @@ static int look_forward_optional_until(
   return (status);
 }
 
+/*
+ * Linear Solve Precision = {double | mixed} [max refinement steps]
+ */
+static void read_linear_solve_precision(char *input, int imtrx) {
+  char precision[MAX_CHAR_IN_INPUT];
+  int max_steps = upd->Refinement_Max_Steps[imtrx];
+
+  precision[0] = '\0';
+  (void)sscanf(input, "%s %d", precision, &max_steps);
+  if (strcmp(precision, "double") == 0) {
+    upd->Linear_Solve_Precision[imtrx] = LINEAR_PRECISION_DOUBLE;
+  } else if (strcmp(precision, "mixed") == 0) {
+    upd->Linear_Solve_Precision[imtrx] = LINEAR_PRECISION_MIXED;
+    if (Linear_Solver != AMESOS2) {
+      GOMA_EH(GOMA_ERROR, "Linear Solve Precision = mixed is only available with amesos2");
+    }
+  } else {
+    GOMA_EH(GOMA_ERROR, "Linear Solve Precision should equal double or mixed, instead found %s",
+            input);
+  }
+  if (max_steps < 1) {
+    GOMA_EH(GOMA_ERROR, "Linear Solve Precision refinement steps should be at least 1, found %d",
+            max_steps);
+  }
+  upd->Refinement_Max_Steps[imtrx] = max_steps;
+}
+
 /**************************************************************************/
 /**************************************************************************/
 /**************************************************************************/
@@ -2229,6 +2259,20 @@ void rd_levelset_specs(FILE *ifp, char *input) {
 
     ECHO(echo_string, echo_file);
 
+    ls->Renorm_Band = 0.0;
+
+    iread = look_for_optional(ifp, "Level Set Renormalization Band", input, '=');
+
+    if (iread == 1) {
+      if (fscanf(ifp, "%lf", &(ls->Renorm_Band)) != 1 || ls->Renorm_Band < 0.0) {
+        GOMA_EH(GOMA_ERROR, "error reading Level Set Renormalization Band");
+      }
+
+      snprintf(echo_string, MAX_CHAR_ECHO_INPUT, "%s = %.4g", "Level Set Renormalization Band",
+               ls->Renorm_Band);
+      ECHO(echo_string, echo_file);
+    }
+
     ls->Renorm_Method = FALSE;
 
     iread = look_for_optional(ifp, "Level Set Renormalization Method", input, '=');
@@ -2424,6 +2468,9 @@ void rd_levelset_specs(FILE *ifp, char *input) {
           ls->Mass_Value = 0.0;
           ls->Mass_Sign = I_POS_FILL;
         }
+      } else if (strcmp(input, "Fast_Marching") == 0) {
+        ls->Renorm_Method = FAST_MARCHING;
+        strcat(echo_string, "Fast_Marching");
       } else if ((strcmp(input, "None") == 0) || (strcmp(input, "No") == 0)) {
         ls->Renorm_Method = FALSE;
         strcat(echo_string, "None");
@@ -2981,12 +3028,14 @@ void rd_levelset_specs(FILE *ifp, char *input) {
           pfd->ls[i]->Renorm_Freq = ls->Renorm_Freq;
           pfd->ls[i]->Renorm_Countdown = ls->Renorm_Countdown;
           pfd->ls[i]->Renorm_Tolerance = ls->Renorm_Tolerance;
+          pfd->ls[i]->Renorm_Band = ls->Renorm_Band;
           pfd->ls[i]->Force_Initial_Renorm = ls->Force_Initial_Renorm;
         } else {
           pfd->ls[i]->Control_Width = 1.0;
           pfd->ls[i]->Renorm_Freq = -1;
           pfd->ls[i]->Renorm_Countdown = -1;
           pfd->ls[i]->Renorm_Tolerance = 0.5;
+          pfd->ls[i]->Renorm_Band = 0.0;
           pfd->ls[i]->Force_Initial_Renorm = FALSE;
         }
         pfd->ls[i]->Init_Method = -1;
@@ -6132,6 +6181,40 @@ void rd_solver_specs(FILE *ifp, char *input) {
     strcpy(Stratimikos_File[i], Stratimikos_File[0]);
   }
 
+  upd->Precond_Reuse = PRECOND_REUSE_NONE;
+  upd->Precond_Reuse_Steps = 1;
+  upd->Precond_Reuse_Growth = 2.0;
+  strcpy(search_string, "Stratimikos Preconditioner Reuse");
+  iread = look_for_optional(ifp, search_string, input, '=');
+  if (iread == 1) {
+    char reuse_kind[MAX_CHAR_IN_INPUT];
+    int nread;
+    reuse_kind[0] = '\0';
+    read_string(ifp, input, '\n');
+    strip(input);
+    nread = sscanf(input, "%s %d %lf", reuse_kind, &upd->Precond_Reuse_Steps,
+                   &upd->Precond_Reuse_Growth);
+    if (strcmp(reuse_kind, "none") == 0) {
+      upd->Precond_Reuse = PRECOND_REUSE_NONE;
+    } else if (strcmp(reuse_kind, "newton") == 0 && nread >= 2) {
+      upd->Precond_Reuse = PRECOND_REUSE_NEWTON;
+    } else if (strcmp(reuse_kind, "time") == 0 && nread >= 2) {
+      upd->Precond_Reuse = PRECOND_REUSE_TIME;
+    } else {
+      GOMA_EH(GOMA_ERROR, "%s should equal none, newton <steps> or time <steps>, instead found %s",
+              search_string, input);
+    }
+    if (upd->Precond_Reuse != PRECOND_REUSE_NONE && upd->Precond_Reuse_Steps < 1) {
+      GOMA_EH(GOMA_ERROR, "%s steps should be at least 1, found %d", search_string,
+              upd->Precond_Reuse_Steps);
+    }
+    snprintf(echo_string, MAX_CHAR_ECHO_INPUT, eoformat, search_string, input);
+    ECHO(echo_string, echo_file);
+  } else {
+    snprintf(echo_string, MAX_CHAR_ECHO_INPUT, def_form, search_string, "none", default_string);
+    ECHO(echo_string, echo_file);
+  }
+
   strcpy(search_string, "Amesos2 File");
   iread = look_for_optional(ifp, search_string, input, '=');
   if (iread == 1) {
@@ -6194,6 +6277,31 @@ void rd_solver_specs(FILE *ifp, char *input) {
     ECHO(echo_string, echo_file);
   }
 
+  upd->Matrix_Equilibration = EQUILIBRATE_ROW;
+  iread = look_for_optional(ifp, "Matrix Equilibration", input, '=');
+  if (iread == 1) {
+    read_string(ifp, input, '\n');
+    strip(input);
+    if (strcmp(input, "row") == 0) {
+      upd->Matrix_Equilibration = EQUILIBRATE_ROW;
+    } else if (strcmp(input, "column") == 0) {
+      upd->Matrix_Equilibration = EQUILIBRATE_COLUMN;
+    } else if (strcmp(input, "symmetric") == 0) {
+      upd->Matrix_Equilibration = EQUILIBRATE_SYMMETRIC;
+    } else {
+      GOMA_EH(GOMA_ERROR, "Matrix Equilibration should equal row, column or symmetric, found %s",
+              input);
+    }
+    if (upd->Matrix_Equilibration != EQUILIBRATE_ROW && strcmp(Matrix_Format, "tpetra") != 0) {
+      GOMA_EH(GOMA_ERROR, "Matrix Equilibration = %s is only available for tpetra, found %s", input,
+              Matrix_Format);
+    }
+    snprintf(echo_string, MAX_CHAR_ECHO_INPUT, eoformat, "Matrix Equilibration", input);
+    ECHO(echo_string, echo_file);
+  } else {
+    ECHO("(Matrix Equilibration = row) (default)", echo_file);
+  }
+
   strcpy(search_string, "Matrix residual norm type");
   iread = look_for_optional(ifp, search_string, input, '=');
   if (iread == 1) {
@@ -6508,6 +6616,23 @@ void rd_solver_specs(FILE *ifp, char *input) {
     ECHO(echo_string, echo_file);
   }
 
+  upd->Linear_Solve_Precision[0] = LINEAR_PRECISION_DOUBLE;
+  upd->Refinement_Max_Steps[0] = 10;
+  iread = look_for_optional(ifp, "Linear Solve Precision", input, '=');
+  if (iread == 1) {
+    read_string(ifp, input, '\n');
+    strip(input);
+    read_linear_solve_precision(input, 0);
+    snprintf(echo_string, MAX_CHAR_ECHO_INPUT, eoformat, "Linear Solve Precision", input);
+    ECHO(echo_string, echo_file);
+  } else {
+    ECHO("(Linear Solve Precision = double) (default)", echo_file);
+  }
+  for (int i = 1; i < MAX_NUM_MATRICES; i++) {
+    upd->Linear_Solve_Precision[i] = upd->Linear_Solve_Precision[0];
+    upd->Refinement_Max_Steps[i] = upd->Refinement_Max_Steps[0];
+  }
+
   /* first initialize modified newton parameter to false */
   modified_newton = FALSE;
 
@@ -6777,6 +6902,61 @@ void rd_solver_specs(FILE *ifp, char *input) {
     }
   }
 
+  upd->Newton_Forcing = FORCING_FIXED;
+  upd->Newton_Forcing_Max = 0.1;
+  iread = look_for_optional(ifp, "Inexact Newton Forcing", input, '=');
+  if (iread == 1) {
+    char forcing_kind[MAX_CHAR_IN_INPUT];
+    forcing_kind[0] = '\0';
+    read_string(ifp, input, '\n');
+    strip(input);
+    (void)sscanf(input, "%s %lf", forcing_kind, &upd->Newton_Forcing_Max);
+    if (strcmp(forcing_kind, "none") == 0) {
+      upd->Newton_Forcing = FORCING_FIXED;
+    } else if (strcmp(forcing_kind, "ew1") == 0) {
+      upd->Newton_Forcing = FORCING_EW1;
+    } else if (strcmp(forcing_kind, "ew2") == 0) {
+      upd->Newton_Forcing = FORCING_EW2;
+    } else {
+      GOMA_EH(GOMA_ERROR, "Inexact Newton Forcing should equal none, ew1 or ew2, instead found %s",
+              input);
+    }
+    if (upd->Newton_Forcing_Max <= 0 || upd->Newton_Forcing_Max >= 1) {
+      GOMA_EH(GOMA_ERROR, "Inexact Newton Forcing maximum should be in (0, 1), found %g",
+              upd->Newton_Forcing_Max);
+    }
+    snprintf(echo_string, MAX_CHAR_ECHO_INPUT, eoformat, "Inexact Newton Forcing", input);
+    ECHO(echo_string, echo_file);
+  } else {
+    ECHO("(Inexact Newton Forcing = none) (default)", echo_file);
+  }
+
+  upd->Matrix_Free = MATRIX_FREE_NONE;
+  upd->Matrix_Free_Lag = 1;
+  iread = look_for_optional(ifp, "Matrix Free Newton", input, '=');
+  if (iread == 1) {
+    char matrix_free_kind[MAX_CHAR_IN_INPUT];
+    matrix_free_kind[0] = '\0';
+    read_string(ifp, input, '\n');
+    strip(input);
+    (void)sscanf(input, "%s %d", matrix_free_kind, &upd->Matrix_Free_Lag);
+    if (strcmp(matrix_free_kind, "none") == 0) {
+      upd->Matrix_Free = MATRIX_FREE_NONE;
+    } else if (strcmp(matrix_free_kind, "fd") == 0) {
+      upd->Matrix_Free = MATRIX_FREE_FD;
+    } else {
+      GOMA_EH(GOMA_ERROR, "Matrix Free Newton should equal none or fd, instead found %s", input);
+    }
+    if (upd->Matrix_Free_Lag < 1) {
+      GOMA_EH(GOMA_ERROR, "Matrix Free Newton lag should be at least 1, found %d",
+              upd->Matrix_Free_Lag);
+    }
+    snprintf(echo_string, MAX_CHAR_ECHO_INPUT, eoformat, "Matrix Free Newton", input);
+    ECHO(echo_string, echo_file);
+  } else {
+    ECHO("(Matrix Free Newton = none) (default)", echo_file);
+  }
+
   iread = look_for_optional(ifp, "Pressure Stabilization", input, '=');
   if (iread == 1) {
     (void)read_string(ifp, input, '\n');
@@ -6997,6 +7177,55 @@ void rd_solver_specs(FILE *ifp, char *input) {
     ECHO("(Use AutoDiff Assembly = no) (default)", echo_file);
   }
 
+  upd->Geometry_Cache = GEOMETRY_CACHE_NONE;
+  upd->Geometry_Cache_Max_MB = GEOMETRY_CACHE_DEFAULT_MB;
+  iread = look_for_optional(ifp, "Geometry Cache", input, '=');
+  if (iread == 1) {
+    char cache_kind[MAX_CHAR_IN_INPUT];
+    int cache_mb;
+    cache_kind[0] = '\0';
+    (void)read_string(ifp, input, '\n');
+    strip(input);
+    if (sscanf(input, "%s %d", cache_kind, &cache_mb) == 2) {
+      if (cache_mb < 1) {
+        GOMA_EH(GOMA_ERROR, "Geometry Cache size should be at least 1 MB, found %d", cache_mb);
+      }
+      upd->Geometry_Cache_Max_MB = cache_mb;
+    }
+    if (strcmp(cache_kind, "yes") == 0) {
+      upd->Geometry_Cache = GEOMETRY_CACHE_DOUBLE;
+    } else if (strcmp(cache_kind, "single") == 0) {
+      upd->Geometry_Cache = GEOMETRY_CACHE_SINGLE;
+    } else if (strcmp(cache_kind, "no") == 0) {
+      upd->Geometry_Cache = GEOMETRY_CACHE_NONE;
+    } else {
+      GOMA_EH(GOMA_ERROR, "Geometry Cache should equal yes, single or no, instead found %s",
+              input);
+    }
+    snprintf(echo_string, MAX_CHAR_ECHO_INPUT, eoformat, "Geometry Cache", input);
+    ECHO(echo_string, echo_file);
+  } else {
+    ECHO("(Geometry Cache = no) (default)", echo_file);
+  }
+
+  upd->Overlap_Dof_Exchange = FALSE;
+  iread = look_for_optional(ifp, "Overlap Ghost Exchange", input, '=');
+  if (iread == 1) {
+    (void)read_string(ifp, input, '\n');
+    strip(input);
+    if (strcmp(input, "yes") == 0) {
+      upd->Overlap_Dof_Exchange = TRUE;
+    } else if (strcmp(input, "no") == 0) {
+      upd->Overlap_Dof_Exchange = FALSE;
+    } else {
+      GOMA_EH(GOMA_ERROR, "Overlap Ghost Exchange should equal yes or no, instead found %s", input);
+    }
+    snprintf(echo_string, MAX_CHAR_ECHO_INPUT, eoformat, "Overlap Ghost Exchange", input);
+    ECHO(echo_string, echo_file);
+  } else {
+    ECHO("(Overlap Ghost Exchange = no) (default)", echo_file);
+  }
+
   /*IGBRK*/
   iread = look_for_optional(ifp, "Linear Stability", input, '=');
   if (iread == 1) {
@@ -8397,6 +8626,15 @@ void rd_eq_specs(FILE *ifp, char *input, const int mn) {
                upd->Residual_Relative_Tol[imtrx]);
       ECHO(echo_string, echo_file);
     }
+    iread = look_forward_optional_until(ifp, "Linear Solve Precision", "MATRIX", input, '=');
+    if (iread == 1) {
+      read_string(ifp, input, '\n');
+      strip(input);
+      read_linear_solve_precision(input, imtrx);
+      snprintf(echo_string, MAX_CHAR_ECHO_INPUT, "%s = %s matrix %d", "Linear Solve Precision",
+               input, mtrx_index1);
+      ECHO(echo_string, echo_file);
+    }
 
     pd_ptr->Matrix_Activity[mtrx_index0] = 1;
 
@@ -11401,6 +11639,7 @@ void usage(const int exit_flag) {
   fprintf(stdout, "\t-nf,        -no_fix             Disable fix from running at the end.\n");
   fprintf(stdout, "\t-kway,                          Use KWAY internal decomposition.\n");
   fprintf(stdout, "\t-rcb,                           Use RCB internal decomposition.\n");
+  fprintf(stdout, "\t-prof,      -profile            Time nested regions, print summary.\n");
   fprintf(stdout, "\t-h,         -help               Print this message.\n");
   fprintf(stdout, "\t-i FILE,    -input FILE         Input from FILE.\n");
   fprintf(stdout, "\t-ix FILE,   -inexoII FILE       Read FEM from FILE.\n");
@@ -11902,6 +12141,11 @@ void translate_command_line(int argc, char *argv[], struct Command_line_command
         istr++;
         Decompose_Type = 1;
         clc[*nclc]->type = NOECHO;
+      } else if (strcmp(argv[istr], "-profile") == 0 || strcmp(argv[istr], "-prof") == 0) {
+        (*nclc)++;
+        istr++;
+        Goma_Profile = TRUE;
+        clc[*nclc]->type = NOECHO;
       } else if (strcmp(argv[istr], "-petsc") == 0 || strcmp(argv[istr], "-petsc_opts") == 0) {
         (*nclc)++;
         istr++;
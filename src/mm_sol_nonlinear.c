@@ -193,6 +193,9 @@ assemble_prefill(struct GomaLinearSolverData *ams, double x[], Exo_DB *exo, Dpi
         apply_displacements = true;
       }
 
+      /* The distances need the ghost node positions */
+      exchange_dof_end(pg->imtrx);
+
       goma_error err = find_current_distances(exo, dpi, x, apply_displacements,
                                               elc_glob[mn]->len_u_mu_ns, elc_glob[mn]->u_mu_ns, 0,
                                               NULL, elc_glob[mn]->multi_contact_line_distances);
@@ -204,6 +207,119 @@ assemble_prefill(struct GomaLinearSolverData *ams, double x[], Exo_DB *exo, Dpi
   return GOMA_SUCCESS;
 }
 
+/*
+ * Inexact Newton forcing term (Eisenstat and Walker, SIAM J. Sci. Comput.
+ * 17, 1996), the relative tolerance for the linear solve of this Newton
+ * step.
+ *
+ *   choice 1: eta = | ||F_k|| - ||F_k-1 + J_k-1 s_k-1|| | / ||F_k-1||
+ *   choice 2: eta = 0.9 (||F_k|| / ||F_k-1||)^2
+ *
+ * with the Eisenstat-Walker safeguard against eta dropping too fast, and
+ * bounded to [newton_tol / (2 ||F_k||), eta_max] so that the linear solve
+ * does not oversolve near convergence, but is never tighter than the
+ * fixed linear tolerance. Choice 1 needs the relative linear residual of
+ * the previous solve and uses choice 2 when the solver did not report it.
+ */
+static double newton_forcing_term(const int choice,
+                                  const double norm,       /* ||F_k|| */
+                                  const double norm_old,   /* ||F_k-1||, 0 on the first step */
+                                  const double eta_old,    /* forcing term of the last step */
+                                  const double achieved,   /* relative linear residual of the
+                                                              last solve, 0 if unknown */
+                                  const double eta_max,    /* largest forcing term */
+                                  const double fixed_tol,  /* fixed linear tolerance */
+                                  const double newton_tol) /* Normalized Residual Tolerance */
+{
+  const double gamma = 0.9;
+  const double alpha1 = 0.5 * (1.0 + sqrt(5.0));
+  double eta, safeguard;
+
+  if (norm_old <= 0.0) {
+    return MAX(eta_max, fixed_tol);
+  }
+
+  if (choice == FORCING_EW1 && achieved > 0.0) {
+    eta = fabs(norm - achieved * norm_old) / norm_old;
+    safeguard = pow(eta_old, alpha1);
+  } else {
+    eta = gamma * (norm / norm_old) * (norm / norm_old);
+    safeguard = gamma * eta_old * eta_old;
+  }
+  if (safeguard > 0.1) {
+    eta = MAX(eta, safeguard);
+  }
+  eta = MIN(eta, eta_max);
+  if (norm > 0.0) {
+    eta = MAX(eta, 0.5 * newton_tol / norm);
+  }
+  return MAX(MIN(eta, eta_max), fixed_tol);
+}
+
+#ifdef GOMA_ENABLE_PETSC
+#if !(PETSC_USE_COMPLEX)
+/*
+ * Newton step state for the residual fills of Matrix Free Newton
+ */
+struct Matrix_Free_Context {
+  struct GomaLinearSolverData *ams;
+  double *x;         /* Newton iterate the Jacobian is linearized about */
+  double *xdot;      /* time derivative at x */
+  double *xdot_pert; /* time derivative consistent with the perturbed x */
+  double *x_old;
+  double *x_older;
+  double *xdot_old;
+  double *x_update;
+  double *scale; /* row scaling of the assembled system */
+  double delta_t;
+  double theta;
+  double time_value;
+  double h_elem_avg;
+  double U_norm;
+  int num_total_nodes;
+  Exo_DB *exo;
+  Dpi *dpi;
+};
+
+/*
+ * Scaled residual at a perturbed solution x_pert, differenced against the
+ * residual at the Newton iterate by the Krylov solver to apply J v.
+ * The time derivative moves with x as in the Newton line search.
+ */
+static int matrix_free_residual(void *ctx, double *x_pert, double *resid) {
+  struct Matrix_Free_Context *mf = (struct Matrix_Free_Context *)ctx;
+  int numProcUnknowns = NumUnknowns[pg->imtrx] + NumExtUnknowns[pg->imtrx];
+  int save_jacobian = af->Assemble_Jacobian;
+  int save_residual = af->Assemble_Residual;
+  double *xdot = mf->xdot;
+  int err, i;
+
+  if (pd->TimeIntegration != STEADY) {
+    for (i = 0; i < numProcUnknowns; i++) {
+      mf->xdot_pert[i] =
+          mf->xdot[i] + (x_pert[i] - mf->x[i]) * (1.0 + 2 * mf->theta) / mf->delta_t;
+    }
+    xdot = mf->xdot_pert;
+  }
+
+  init_vec_value(resid, 0.0, numProcUnknowns);
+  af->Assemble_Jacobian = FALSE;
+  af->Assemble_Residual = TRUE;
+  err = matrix_fill_full(mf->ams, x_pert, resid, mf->x_old, mf->x_older, xdot, mf->xdot_old,
+                         mf->x_update, &mf->delta_t, &mf->theta,
+                         First_Elem_Side_BC_Array[pg->imtrx], &mf->time_value, mf->exo, mf->dpi,
+                         &mf->num_total_nodes, &mf->h_elem_avg, &mf->U_norm, NULL);
+  af->Assemble_Jacobian = save_jacobian;
+  af->Assemble_Residual = save_residual;
+  if (err == -1) {
+    return -1;
+  }
+  vector_scaling(NumUnknowns[pg->imtrx], resid, mf->scale);
+  return 0;
+}
+#endif
+#endif
+
 /*
 
    GOMA NON-LINEAR EQUATION SOLVER
@@ -352,6 +468,11 @@ int solve_nonlinear_problem(struct GomaLinearSolverData *ams,
                                            /*   [1][1] == AC correction, L_1  norm */
                                            /*   [1][2] == AC correction, L_2  norm */
   double Resid_Norm_stack[3];              /* Place holder for last residual norms   */
+  double forcing_eta = 0.0;                /* Inexact Newton forcing term of the last solve */
+  double forcing_norm_old = 0.0;           /* Residual norm at the last forcing term */
+  double fixed_linear_tol = 0.0;           /* Aztec tolerance restored after each solve */
+  double *mf_xdot = NULL;                  /* perturbed xdot for Matrix Free Newton */
+  int matrix_free_lagged = FALSE;          /* keep the assembled preconditioner matrix */
   double Soln_Norm_stack[3];               /* Place holder for last update norms   */
   double Conv_order = 0, Soln_order = 0;   /* Order of convergence  */
   double Conv_rate = 0, Soln_rate = 0;     /* Convergence rates, i.e. neg. semilog slope*/
@@ -573,6 +694,14 @@ int solve_nonlinear_problem(struct GomaLinearSolverData *ams,
   asdv(&res_p, numProcUnknowns);
   asdv(&res_m, numProcUnknowns);
 
+  if (upd->Matrix_Free != MATRIX_FREE_NONE) {
+    if (Linear_Solver != PETSC_SOLVER || strcmp(Matrix_Format, "petsc") != 0 || nAC > 0) {
+      GOMA_EH(GOMA_ERROR, "Matrix Free Newton requires the petsc solver and matrix format, "
+                          "without augmenting conditions");
+    }
+    asdv(&mf_xdot, numProcUnknowns);
+  }
+
   /*
    * Initialize augmenting condition arrays if needed
    */
@@ -767,6 +896,9 @@ int solve_nonlinear_problem(struct GomaLinearSolverData *ams,
    *
    *********************************************************************************/
   while ((!(*converged)) && (inewton < Max_Newton_Steps)) {
+    /* Matrix Free Newton only reassembles the preconditioner matrix every lag steps */
+    matrix_free_lagged =
+        upd->Matrix_Free != MATRIX_FREE_NONE && (inewton % upd->Matrix_Free_Lag) != 0;
     init_vec_value(resid_vector, 0.0, numProcUnknowns);
     init_vec_value(delta_x, 0.0, numProcUnknowns);
     /* Zero matrix values */
@@ -774,7 +906,9 @@ int solve_nonlinear_problem(struct GomaLinearSolverData *ams,
       GomaSparseMatrix matrix = (GomaSparseMatrix)ams->GomaMatrixData;
       matrix->put_scalar(matrix, 0.0);
     } else if (strcmp(Matrix_Format, "petsc") == 0) {
-      petsc_zero_mat(ams);
+      if (!matrix_free_lagged) {
+        petsc_zero_mat(ams);
+      }
     } else {
       init_vec_value(a, 0.0, ams->nnz);
     }
@@ -875,7 +1009,7 @@ int solve_nonlinear_problem(struct GomaLinearSolverData *ams,
       exit(0);
     } else {
 
-      if (!Norm_below_tolerance || !Rate_above_tolerance) {
+      if ((!Norm_below_tolerance || !Rate_above_tolerance) && !matrix_free_lagged) {
         init_vec_value(resid_vector, 0.0, numProcUnknowns);
         init_vec_value(a, 0.0, (NZeros + 1));
         af->Assemble_Residual = TRUE;
@@ -891,6 +1025,7 @@ int solve_nonlinear_problem(struct GomaLinearSolverData *ams,
       }
       a_start = ut();
       a_end = a_start;
+      GOMA_PROF_BEGIN("assembly");
 
       /* Former block 0 in mm_fill.c. Here is some initialization */
       num_total_nodes = dpi->num_universe_nodes;
@@ -928,8 +1063,14 @@ int solve_nonlinear_problem(struct GomaLinearSolverData *ams,
       }
 
       /* Exchange dof before matrix fill so parallel information
-         is properly communicated */
-      exchange_dof(cx, dpi, x, pg->imtrx);
+         is properly communicated. With Overlap Ghost Exchange the
+         exchange is completed inside matrix_fill_full, after the
+         elements with only owned nodes are assembled */
+      if (upd->Overlap_Dof_Exchange) {
+        exchange_dof_begin(cx, dpi, x, pg->imtrx);
+      } else {
+        exchange_dof(cx, dpi, x, pg->imtrx);
+      }
 
       err = assemble_prefill(ams, x, exo, dpi);
       if (err == -1)
@@ -940,6 +1081,7 @@ int solve_nonlinear_problem(struct GomaLinearSolverData *ams,
                              exo, dpi, &num_total_nodes, &h_elem_avg, &U_norm, NULL);
 
       a_end = ut();
+      GOMA_PROF_END("assembly");
       if (err == -1) {
         return_value = -1;
         goto free_and_clear;
@@ -972,7 +1114,7 @@ int solve_nonlinear_problem(struct GomaLinearSolverData *ams,
        * penalty parameter. In front option this is done
        * within the solver
        */
-      if (!Norm_below_tolerance || !Rate_above_tolerance) {
+      if ((!Norm_below_tolerance || !Rate_above_tolerance) && !matrix_free_lagged) {
         row_sum_scaling_scale(ams, resid_vector, scale);
       } else {
         vector_scaling(NumUnknowns[pg->imtrx], resid_vector, scale);
@@ -1280,6 +1422,24 @@ int solve_nonlinear_problem(struct GomaLinearSolverData *ams,
       goto skip_solve;
     }
 
+    /*
+     * Inexact Newton, loosen the linear tolerance while far from convergence
+     */
+    fixed_linear_tol = ams->params[AZ_tol];
+    if (upd->Newton_Forcing != FORCING_FIXED) {
+      forcing_eta = newton_forcing_term(upd->Newton_Forcing, Norm[0][2], forcing_norm_old,
+                                        forcing_eta, ams->achievedTol, upd->Newton_Forcing_Max,
+                                        Epsilon[pg->imtrx][1], Epsilon[pg->imtrx][0]);
+      forcing_norm_old = Norm[0][2];
+      ams->params[AZ_tol] = forcing_eta;
+      ams->forcingTol = forcing_eta;
+      ams->achievedTol = 0.0;
+      if (Debug_Flag > 0) {
+        DPRINTF(stdout, "\n    inexact Newton forcing term %.3e\n", forcing_eta);
+      }
+    }
+
+    GOMA_PROF_BEGIN("linear_solve");
     switch (Linear_Solver) {
     case UMFPACK2:
     case UMFPACK2F:
@@ -1394,6 +1554,7 @@ int solve_nonlinear_problem(struct GomaLinearSolverData *ams,
         AZ_solve(delta_x, resid_vector, ams->options, ams->params, ams->indx, ams->bindx,
                  ams->rpntr, ams->cpntr, ams->bpntr, ams->val, ams->data_org, ams->status,
                  ams->proc_config);
+        ams->achievedTol = ams->status[AZ_scaled_r];
 
         first_linear_solver_call = FALSE;
 
@@ -1437,8 +1598,28 @@ int solve_nonlinear_problem(struct GomaLinearSolverData *ams,
                               "the Amesos2 solver suite\n");
         }
       }
-      amesos2_solve(ams, delta_x, resid_vector, Amesos2_Package, Amesos2_File[pg->imtrx]);
-      strcpy(stringer, " 1 ");
+      {
+        int refinement_steps;
+        int err = amesos2_solve(ams, delta_x, resid_vector, &refinement_steps, Amesos2_Package,
+                                Amesos2_File[pg->imtrx]);
+        if (err < 0) {
+          GOMA_EH(err, "Error in amesos2 solve");
+          check_parallel_error("Error in solve - amesos2");
+        }
+        if (upd->Linear_Solve_Precision[pg->imtrx] == LINEAR_PRECISION_MIXED) {
+          /* report the refinement steps, max or ill when the tolerance was not reached */
+          if (err == REFINEMENT_DIVERGED) {
+            GOMA_WH(-1, "Mixed precision refinement diverged (residual %g), solved in double",
+                    ams->achievedTol);
+          }
+          aztec_stringer(err == REFINEMENT_CONVERGED ? AZ_normal
+                         : err == REFINEMENT_MAXITS  ? AZ_maxits
+                                                     : AZ_ill_cond,
+                         refinement_steps, &stringer[0]);
+        } else {
+          strcpy(stringer, " 1 ");
+        }
+      }
       break;
 
     case AZTECOO:
@@ -1475,6 +1656,28 @@ int solve_nonlinear_problem(struct GomaLinearSolverData *ams,
     case PETSC_SOLVER:
       if (strcmp(Matrix_Format, "petsc") == 0) {
         int its;
+        struct Matrix_Free_Context mf_context;
+        if (upd->Matrix_Free != MATRIX_FREE_NONE) {
+          mf_context.ams = ams;
+          mf_context.x = x;
+          mf_context.xdot = xdot;
+          mf_context.xdot_pert = mf_xdot;
+          mf_context.x_old = x_old;
+          mf_context.x_older = x_older;
+          mf_context.xdot_old = xdot_old;
+          mf_context.x_update = x_update;
+          mf_context.scale = scale;
+          mf_context.delta_t = delta_t;
+          mf_context.theta = theta;
+          mf_context.time_value = time_value;
+          mf_context.h_elem_avg = h_elem_avg;
+          mf_context.U_norm = U_norm;
+          mf_context.num_total_nodes = num_total_nodes;
+          mf_context.exo = exo;
+          mf_context.dpi = dpi;
+          petsc_matrix_free_set_base(ams, matrix_free_residual, &mf_context, x, resid_vector,
+                                     matrix_free_lagged ? PETSC_TRUE : PETSC_FALSE);
+        }
         petsc_solve(ams, delta_x, resid_vector, &its);
         exchange_dof(cx, dpi, delta_x, pg->imtrx);
         matrix_solved = 1;
@@ -1499,7 +1702,8 @@ int solve_nonlinear_problem(struct GomaLinearSolverData *ams,
           check_parallel_error("Error in solve - stratimikos");
         }
         aztec_stringer(AZ_normal, iterations, &stringer[0]);
-      } else if (strcmp(Matrix_Format, "tpetra") == 0) {
+      } else if ((strcmp(Matrix_Format, "tpetra") == 0) ||
+                 (strcmp(Matrix_Format, "tpetra_block") == 0)) {
         int iterations;
         int err = stratimikos_solve_tpetra(ams, delta_x, resid_vector, &iterations,
                                            Stratimikos_File, pg->imtrx);
@@ -1520,6 +1724,9 @@ int solve_nonlinear_problem(struct GomaLinearSolverData *ams,
       break;
     }
     s_end = ut();
+    GOMA_PROF_END("linear_solve");
+    ams->params[AZ_tol] = fixed_linear_tol;
+    ams->forcingTol = 0.0;
     /**************************************************************************
      *        END OF LINEAR SYSTEM SOLVE SECTION
      **************************************************************************/
@@ -1697,7 +1904,8 @@ int solve_nonlinear_problem(struct GomaLinearSolverData *ams,
             } else {
               aztec_stringer(AZ_normal, iterations, &stringer[0]);
             }
-          } else if (strcmp(Matrix_Format, "tpetra") == 0) {
+          } else if ((strcmp(Matrix_Format, "tpetra") == 0) ||
+                     (strcmp(Matrix_Format, "tpetra_block") == 0)) {
             int iterations;
             int err = stratimikos_solve_tpetra(ams, &wAC[iAC][0], &bAC[iAC][0], &iterations,
                                                Stratimikos_File, pg->imtrx);
@@ -2860,6 +3068,7 @@ free_and_clear:
   safe_free((void *)delta_x);
   safe_free((void *)res_p);
   safe_free((void *)res_m);
+  safe_free((void *)mf_xdot);
 
   if (nAC > 0) {
     safe_free((void *)gAC);
@@ -3613,7 +3822,13 @@ static int soln_sens(double lambda,  /*  parameter */
                             "the Amesos2 solver suite\n");
       }
     }
-    amesos2_solve(ams, x_sens, resid_vector_sens, Amesos2_Package, Amesos2_File[pg->imtrx]);
+    {
+      int refinement_steps;
+      if (amesos2_solve(ams, x_sens, resid_vector_sens, &refinement_steps, Amesos2_Package,
+                        Amesos2_File[pg->imtrx]) < 0) {
+        GOMA_EH(GOMA_ERROR, "Error in amesos2 solve");
+      }
+    }
     strcpy(stringer, " 1 ");
     break;
 
@@ -3677,7 +3892,8 @@ static int soln_sens(double lambda,  /*  parameter */
       } else {
         aztec_stringer(AZ_normal, iterations, &stringer[0]);
       }
-    } else if (strcmp(Matrix_Format, "tpetra") == 0) {
+    } else if ((strcmp(Matrix_Format, "tpetra") == 0) ||
+               (strcmp(Matrix_Format, "tpetra_block") == 0)) {
       int iterations;
       int err = stratimikos_solve_tpetra(ams, x_sens, resid_vector_sens, &iterations,
                                          Stratimikos_File, pg->imtrx);
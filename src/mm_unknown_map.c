@@ -1111,6 +1111,11 @@ void set_unknown_map(Exo_DB *exo, Dpi *dpi)
     print_vars_at_nodes();
   }
 
+  /*
+   * The nodal variables are final, set up the Index_Solution() lookup
+   */
+  nodal_vars_index_tables_build();
+
   /* Now that the dust has settled, let us translate these quantities
    * into Hoodian frontal solver form if the front method has been requested.
    * While you are at it, run prefront and also load up the element sweep map
@@ -5255,6 +5260,129 @@ static void set_interaction_masks(Exo_DB *exo)
 /**************************************************************************/
 /**************************************************************************/
 
+/*
+ * Position of (varType, subvarIndex, matID) in the Index_Table of a
+ * nodal variables structure, or -1 if the triple is outside the table.
+ * Each species of MASS_FRACTION has its own row after V_LAST.
+ */
+static int index_table_slot(const int varType, const int subvarIndex, const int matID) {
+  int row = varType;
+
+  if (varType == MASS_FRACTION) {
+    if (subvarIndex < 0 || subvarIndex >= upd->Max_Num_Species_Eqn) {
+      return -1;
+    }
+    row = V_LAST + subvarIndex;
+  }
+  if (matID < -2 || matID >= upd->Num_Mat) {
+    return -1;
+  }
+  return row * (upd->Num_Mat + 2) + matID + 2;
+}
+
+/*
+ * index_solution_search():
+ *
+ *   Linear search of the variable descriptions of nv for the one
+ *   matching the variable type, species and material id, with the
+ *   matID conventions of Index_Solution(). Returns its position in
+ *   nv->Var_Desc_List, or -1 if there is no match with unknowns.
+ */
+static int index_solution_search(NODAL_VARS_STRUCT *nv,
+                                 const int varType,
+                                 const int subvarIndex,
+                                 const int matID) {
+  int index, i_match = -1, i, ifound;
+  VARIABLE_DESCRIPTION_STRUCT *vd_match = NULL, *vd;
+
+  if (varType == MASS_FRACTION) {
+    ifound = 0;
+    index = nv->Num_Var_Desc_Per_Type[varType] / upd->Max_Num_Species_Eqn;
+    for (i = 0; i < nv->Num_Var_Desc; i++) {
+      vd = nv->Var_Desc_List[i];
+      if ((vd->Variable_Type == MASS_FRACTION) && (vd->Subvar_Index == subvarIndex)) {
+        if (vd->MatID == matID || matID == -2) {
+          vd_match = vd;
+          i_match = i;
+          break;
+        } else if (vd->MatID == -1) {
+          vd_match = vd;
+          i_match = i;
+        }
+        ifound++;
+        if (ifound == index)
+          break;
+      }
+    }
+  } else {
+    ifound = 0;
+    for (i = 0; i < nv->Num_Var_Desc; i++) {
+      vd = nv->Var_Desc_List[i];
+      if (vd->Variable_Type == varType) {
+        if (vd->MatID == matID || matID == -2) {
+          vd_match = vd;
+          i_match = i;
+          break;
+        } else if (vd->MatID == -1) {
+          vd_match = vd;
+          i_match = i;
+        }
+        ifound++;
+        if (ifound == (int)nv->Num_Var_Desc_Per_Type[varType])
+          break;
+      }
+    }
+  }
+
+  /*
+   * Check to see whether this variable type is defined to exist at
+   * this node with at least one degree of freedom.
+   */
+  if (vd_match == NULL || vd_match->Ndof < 1) {
+    return -1;
+  }
+  return i_match;
+}
+/***************************************************************************/
+
+void nodal_vars_index_tables_build(void)
+
+/********************************************************************
+ *
+ * nodal_vars_index_tables_build():
+ *
+ *   Fill in the Index_Table of every unique nodal variables structure
+ *   on this processor, so that Index_Solution() is a table read.
+ *   The structures are shared by many nodes, so this costs a few
+ *   searches per structure rather than per node. Call once the
+ *   nodal variables are complete, i.e. at the end of
+ *   set_unknown_map(), which is rerun after a remesh.
+ ********************************************************************/
+{
+  int i, varType, subvarIndex, num_subvar, matID, num_slots;
+  NODAL_VARS_STRUCT *nv;
+
+  num_slots = (V_LAST + upd->Max_Num_Species_Eqn) * (upd->Num_Mat + 2);
+  for (i = 0; i < Nodal_Vars_List_Length; i++) {
+    nv = Nodal_Vars_List[i];
+    safer_free((void **)&(nv->Index_Table));
+    nv->Index_Table = alloc_short_1(num_slots, -1);
+    for (varType = V_FIRST; varType < V_LAST; varType++) {
+      if (nv->Num_Var_Desc_Per_Type[varType] == 0) {
+        continue;
+      }
+      num_subvar = (varType == MASS_FRACTION) ? upd->Max_Num_Species_Eqn : 1;
+      for (subvarIndex = 0; subvarIndex < num_subvar; subvarIndex++) {
+        for (matID = -2; matID < upd->Num_Mat; matID++) {
+          nv->Index_Table[index_table_slot(varType, subvarIndex, matID)] =
+              (short int)index_solution_search(nv, varType, subvarIndex, matID);
+        }
+      }
+    }
+  }
+}
+/***************************************************************************/
+
 int Index_Solution(const int nodeNum,
                    const int varType,
                    const int subvarIndex,
@@ -5307,19 +5435,18 @@ int Index_Solution(const int nodeNum,
  * NOTES:
  *   This function should execute as fast as possible, because
  *   it is unfortunately called during low levels of the jacobian
- *   and residual fills.
+ *   and residual fills. Once nodal_vars_index_tables_build() has run
+ *   the variable description is read from the nodal variables lookup
+ *   table, the linear search below is only done before then or for
+ *   arguments outside the table.
  **********************************************************************/
 {
-  int dofp, index, i_match = -1, i, ifound;
+  int slot, i_match, index;
   /*
    * Pointer to the node info struct for this node
    */
   NODE_INFO_STRUCT *node_ptr = Nodes[nodeNum];
   NODAL_VARS_STRUCT *nv = node_ptr->Nodal_Vars_Info[imtrx];
-  VARIABLE_DESCRIPTION_STRUCT *vd_match = NULL, *vd;
-  /*
-   * Do extra debugging of argument list when in debug mode
-   */
 
   /*
    * Quick return for var types not present at this node
@@ -5327,101 +5454,37 @@ int Index_Solution(const int nodeNum,
   if (nv->Num_Var_Desc_Per_Type[varType] == 0)
     return -1;
 
-  if (varType == MASS_FRACTION) {
-    ifound = 0;
-    if (subvarIndex >= upd->Max_Num_Species_Eqn) {
-      printf("ERROR Index_Solution: subvarIndex is bad: %d\n", subvarIndex);
-      GOMA_EH(GOMA_ERROR, "ERROR Index_Solution: subvarIndex is bad");
-    }
-    index = nv->Num_Var_Desc_Per_Type[varType] / upd->Max_Num_Species_Eqn;
-    for (i = 0; i < nv->Num_Var_Desc; i++) {
-      vd = nv->Var_Desc_List[i];
-      if ((vd->Variable_Type == MASS_FRACTION) && (vd->Subvar_Index == subvarIndex)) {
-        if (vd->MatID == matID || matID == -2) {
-          vd_match = vd;
-          i_match = i;
-          break;
-        } else if (vd->MatID == -1) {
-          vd_match = vd;
-          i_match = i;
-        }
-        ifound++;
-        if (ifound == index)
-          break;
-      }
-    }
-  } else {
-    ifound = 0;
-    for (i = 0; i < nv->Num_Var_Desc; i++) {
-      vd = nv->Var_Desc_List[i];
-      if (vd->Variable_Type == varType) {
-        if (vd->MatID == matID || matID == -2) {
-          vd_match = vd;
-          i_match = i;
-          break;
-        } else if (vd->MatID == -1) {
-          vd_match = vd;
-          i_match = i;
-        }
-        ifound++;
-        if (ifound == (int)nv->Num_Var_Desc_Per_Type[varType])
-          break;
-      }
-    }
+  if (varType == MASS_FRACTION && subvarIndex >= upd->Max_Num_Species_Eqn) {
+    printf("ERROR Index_Solution: subvarIndex is bad: %d\n", subvarIndex);
+    GOMA_EH(GOMA_ERROR, "ERROR Index_Solution: subvarIndex is bad");
   }
 
-  if (vd_match == NULL) {
+  slot = (nv->Index_Table != NULL) ? index_table_slot(varType, subvarIndex, matID) : -1;
+  if (slot >= 0) {
+    i_match = nv->Index_Table[slot];
+  } else {
+    i_match = index_solution_search(nv, varType, subvarIndex, matID);
+  }
+  if (i_match < 0) {
     return -1;
   }
 
   /*
-   * Gather the local number of degrees of this variable type at this
-   * node into a local variable, dofp.
-   */
-  dofp = vd_match->Ndof;
-
-  /*
-   * Check to see whether this variable type is defined to exist at
-   * this global node number. If it doesn't exist, return immediately.
-   */
-  if (dofp < 1)
-    return (-1);
-
-  /*
-   *  The index is determined by several arrays:
-   *    First_Unknown[matrix number][nodeNum] -> index into the processor node list for
-   *              the first unknown pertaining to the node number
-   *    Local_offset[][][] -> offset for the particular processor node
-   *              var type from the First_Unknown.
-   *        -> note this can be redefined to be a short int array
-   *           if space is needed.
-   *    iNdof -> offset from Local_Offset! -> they are necessary
-   *             defined as continguous within the solution vector.
-   *
-   * NOTE -> Local_Offset will break under the new treatment with
-   *         mat_id. Will have to do away with it, or surplant it
-   *         for cases where discontinuous vars occur.
-   */
-
-  /*
-   * HKM -> Special backwards compatibility section that will go away
+   *  The index is the first unknown of the node, First_Unknown[imtrx],
+   *  plus the offset of the matching variable description within the
+   *  node, Nodal_Offset[i_match]. The variables are defined as
+   *  contiguous within the solution vector.
    *
    *  Under the old method, iNdof was used as an index into the solution
-   *  vector for the case of discontinuous variables. Below we will protect
-   *  against this functionality grandfathered into Index_Solution()'s
-   *  API. It's actually already taken into account in the Nodal_Offsets
-   *  in the new method. However, it's needed by the old method to get
-   *  the right index and we check old vs. new in the DEBUG_HKM section
-   *  below. Therefore, we will add a section of code to discard iNdof
-   *  for almost all variable types, except pressure.
-   *
+   *  vector for the case of discontinuous variables. It's already taken
+   *  into account in the Nodal_Offsets in the new method, so iNdof is
+   *  only added for variables with more than one nodal dof, e.g.
+   *  centroid pressures and hermite cubic variables.
    */
-  if (vd_match->Ndof > 1) {
-    index = node_ptr->First_Unknown[imtrx] + nv->Nodal_Offset[i_match] + iNdof;
-  } else {
-    index = node_ptr->First_Unknown[imtrx] + nv->Nodal_Offset[i_match];
+  index = node_ptr->First_Unknown[imtrx] + nv->Nodal_Offset[i_match];
+  if (nv->Var_Desc_List[i_match]->Ndof > 1) {
+    index += iNdof;
   }
-
   return index;
 }
 /***************************************************************************/
@@ -60,6 +60,163 @@
 
 int first_time_fopen = TRUE;
 
+/*
+ * Uniform grid over the element centers of the pixel block, so the nearest
+ * element center of a data point is found by searching outward from its
+ * cell instead of testing every element.
+ */
+struct Elem_Center_Grid {
+  int n[DIM];
+  double lo[DIM];
+  double h[DIM];
+  int *cell_start; /* [ncells + 1] offsets into cell_elem */
+  int *cell_elem;
+};
+
+static int elem_center_cell(const struct Elem_Center_Grid *grid, const double x[DIM], int c[DIM]) {
+  int a;
+
+  for (a = 0; a < DIM; a++) {
+    c[a] = (int)floor((x[a] - grid->lo[a]) / grid->h[a]);
+    c[a] = MAX(0, MIN(grid->n[a] - 1, c[a]));
+  }
+  return (c[2] * grid->n[1] + c[1]) * grid->n[0] + c[0];
+}
+
+static void
+build_elem_center_grid(struct Elem_Center_Grid *grid, double **elmctrs, int e_start, int e_end) {
+  int a, ielem, cell, ncells;
+  int num_elems = e_end - e_start;
+  int num_active = 0;
+  int c[DIM];
+  double hi[DIM];
+  double volume = 1.0, h;
+
+  for (a = 0; a < DIM; a++) {
+    grid->lo[a] = 1.0e+30;
+    hi[a] = -1.0e+30;
+  }
+  for (ielem = e_start; ielem < e_end; ielem++) {
+    for (a = 0; a < DIM; a++) {
+      grid->lo[a] = MIN(grid->lo[a], elmctrs[ielem][a]);
+      hi[a] = MAX(hi[a], elmctrs[ielem][a]);
+    }
+  }
+
+  /* cells about the size of an element */
+  for (a = 0; a < DIM; a++) {
+    if (hi[a] > grid->lo[a]) {
+      volume *= hi[a] - grid->lo[a];
+      num_active++;
+    }
+  }
+  h = (num_active > 0) ? pow(volume / MAX(num_elems, 1), 1.0 / num_active) : 1.0;
+
+  ncells = 1;
+  for (a = 0; a < DIM; a++) {
+    if (hi[a] > grid->lo[a]) {
+      grid->n[a] = MAX(1, MIN(num_elems, (int)ceil((hi[a] - grid->lo[a]) / h)));
+      grid->h[a] = (hi[a] - grid->lo[a]) / grid->n[a];
+    } else {
+      grid->n[a] = 1;
+      grid->h[a] = 1.0;
+    }
+    ncells *= grid->n[a];
+  }
+
+  /* bucket the elements by cell, keeping element order within a cell */
+  grid->cell_start = (int *)calloc(ncells + 1, sizeof(int));
+  grid->cell_elem = (int *)malloc(MAX(num_elems, 1) * sizeof(int));
+  for (ielem = e_start; ielem < e_end; ielem++) {
+    cell = elem_center_cell(grid, elmctrs[ielem], c);
+    grid->cell_start[cell + 1]++;
+  }
+  for (cell = 0; cell < ncells; cell++) {
+    grid->cell_start[cell + 1] += grid->cell_start[cell];
+  }
+  for (ielem = e_start; ielem < e_end; ielem++) {
+    cell = elem_center_cell(grid, elmctrs[ielem], c);
+    grid->cell_elem[grid->cell_start[cell]++] = ielem;
+  }
+  for (cell = ncells; cell > 0; cell--) {
+    grid->cell_start[cell] = grid->cell_start[cell - 1];
+  }
+  grid->cell_start[0] = 0;
+}
+
+/*
+ * Element (plus one, as stored in ElemID_data) whose center is closest to x,
+ * ties going to the lowest element number as in a linear search.  Rings of
+ * cells are searched until no unsearched cell can hold a closer center.
+ */
+static int nearest_elem_center(const struct Elem_Center_Grid *grid,
+                               double **elmctrs,
+                               const double x[DIM]) {
+  int a, k, i0, i1, i2, l, ielem;
+  int c[DIM], lo[DIM], hi[DIM];
+  int elem_loc = -1;
+  double minsepar = 1.0e+30;
+
+  elem_center_cell(grid, x, c);
+
+  for (k = 0;; k++) {
+    int covered = TRUE;
+    double bound = 1.0e+30;
+
+    for (a = 0; a < DIM; a++) {
+      lo[a] = MAX(0, c[a] - k);
+      hi[a] = MIN(grid->n[a] - 1, c[a] + k);
+    }
+
+    for (i2 = lo[2]; i2 <= hi[2]; i2++) {
+      for (i1 = lo[1]; i1 <= hi[1]; i1++) {
+        for (i0 = lo[0]; i0 <= hi[0]; i0++) {
+          int cell;
+          if (abs(i0 - c[0]) < k && abs(i1 - c[1]) < k && abs(i2 - c[2]) < k)
+            continue;
+
+          cell = (i2 * grid->n[1] + i1) * grid->n[0] + i0;
+          for (l = grid->cell_start[cell]; l < grid->cell_start[cell + 1]; l++) {
+            double separ;
+
+            ielem = grid->cell_elem[l];
+            separ = sqrt((x[0] - elmctrs[ielem][0]) * (x[0] - elmctrs[ielem][0]) +
+                         (x[1] - elmctrs[ielem][1]) * (x[1] - elmctrs[ielem][1]) +
+                         (x[2] - elmctrs[ielem][2]) * (x[2] - elmctrs[ielem][2]));
+
+            if (separ < minsepar || (separ == minsepar && ielem + 1 < elem_loc)) {
+              minsepar = separ;
+              elem_loc = ielem + 1;
+            }
+          }
+        }
+      }
+    }
+
+    /* distance from x to the nearest cell outside the searched block */
+    for (a = 0; a < DIM; a++) {
+      if (lo[a] > 0) {
+        covered = FALSE;
+        bound = MIN(bound, x[a] - (grid->lo[a] + lo[a] * grid->h[a]));
+      }
+      if (hi[a] < grid->n[a] - 1) {
+        covered = FALSE;
+        bound = MIN(bound, grid->lo[a] + (hi[a] + 1) * grid->h[a] - x[a]);
+      }
+    }
+
+    if (covered || (elem_loc != -1 && minsepar < bound))
+      break;
+  }
+
+  return (elem_loc);
+}
+
+static void free_elem_center_grid(struct Elem_Center_Grid *grid) {
+  safe_free(grid->cell_start);
+  safe_free(grid->cell_elem);
+}
+
 /*** Begin program *************************************************************/
 int rd_image_to_mesh(int N_ext, Exo_DB *exo) {
 
@@ -85,9 +242,8 @@ int rd_image_to_mesh(int N_ext, Exo_DB *exo) {
 
   int e_start, e_end;
 
-  /* variables for processing the image data */
-  double minsepar,
-      separ; // minimum separation, and separation to match data point to element center
+  /* element centers binned to match data points to the nearest element center */
+  struct Elem_Center_Grid center_grid;
 
   /* Least square fit variables and arrays */
   double *bf_mat, *f_rhs, *x_fit, *Atranspose_f_rhs;
@@ -102,7 +258,6 @@ int rd_image_to_mesh(int N_ext, Exo_DB *exo) {
 
   /* Integers */
   int err, i, j, si;
-  int elem_loc;
   int ilnode, ignode, ielem, ielem_shape;
   int txt_num_pts = 0;
   int icount;
@@ -198,6 +353,8 @@ int rd_image_to_mesh(int N_ext, Exo_DB *exo) {
     elmctrs[ielem][1] = ysum / (double)exo->eb_num_nodes_per_elem[ipix_blkid];
     if (pd->Num_Dim == 3)
       elmctrs[ielem][2] = zsum / (double)exo->eb_num_nodes_per_elem[ipix_blkid];
+    else
+      elmctrs[ielem][2] = 0.0;
   }
 
   /*** Find the data point location within the element ***********/
@@ -229,23 +386,14 @@ int rd_image_to_mesh(int N_ext, Exo_DB *exo) {
   e_start = exo->eb_ptr[ipix_blkid];
   e_end = exo->eb_ptr[ipix_blkid + 1];
 
-  for (i = 0; i < txt_num_pts; i++) {
-    minsepar = 1.0e+30; // initialize minimum separation
-    elem_loc = -1;      // initialize element ID location
-    for (ielem = e_start; ielem < e_end; ielem++) {
-      separ = sqrt((xyz_data[i][0] - elmctrs[ielem][0]) * (xyz_data[i][0] - elmctrs[ielem][0]) +
-                   (xyz_data[i][1] - elmctrs[ielem][1]) * (xyz_data[i][1] - elmctrs[ielem][1]) +
-                   (xyz_data[i][2] - elmctrs[ielem][2]) * (xyz_data[i][2] - elmctrs[ielem][2]));
-
-      if (separ < minsepar) {
-        minsepar = separ;
-        elem_loc = ielem + 1;
-      }
-    }
+  build_elem_center_grid(&center_grid, elmctrs, e_start, e_end);
 
-    ElemID_data[i] = elem_loc;
+  for (i = 0; i < txt_num_pts; i++) {
+    ElemID_data[i] = nearest_elem_center(&center_grid, elmctrs, xyz_data[i]);
   }
 
+  free_elem_center_grid(&center_grid);
+
   /* Find local coordinates */
   xi_data = (double **)malloc(txt_num_pts * sizeof(double *));
   for (i = 0; i < txt_num_pts; i++) {
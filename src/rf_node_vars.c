@@ -477,6 +477,11 @@ void add_var_to_nv_struct(VARIABLE_DESCRIPTION_STRUCT *vd, NODAL_VARS_STRUCT *nv
   if (vd == NULL)
     GOMA_EH(GOMA_ERROR, "add_var_to_nv_struct error");
 
+  /*
+   * Any lookup table built for the old list is now stale
+   */
+  safer_free((void **)&(nv->Index_Table));
+
   /*
    * Check to see whether this variable description structure is
    * a duplicate of an existing variable description structure.
@@ -667,6 +672,7 @@ void nodal_vars_free(NODAL_VARS_STRUCT *nv)
   }
   safer_free((void **)&(nv->Var_Desc_List));
   safer_free((void **)&(nv->Nodal_Offset));
+  safer_free((void **)&(nv->Index_Table));
   (void)memset((void *)nv, 0, sizeof(NODAL_VARS_STRUCT));
 }
 /*****************************************************************************/
@@ -19,6 +19,7 @@
 #include <stdio.h>
 #include <string.h>
 
+#include "dp_comm.h"
 #include "dp_map_comm_vec.h"
 #include "dp_types.h"
 #include "dp_utils.h"
@@ -29,7 +30,11 @@
 #include "mm_as_structs.h"
 #include "mm_bc.h"
 #include "mm_eh.h"
+#include "mm_fill.h"
+#include "mm_fill_geom_cache.h"
 #include "mm_fill_ptrs.h"
+#include "mm_fill_scatter.h"
+#include "mm_fill_util.h"
 #include "mm_shell_util.h"
 #include "mm_unknown_map.h"
 #include "mpi.h"
@@ -47,6 +52,7 @@
 #include "rf_util.h"
 #include "rf_vars_const.h"
 #include "std.h"
+#include "util/distance_helpers.h"
 
 static void associate_bc_to_matrix(void);
 
@@ -189,6 +195,50 @@ void set_matrix_index_and_global_v(void) {
 
 /****************************************************************************/
 /****************************************************************************/
+/*
+ * setup_lec_layout() -- assign blocks of lec->J to the equation and variable
+ * descriptions (peqn/pvar) used by any matrix of the problem, so that lec->J
+ * is sized by the active unknowns rather than by MAX_LOCAL_VAR_DESC.
+ * Descriptions that are not in use all map to one trailing scratch block.
+ */
+static void setup_lec_layout(void) {
+  int imtrx, e, ke, d, n;
+  int used[MAX_LOCAL_VAR_DESC];
+
+  for (d = 0; d < MAX_LOCAL_VAR_DESC; d++) {
+    used[d] = FALSE;
+  }
+
+  for (imtrx = 0; imtrx < upd->Total_Num_Matrices; imtrx++) {
+    for (e = V_FIRST; e < V_LAST; e++) {
+      if (upd->ep[imtrx][e] != -1) {
+        used[upd->ep[imtrx][e]] = TRUE;
+      }
+      if (upd->vp[imtrx][e] != -1) {
+        used[upd->vp[imtrx][e]] = TRUE;
+      }
+    }
+    if (upd->ep[imtrx][R_MASS] != -1 || upd->vp[imtrx][MASS_FRACTION] != -1) {
+      for (ke = 0; ke < upd->Max_Num_Species_Eqn; ke++) {
+        used[MAX_PROB_VAR + ke] = TRUE;
+      }
+    }
+  }
+
+  n = 0;
+  for (d = 0; d < MAX_LOCAL_VAR_DESC; d++) {
+    if (used[d]) {
+      lec->desc_slot[d] = n++;
+    }
+  }
+  for (d = 0; d < MAX_LOCAL_VAR_DESC; d++) {
+    if (!used[d]) {
+      lec->desc_slot[d] = n;
+    }
+  }
+  lec->num_desc = n + 1;
+}
+
 /****************************************************************************/
 
 int setup_problem(Exo_DB *exo, /* ptr to the finite element mesh database */
@@ -411,8 +461,10 @@ int setup_problem(Exo_DB *exo, /* ptr to the finite element mesh database */
     }
   }
 
+  setup_lec_layout();
+
   lec->R = (dbl *)smalloc(MAX_LOCAL_VAR_DESC * lec->max_dof * sizeof(dbl));
-  lec->J = (dbl *)smalloc(MAX_LOCAL_VAR_DESC * MAX_LOCAL_VAR_DESC * lec->max_dof * lec->max_dof *
+  lec->J = (dbl *)smalloc(lec->num_desc * lec->num_desc * lec->max_dof * lec->max_dof *
                           sizeof(dbl));
   lec->J_stress_neighbor =
       (dbl *)smalloc(4 * lec->max_dof * MAX_LOCAL_VAR_DESC * lec->max_dof * sizeof(dbl));
@@ -433,6 +485,12 @@ int free_problem(Exo_DB *exo, /* ptr to the finite element mesh database */
    */
   free_Surf_BC(First_Elem_Side_BC_Array, exo);
   free_Edge_BC(First_Elem_Edge_BC_Array, exo, dpi);
+  basis_tab_free();
+  lec_scatter_free();
+  geometry_cache_free();
+  exchange_dof_free();
+  element_ghost_flags_free();
+  wall_distance_engines_free();
   return 0;
 }
 /************************************************************************/
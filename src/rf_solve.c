@@ -719,7 +719,8 @@ void solve_problem(Exo_DB *exo, /* ptr to the finite element mesh database  */
   /* Allocate sparse matrix */
 
   ams[JAC]->GomaMatrixData = NULL;
-  if ((strcmp(Matrix_Format, "tpetra") == 0) || (strcmp(Matrix_Format, "epetra") == 0)) {
+  if ((strcmp(Matrix_Format, "tpetra") == 0) || (strcmp(Matrix_Format, "tpetra_block") == 0) ||
+      (strcmp(Matrix_Format, "epetra") == 0)) {
     err = check_compatible_solver();
     GOMA_EH(err, "Incompatible matrix solver for tpetra, tpetra supports stratimikos");
     check_parallel_error("Matrix format / Solver incompatibility");
@@ -1537,6 +1538,7 @@ void solve_problem(Exo_DB *exo, /* ptr to the finite element mesh database  */
             case HUYGENS:
             case HUYGENS_C:
             case HUYGENS_MASS_ITER:
+            case FAST_MARCHING:
               Renorm_Now =
                   (ls->Force_Initial_Renorm || (ls->Renorm_Freq != 0 && ls->Renorm_Countdown == 0));
 
@@ -2271,6 +2273,7 @@ void solve_problem(Exo_DB *exo, /* ptr to the finite element mesh database  */
           case HUYGENS:
           case HUYGENS_C:
           case HUYGENS_MASS_ITER:
+          case FAST_MARCHING:
             Renorm_Now =
                 (ls->Renorm_Freq != 0 && ls->Renorm_Countdown == 0) || ls_adc_event == TRUE;
 
@@ -2316,6 +2319,7 @@ void solve_problem(Exo_DB *exo, /* ptr to the finite element mesh database  */
             case HUYGENS:
             case HUYGENS_C:
             case HUYGENS_MASS_ITER:
+            case FAST_MARCHING:
               Renorm_Now = (ls->Renorm_Freq != 0 && ls->Renorm_Countdown == 0);
 
               did_renorm =
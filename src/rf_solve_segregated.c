@@ -558,7 +558,8 @@ void solve_problem_segregated(Exo_DB *exo, /* ptr to the finite element mesh dat
   a = malloc(upd->Total_Num_Matrices * sizeof(double *));
   a_old = malloc(upd->Total_Num_Matrices * sizeof(double *));
 
-  if ((strcmp(Matrix_Format, "tpetra") == 0) || (strcmp(Matrix_Format, "epetra") == 0)) {
+  if ((strcmp(Matrix_Format, "tpetra") == 0) || (strcmp(Matrix_Format, "tpetra_block") == 0) ||
+      (strcmp(Matrix_Format, "epetra") == 0)) {
     err = check_compatible_solver();
     GOMA_EH(err, "Incompatible matrix solver for tpetra, tpetra supports stratimikos");
     check_parallel_error("Matrix format / Solver incompatibility");
@@ -1219,6 +1220,7 @@ void solve_problem_segregated(Exo_DB *exo, /* ptr to the finite element mesh dat
             case HUYGENS:
             case HUYGENS_C:
             case HUYGENS_MASS_ITER:
+            case FAST_MARCHING:
               Renorm_Now =
                   (ls->Force_Initial_Renorm || (ls->Renorm_Freq != 0 && ls->Renorm_Countdown == 0));
 
@@ -2436,6 +2438,7 @@ void solve_problem_segregated(Exo_DB *exo, /* ptr to the finite element mesh dat
           case HUYGENS:
           case HUYGENS_C:
           case HUYGENS_MASS_ITER:
+          case FAST_MARCHING:
             Renorm_Now =
                 (ls->Renorm_Freq != 0 && ls->Renorm_Countdown == 0) || ls_adc_event == TRUE;
 
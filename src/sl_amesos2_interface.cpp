@@ -17,22 +17,169 @@
 #include <Tpetra_FECrsMatrix.hpp>
 #include <Tpetra_Map.hpp>
 #include <Tpetra_MultiVector.hpp>
+#include <TpetraCore_config.h>
 #include <filesystem>
 
 #include "linalg/sparse_matrix.h"
 #include "linalg/sparse_matrix_tpetra.h"
 #include "sl_amesos2_interface.h"
 
+extern "C" {
+#define DISABLE_CPP
+#include "mm_as.h"
+#include "mm_eh.h"
+#include "rf_mp.h"
+#include "rf_solver.h"
+#include "rf_solver_const.h"
+#undef DISABLE_CPP
+}
+
 using MAT = Tpetra::CrsMatrix<double, LO, GO>;
 using VEC = Tpetra::Vector<double, LO, GO>;
 using MV = Tpetra::MultiVector<double, LO, GO>;
+#ifdef HAVE_TPETRA_INST_FLOAT
+using MAT_F = Tpetra::CrsMatrix<float, LO, GO>;
+using MV_F = Tpetra::MultiVector<float, LO, GO>;
+#endif
 
 struct Amesos2_Solver_Data {
   Teuchos::RCP<Amesos2::Solver<MAT, MV>> solver;
+#ifdef HAVE_TPETRA_INST_FLOAT
+  // single precision copy of the matrix and its factorization for mixed precision
+  Teuchos::RCP<MAT_F> matrix_f;
+  Teuchos::RCP<Amesos2::Solver<MAT_F, MV_F>> solver_f;
+#endif
 
   Amesos2_Solver_Data() { solver = Teuchos::null; }
 };
 
+static Teuchos::RCP<Teuchos::ParameterList> amesos2_read_parameters(char *amesos2_file) {
+  if (amesos2_file == NULL || strlen(amesos2_file) == 0) {
+    return Teuchos::null;
+  }
+  std::filesystem::path path(amesos2_file);
+  if (path.extension() == ".yaml") {
+    return Teuchos::getParametersFromYamlFile(amesos2_file);
+  }
+  return Teuchos::getParametersFromXmlFile(amesos2_file);
+}
+
+/*
+ * Factor and solve A x = b in double precision, the factorization is set
+ * up on the first call and reused for later matrices on the same graph.
+ */
+static void amesos2_direct_solve(Amesos2_Solver_Data *solver_data,
+                                 TpetraSparseMatrix *tpetra_data,
+                                 Teuchos::RCP<VEC> x,
+                                 Teuchos::RCP<VEC> b,
+                                 char *amesos2_solver,
+                                 char *amesos2_file) {
+  if (solver_data->solver.is_null()) {
+    Teuchos::RCP<MAT> crs_matrix = Teuchos::rcp_dynamic_cast<MAT>(tpetra_data->matrix);
+    solver_data->solver = Amesos2::create<MAT, MV>(amesos2_solver, crs_matrix);
+    auto amesos2_params = amesos2_read_parameters(amesos2_file);
+    if (!amesos2_params.is_null()) {
+      solver_data->solver->setParameters(amesos2_params);
+    }
+
+    solver_data->solver->symbolicFactorization();
+  }
+  solver_data->solver->numericFactorization();
+
+  solver_data->solver->solve(x.ptr(), b.ptr());
+}
+
+#ifdef HAVE_TPETRA_INST_FLOAT
+/*
+ * Mixed precision solve, the factorization is computed and applied in
+ * single precision and the solution is refined against the double
+ * precision matrix until ||b - A x|| <= tol ||b||. Refinement stops early
+ * once a step no longer reduces the residual, and the best iterate is
+ * returned in x. The number of refinement steps taken goes to *steps and
+ * the relative residual reached to ams->achievedTol. Returns one of the
+ * REFINEMENT_* outcomes, REFINEMENT_DIVERGED when no step improved on the
+ * first single precision solve, which amesos2_solve() then redoes in double
+ * precision.
+ */
+static int amesos2_refine(struct GomaLinearSolverData *ams,
+                          Amesos2_Solver_Data *solver_data,
+                          Teuchos::RCP<Tpetra::FECrsMatrix<double, LO, GO>> A,
+                          Teuchos::RCP<Tpetra::CrsGraph<LO, GO>> graph,
+                          VEC &x,
+                          const VEC &b,
+                          char *amesos2_solver,
+                          char *amesos2_file,
+                          int max_steps,
+                          double tol,
+                          int *steps) {
+  using execution_space = typename MAT::execution_space;
+
+  if (solver_data->matrix_f.is_null()) {
+    solver_data->matrix_f = Teuchos::rcp(new MAT_F(graph));
+    solver_data->matrix_f->fillComplete(A->getDomainMap(), A->getRangeMap());
+  }
+  auto values = A->getLocalMatrixDevice().values;
+  auto values_f = solver_data->matrix_f->getLocalMatrixDevice().values;
+  Kokkos::parallel_for(
+      "amesos2_float_copy", Kokkos::RangePolicy<execution_space>(0, values.extent(0)),
+      KOKKOS_LAMBDA(const size_t k) { values_f(k) = static_cast<float>(values(k)); });
+
+  if (solver_data->solver_f.is_null()) {
+    solver_data->solver_f = Amesos2::create<MAT_F, MV_F>(amesos2_solver, solver_data->matrix_f);
+    auto amesos2_params = amesos2_read_parameters(amesos2_file);
+    if (!amesos2_params.is_null()) {
+      solver_data->solver_f->setParameters(amesos2_params);
+    }
+    solver_data->solver_f->symbolicFactorization();
+  }
+  solver_data->solver_f->numericFactorization();
+
+  VEC r(b.getMap());
+  VEC d(b.getMap());
+  Teuchos::RCP<MV_F> r_f = Teuchos::rcp(new MV_F(b.getMap(), 1));
+  Teuchos::RCP<MV_F> d_f = Teuchos::rcp(new MV_F(b.getMap(), 1));
+  double b_norm = b.norm2();
+  if (b_norm == 0) {
+    b_norm = 1.0;
+  }
+
+  VEC x_best(x, Teuchos::Copy);
+  double best_ratio = -1.0;
+  int best_step = 0;
+  bool stalled = false;
+  int step = 0;
+  while (true) {
+    A->apply(x, r);
+    r.update(1.0, b, -1.0);
+    double res_ratio = r.norm2() / b_norm;
+    if (best_ratio >= 0 && !(res_ratio < best_ratio)) {
+      stalled = true;
+      break;
+    }
+    best_ratio = res_ratio;
+    best_step = step;
+    if (res_ratio <= tol || step == max_steps) {
+      break;
+    }
+    Tpetra::deep_copy(x_best, x);
+    Tpetra::deep_copy(*r_f, r);
+    solver_data->solver_f->solve(d_f.ptr(), r_f.ptr());
+    Tpetra::deep_copy(d, *d_f);
+    x.update(1.0, d, 1.0);
+    step++;
+  }
+  if (stalled) {
+    Tpetra::deep_copy(x, x_best);
+  }
+  ams->achievedTol = best_ratio;
+  *steps = best_step;
+  if (best_ratio <= tol) {
+    return REFINEMENT_CONVERGED;
+  }
+  return (stalled && best_step <= 1) ? REFINEMENT_DIVERGED : REFINEMENT_MAXITS;
+}
+#endif
+
 extern "C" void amesos2_solver_destroy(struct GomaLinearSolverData *ams) {
   auto solver_data = static_cast<Amesos2_Solver_Data *>(ams->SolverData);
   delete solver_data;
@@ -42,6 +189,7 @@ extern "C" {
 int amesos2_solve(struct GomaLinearSolverData *ams,
                   double *x_,
                   double *b_,
+                  int *iterations,
                   char *amesos2_solver,
                   char *amesos2_file) {
   using Teuchos::RCP;
@@ -49,6 +197,7 @@ int amesos2_solve(struct GomaLinearSolverData *ams,
   auto *tpetra_data = static_cast<TpetraSparseMatrix *>(matrix->data);
   bool success = true;
   bool verbose = true;
+  int refinement = REFINEMENT_CONVERGED;
 
   if (ams->SolverData == NULL) {
     ams->SolverData = new Amesos2_Solver_Data();
@@ -71,25 +220,28 @@ int amesos2_solve(struct GomaLinearSolverData *ams,
       tpetra_b->replaceGlobalValue(matrix->global_ids[i], b_[i]);
     }
 
-    if (solver_data->solver.is_null()) {
-      Teuchos::RCP<MAT> crs_matrix = Teuchos::rcp_dynamic_cast<MAT>(tpetra_data->matrix);
-      solver_data->solver = Amesos2::create<MAT, MV>(amesos2_solver, crs_matrix);
-      if (amesos2_file != NULL && strlen(amesos2_file) > 0) {
-        std::filesystem::path path(amesos2_file);
-        Teuchos::RCP<Teuchos::ParameterList> amesos2_params;
-        if (path.extension() == ".yaml") {
-          amesos2_params = Teuchos::getParametersFromYamlFile(amesos2_file);
-        } else {
-          amesos2_params = Teuchos::getParametersFromXmlFile(amesos2_file);
-        }
-        solver_data->solver->setParameters(amesos2_params);
+    *iterations = 1;
+    if (upd->Linear_Solve_Precision[pg->imtrx] == LINEAR_PRECISION_MIXED) {
+#ifdef HAVE_TPETRA_INST_FLOAT
+      double tol = ams->forcingTol > 0 ? ams->forcingTol : Epsilon[pg->imtrx][1];
+      if (tol <= 0) {
+        tol = REFINEMENT_DEFAULT_TOL;
       }
-
-      solver_data->solver->symbolicFactorization();
+      refinement = amesos2_refine(ams, solver_data, tpetra_data->matrix, tpetra_data->crs_graph,
+                                  *tpetra_x, *tpetra_b, amesos2_solver, amesos2_file,
+                                  upd->Refinement_Max_Steps[pg->imtrx], tol, iterations);
+      /* the single precision factors are no use, solve in double instead */
+      if (refinement == REFINEMENT_DIVERGED) {
+        amesos2_direct_solve(solver_data, tpetra_data, tpetra_x, tpetra_b, amesos2_solver,
+                             amesos2_file);
+      }
+#else
+      GOMA_EH(GOMA_ERROR, "Linear Solve Precision = mixed needs Tpetra built with float");
+#endif
+    } else {
+      amesos2_direct_solve(solver_data, tpetra_data, tpetra_x, tpetra_b, amesos2_solver,
+                           amesos2_file);
     }
-    solver_data->solver->numericFactorization();
-
-    solver_data->solver->solve(tpetra_x.ptr(), tpetra_b.ptr());
 
     Teuchos::RCP<Teuchos::FancyOStream> outstream = Teuchos::VerboseObjectBase::getDefaultOStream();
 
@@ -100,14 +252,17 @@ int amesos2_solve(struct GomaLinearSolverData *ams,
     for (int i = 0; i < NumMyRows; i++) {
       x_[i] = x_data[i];
     }
+    if (matrix->unscale_solution != NULL) {
+      matrix->unscale_solution(matrix, x_);
+    }
     tpetra_data->matrix->beginAssembly();
   }
   TEUCHOS_STANDARD_CATCH_STATEMENTS(verbose, std::cerr, success)
   if (success) {
-    return 0;
+    return refinement;
   }
 
-  return 1;
+  return -1;
 }
 
 } /* End extern "C" */
@@ -124,7 +279,8 @@ int amesos2_solve(struct GomaLinearSolverData *ams,
                   double *x_,
                   double *b_,
                   int *iterations,
-                  char *stratimikos_file) {
+                  char *amesos2_solver,
+                  char *amesos2_file) {
   GOMA_EH(GOMA_ERROR, "Not built with Amesos2 support!");
   return -1;
 }
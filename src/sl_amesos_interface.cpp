@@ -13,8 +13,10 @@
 \************************************************************************/
 
 #include <Amesos_config.h>
+#include <algorithm>
 #include <stdlib.h>
 #include <string>
+#include <vector>
 
 #include "Amesos_BaseSolver.h"
 #include "Epetra_ConfigDefs.h"
@@ -64,7 +66,10 @@
 #include "linalg/sparse_matrix_epetra.h"
 #include "sl_util_structs.h"
 
-static void GomaMsr2EpetraCsr(struct GomaLinearSolverData *ams, Epetra_CrsMatrix *A, int newmatrix);
+static void GomaMsr2EpetraCsr(struct GomaLinearSolverData *ams,
+                              Epetra_CrsMatrix *A,
+                              std::vector<int> &msr_position,
+                              int newmatrix);
 void amesos_solve(char *choice,
                   struct GomaLinearSolverData *ams,
                   double *x_,
@@ -83,6 +88,7 @@ void amesos_solve(char *choice,
   static Epetra_CrsMatrix *A[MAX_NUM_MATRICES]{nullptr};
   static Epetra_LinearProblem Problem[MAX_NUM_MATRICES];
   static Amesos_BaseSolver *A_Base[MAX_NUM_MATRICES] = {nullptr};
+  static std::vector<int> Msr_Position[MAX_NUM_MATRICES];
   Amesos A_Factory;
 
   /* Convert to Epetra format */
@@ -92,7 +98,7 @@ void amesos_solve(char *choice,
         delete A[imtrx];
       A[imtrx] = (Epetra_CrsMatrix *)construct_Epetra_CrsMatrix(ams);
     }
-    GomaMsr2EpetraCsr(ams, A[imtrx], !ams->solveSetup);
+    GomaMsr2EpetraCsr(ams, A[imtrx], Msr_Position[imtrx], !ams->solveSetup);
   } else {
     GomaSparseMatrix matrix = (GomaSparseMatrix)ams->GomaMatrixData;
     EpetraSparseMatrix *epetra_matrix = static_cast<EpetraSparseMatrix *>(matrix->data);
@@ -177,15 +183,22 @@ void amesos_solve(char *choice,
   ams->solveSetup = 1;
 }
 
-static void GomaMsr2EpetraCsr(struct GomaLinearSolverData *ams, Epetra_CrsMatrix *A, int newmatrix)
+/*
+ * Copy the MSR matrix into the Epetra matrix A.
+ *
+ * For a new matrix the structure is inserted with global indices and
+ * completed, and msr_position records where every MSR value lands in the
+ * Epetra row storage: msr_position[i] for the diagonal of row i and
+ * msr_position[k] for the off diagonal val[k]. Later solves with the same
+ * structure are a straight value copy through msr_position, with no
+ * boundary exchange, index lookups or FillComplete.
+ */
+static void GomaMsr2EpetraCsr(struct GomaLinearSolverData *ams,
+                              Epetra_CrsMatrix *A,
+                              std::vector<int> &msr_position,
+                              int newmatrix)
 
 {
-#ifdef EPETRA_MPI
-  Epetra_MpiComm comm(MPI_COMM_WORLD);
-#else
-  Epetra_SerialComm comm;
-#endif
-
   int *bindx = ams->bindx;
   double *val = ams->val;
 
@@ -193,61 +206,69 @@ static void GomaMsr2EpetraCsr(struct GomaLinearSolverData *ams, Epetra_CrsMatrix
   int NumExternal = ams->data_org[AZ_N_external];
   int NumMyCols = NumMyRows + NumExternal;
 
-  (*A).PutScalar(0.0);
+  int NumEntries;
+  double *RowValues;
+  int *RowIndices;
+
+  if (!newmatrix) {
+    for (int i = 0; i < NumMyRows; i++) {
+      (*A).ExtractMyRowView(i, NumEntries, RowValues, RowIndices);
+      RowValues[msr_position[i]] = val[i];
+      for (int k = bindx[i]; k < bindx[i + 1]; k++) {
+        RowValues[msr_position[k]] = val[k];
+      }
+    }
+    return;
+  }
 
   const Epetra_Map &RowMap = (*A).RowMatrixRowMap();
 
   int *MyGlobalElements = RowMap.MyGlobalElements();
 
-  double *dblColGIDs = new double[NumMyCols];
-  int *ColGIDs = new int[NumMyCols];
+  std::vector<double> dblColGIDs(NumMyCols);
+  std::vector<int> ColGIDs(NumMyCols);
 
   for (int i = 0; i < NumMyRows; i++)
     dblColGIDs[i] = (double)MyGlobalElements[i];
 
-  AZ_exchange_bdry(dblColGIDs, ams->data_org, ams->proc_config);
+  AZ_exchange_bdry(dblColGIDs.data(), ams->data_org, ams->proc_config);
 
-  {
-    for (int j = 0; j < NumMyCols; j++)
-      ColGIDs[j] = (int)dblColGIDs[j];
-  }
+  for (int j = 0; j < NumMyCols; j++)
+    ColGIDs[j] = (int)dblColGIDs[j];
 
   int MaxNNZ = 0;
   for (int i = 0; i < NumMyRows; i++) {
-    int NumNz = bindx[i + 1] - bindx[i] + 1;
-
-    if (NumNz > MaxNNZ)
-      MaxNNZ = NumNz;
+    MaxNNZ = std::max(MaxNNZ, bindx[i + 1] - bindx[i]);
   }
 
-  int *Indices = new int[MaxNNZ];
-  double *Values;
+  std::vector<int> Indices(MaxNNZ);
 
   for (int i = 0; i < NumMyRows; i++) {
     int NumNz = bindx[i + 1] - bindx[i];
-
-    int *k = bindx + bindx[i];
     for (int j = 0; j < NumNz; j++) {
-      Indices[j] = ColGIDs[*k];
-      k++;
-    }
-
-    Values = val + bindx[i];
-
-    if (newmatrix) {
-      (*A).InsertGlobalValues(MyGlobalElements[i], NumNz, Values, Indices);
-      (*A).InsertGlobalValues(MyGlobalElements[i], 1, &(val[i]), MyGlobalElements + i);
-    } else {
-      (*A).SumIntoGlobalValues(MyGlobalElements[i], NumNz, Values, Indices);
-      (*A).SumIntoGlobalValues(MyGlobalElements[i], 1, &(val[i]), MyGlobalElements + i);
+      Indices[j] = ColGIDs[bindx[bindx[i] + j]];
     }
+    (*A).InsertGlobalValues(MyGlobalElements[i], NumNz, val + bindx[i], Indices.data());
+    (*A).InsertGlobalValues(MyGlobalElements[i], 1, &(val[i]), MyGlobalElements + i);
   }
 
   (*A).FillComplete();
 
-  delete[] dblColGIDs;
-  delete[] ColGIDs;
-  delete[] Indices;
+  /* Locate every MSR value in the sorted local rows of the completed matrix */
+  const Epetra_Map &ColMap = (*A).ColMap();
+  msr_position.assign(bindx[NumMyRows], -1);
+  auto row_position = [&](int gid) {
+    int lid = ColMap.LID(gid);
+    return static_cast<int>(std::lower_bound(RowIndices, RowIndices + NumEntries, lid) -
+                            RowIndices);
+  };
+  for (int i = 0; i < NumMyRows; i++) {
+    (*A).ExtractMyRowView(i, NumEntries, RowValues, RowIndices);
+    msr_position[i] = row_position(MyGlobalElements[i]);
+    for (int k = bindx[i]; k < bindx[i + 1]; k++) {
+      msr_position[k] = row_position(ColGIDs[bindx[k]]);
+    }
+  }
 
   return;
 }
@@ -86,6 +86,7 @@ void aztecoo_solve_epetra(struct GomaLinearSolverData *ams, double *x_, double *
   /* Solve problem */
   solver.Iterate(max_iterations, tolerance);
   solver.GetAllAztecStatus(ams->status);
+  ams->achievedTol = ams->status[AZ_scaled_r];
 
   /* Convert solution vector */
   int NumMyRows = map.NumMyElements();
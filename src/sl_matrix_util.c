@@ -825,6 +825,13 @@ int check_compatible_solver(void) {
     default:
       return GOMA_ERROR;
     }
+  } else if (strcmp(Matrix_Format, "tpetra_block") == 0) {
+    switch (Linear_Solver) {
+    case STRATIMIKOS:
+      return GOMA_SUCCESS;
+    default:
+      return GOMA_ERROR;
+    }
   } else if (strcmp(Matrix_Format, "epetra") == 0) {
     switch (Linear_Solver) {
     case AZTECOO:
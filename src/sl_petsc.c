@@ -1282,6 +1282,13 @@ goma_error goma_setup_petsc_matrix(struct GomaLinearSolverData *ams,
   PetscMatrixData *matrix_data = malloc(sizeof(struct PetscMatrixData));
 
   ams->PetscMatrixData = (void *)matrix_data;
+  matrix_data->mat_free = NULL;
+  matrix_data->mf_base = NULL;
+  matrix_data->mf_base_resid = NULL;
+  matrix_data->mf_residual = NULL;
+  matrix_data->mf_ctx = NULL;
+  matrix_data->mf_x = NULL;
+  matrix_data->mf_resid = NULL;
 
   if (GomaPetscOptions != NULL && !GomaPetscOptionsInserted) {
     err = PetscOptionsInsertString(NULL, GomaPetscOptions);
@@ -1710,6 +1717,95 @@ int petsc_zero_mat(struct GomaLinearSolverData *ams) {
   return 0;
 }
 
+/*
+ * Residual evaluation for the matrix free Jacobian, J v is approximated by
+ * PETSc as (F(x + h v) - F(x)) / h with F the scaled Goma residual
+ */
+static PetscErrorCode petsc_matrix_free_function(void *ctx, Vec x, Vec f) {
+  struct GomaLinearSolverData *ams = (struct GomaLinearSolverData *)ctx;
+  PetscMatrixData *matrix_data = (PetscMatrixData *)ams->PetscMatrixData;
+  PetscInt n = num_internal_dofs[pg->imtrx] + num_boundary_dofs[pg->imtrx];
+  PetscErrorCode err;
+
+  err = VecGetValues(x, n, matrix_data->local_to_global, matrix_data->mf_x);
+  CHKERRQ(err);
+  exchange_dof(cx[pg->imtrx], DPI_ptr, matrix_data->mf_x, pg->imtrx);
+  if (matrix_data->mf_residual(matrix_data->mf_ctx, matrix_data->mf_x, matrix_data->mf_resid) ==
+      -1) {
+    SETERRQ(PETSC_COMM_SELF, PETSC_ERR_NOT_CONVERGED, "residual fill failed in matrix free J v");
+  }
+  err = VecSetValues(f, n, matrix_data->local_to_global, matrix_data->mf_resid, INSERT_VALUES);
+  CHKERRQ(err);
+  err = VecAssemblyBegin(f);
+  CHKERRQ(err);
+  err = VecAssemblyEnd(f);
+  CHKERRQ(err);
+  return 0;
+}
+
+/*
+ * Matrix Free Newton, the Krylov operator becomes a finite difference
+ * Jacobian linearized about x, with residual resid, and the assembled
+ * matrix is only used to build the preconditioner. When
+ * reuse_preconditioner is set the matrix was not reassembled for this
+ * Newton step and the last preconditioner is kept.
+ */
+goma_error petsc_matrix_free_set_base(struct GomaLinearSolverData *ams,
+                                      PetscMatrixFreeResidual residual,
+                                      void *ctx,
+                                      double *x,
+                                      double *resid,
+                                      PetscBool reuse_preconditioner) {
+  PetscMatrixData *matrix_data = (PetscMatrixData *)ams->PetscMatrixData;
+  PetscInt n = num_internal_dofs[pg->imtrx] + num_boundary_dofs[pg->imtrx];
+  PetscErrorCode err;
+
+  if (matrix_data->mat_free == NULL) {
+    PetscInt global_n;
+    err = VecGetSize(matrix_data->residual, &global_n);
+    CHKERRQ(err);
+    err = MatCreateMFFD(MPI_COMM_WORLD, n, n, global_n, global_n, &matrix_data->mat_free);
+    CHKERRQ(err);
+    err = MatSetOptionsPrefix(matrix_data->mat_free, "mf_");
+    CHKERRQ(err);
+    err = MatSetFromOptions(matrix_data->mat_free);
+    CHKERRQ(err);
+    err = MatMFFDSetFunction(matrix_data->mat_free, petsc_matrix_free_function, ams);
+    CHKERRQ(err);
+    err = VecDuplicate(matrix_data->residual, &matrix_data->mf_base);
+    CHKERRQ(err);
+    err = VecDuplicate(matrix_data->residual, &matrix_data->mf_base_resid);
+    CHKERRQ(err);
+    matrix_data->mf_x = calloc(NumUnknowns[pg->imtrx] + NumExtUnknowns[pg->imtrx], sizeof(double));
+    matrix_data->mf_resid =
+        calloc(NumUnknowns[pg->imtrx] + NumExtUnknowns[pg->imtrx], sizeof(double));
+    err = KSPSetOperators(matrix_data->ksp, matrix_data->mat_free, matrix_data->mat);
+    CHKERRQ(err);
+  }
+  matrix_data->mf_residual = residual;
+  matrix_data->mf_ctx = ctx;
+
+  err = VecSetValues(matrix_data->mf_base, n, matrix_data->local_to_global, x, INSERT_VALUES);
+  CHKERRQ(err);
+  err = VecSetValues(matrix_data->mf_base_resid, n, matrix_data->local_to_global, resid,
+                     INSERT_VALUES);
+  CHKERRQ(err);
+  VecAssemblyBegin(matrix_data->mf_base);
+  VecAssemblyEnd(matrix_data->mf_base);
+  VecAssemblyBegin(matrix_data->mf_base_resid);
+  VecAssemblyEnd(matrix_data->mf_base_resid);
+
+  err = MatMFFDSetBase(matrix_data->mat_free, matrix_data->mf_base, matrix_data->mf_base_resid);
+  CHKERRQ(err);
+  err = MatAssemblyBegin(matrix_data->mat_free, MAT_FINAL_ASSEMBLY);
+  CHKERRQ(err);
+  err = MatAssemblyEnd(matrix_data->mat_free, MAT_FINAL_ASSEMBLY);
+  CHKERRQ(err);
+  err = KSPSetReusePreconditioner(matrix_data->ksp, reuse_preconditioner);
+  CHKERRQ(err);
+  return GOMA_SUCCESS;
+}
+
 // vim: expandtab sw=2 ts=8
 int petsc_solve(struct GomaLinearSolverData *ams, double *x_, double *b_, int *its) {
   PetscMatrixData *matrix_data = (PetscMatrixData *)ams->PetscMatrixData;
@@ -1759,10 +1855,27 @@ int petsc_solve(struct GomaLinearSolverData *ams, double *x_, double *b_, int *i
   VecAssemblyBegin(matrix_data->update);
   VecAssemblyEnd(matrix_data->update);
 
+  /* inexact Newton forcing term overrides the relative tolerance for this solve */
+  PetscReal rtol, abstol, dtol;
+  PetscInt maxits;
+  PetscReal rhs_norm = 0;
+  KSPGetTolerances(matrix_data->ksp, &rtol, &abstol, &dtol, &maxits);
+  if (ams->forcingTol > 0) {
+    KSPSetTolerances(matrix_data->ksp, ams->forcingTol, abstol, dtol, maxits);
+    VecNorm(matrix_data->residual, NORM_2, &rhs_norm);
+  }
+
   KSPSolve(matrix_data->ksp, matrix_data->residual, matrix_data->update);
   PetscInt pits;
   KSPGetIterationNumber(matrix_data->ksp, &pits);
   *its = pits;
+
+  if (ams->forcingTol > 0) {
+    PetscReal rnorm;
+    KSPGetResidualNorm(matrix_data->ksp, &rnorm);
+    ams->achievedTol = rhs_norm > 0 ? rnorm / rhs_norm : 0;
+    KSPSetTolerances(matrix_data->ksp, rtol, abstol, dtol, maxits);
+  }
   VecGetValues(matrix_data->update, num_internal_dofs[pg->imtrx] + num_boundary_dofs[pg->imtrx],
                matrix_data->local_to_global, x_);
   return 0;
@@ -1815,6 +1928,16 @@ goma_error goma_petsc_free_matrix(struct GomaLinearSolverData *ams) {
   CHKERRQ(err);
   err = KSPDestroy(&matrix_data->ksp);
   CHKERRQ(err);
+  if (matrix_data->mat_free != NULL) {
+    err = MatDestroy(&matrix_data->mat_free);
+    CHKERRQ(err);
+    err = VecDestroy(&matrix_data->mf_base);
+    CHKERRQ(err);
+    err = VecDestroy(&matrix_data->mf_base_resid);
+    CHKERRQ(err);
+    free(matrix_data->mf_x);
+    free(matrix_data->mf_resid);
+  }
 
   return GOMA_SUCCESS;
 }
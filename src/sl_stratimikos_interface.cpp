@@ -42,6 +42,7 @@
 #include "Thyra_TpetraThyraWrappers.hpp"
 #include "Thyra_TpetraVector.hpp"
 #include "linalg/sparse_matrix_tpetra.h"
+#include "linalg/sparse_matrix_tpetra_block.h"
 #endif
 
 #include "EpetraExt_RowMatrixOut.h"
@@ -65,16 +66,41 @@
 #include "sl_stratimikos_interface.h"
 #include "sl_util_structs.h"
 
+extern "C" {
+#define DISABLE_CPP
+#include "md_timer.h"
+#include "mm_as.h"
+#include "rf_fem.h"
+#include "rf_fem_const.h"
+#include "rf_mp.h"
+#include "rf_solver_const.h"
+#undef DISABLE_CPP
+}
+
 struct Stratimikos_Solver_Data {
   Teuchos::RCP<Thyra::LinearOpWithSolveBase<double>> solver;
   Teuchos::RCP<Teuchos::ParameterList> solverParams;
   Teuchos::RCP<Thyra::LinearOpWithSolveFactoryBase<double>> solverFactory;
   Teuchos::RCP<const Thyra::LinearOpBase<double>> A;
 
+  // preconditioner reuse state, see stratimikos_prepare_solver
+  int reuse_solves;     // solves with the current preconditioner
+  int reuse_steps;      // time steps started with the current preconditioner
+  int setup_iterations; // linear iterations of the first solve, -1 before it
+  double reuse_time;    // time value of the last solve
+  bool force_setup;     // the current preconditioner has stopped working
+  const void *reuse_op; // operator the solver was set up for
+
   Stratimikos_Solver_Data() {
     solver = Teuchos::null;
     solverParams = Teuchos::null;
     solverFactory = Teuchos::null;
+    reuse_solves = 0;
+    reuse_steps = 0;
+    setup_iterations = -1;
+    reuse_time = 0.0;
+    force_setup = false;
+    reuse_op = NULL;
   }
 };
 
@@ -156,6 +182,95 @@ static void stratimikos_solve_setup(RCP<const Thyra::LinearOpBase<double>> A,
   // }
 }
 
+static void stratimikos_reset_reuse(Stratimikos_Solver_Data *solver_data) {
+  solver_data->reuse_solves = 0;
+  solver_data->reuse_steps = 0;
+  solver_data->setup_iterations = -1;
+  solver_data->force_setup = false;
+}
+
+/*
+ * Get the solver ready for solver_data->A following the Stratimikos
+ * Preconditioner Reuse policy, returns what was done for reporting.
+ *
+ * Without a policy the solver is built from scratch for every solve. With
+ * one the solver is kept: while the policy allows it the preconditioner is
+ * lagged and only the operator is updated ("reuse"), otherwise the solver
+ * is reinitialized in place ("refresh") so that preconditioners that
+ * support it keep their symbolic setup for the unchanged graph.
+ *
+ * A new matrix (after remeshing, ams->solveSetup is cleared) or a different
+ * operator always gets a solver built from scratch. Steady problems have
+ * no time steps, so the time policy counts Newton steps there.
+ */
+static const char *stratimikos_prepare_solver(struct GomaLinearSolverData *ams,
+                                              Stratimikos_Solver_Data *solver_data,
+                                              const void *op,
+                                              std::string stratimikos_file,
+                                              bool echo_params) {
+  double time_value = (tran != NULL) ? tran->time_value : 0.0;
+  bool new_op = !ams->solveSetup || solver_data->reuse_op != op;
+
+  ams->solveSetup = 1;
+  solver_data->reuse_op = op;
+  if (upd->Precond_Reuse == PRECOND_REUSE_NONE || solver_data->solver.is_null() || new_op) {
+    stratimikos_solve_setup(solver_data->A, solver_data, stratimikos_file, echo_params);
+    stratimikos_reset_reuse(solver_data);
+    solver_data->reuse_time = time_value;
+    return "setup";
+  }
+
+  if (time_value != solver_data->reuse_time) {
+    solver_data->reuse_steps++;
+    solver_data->reuse_time = time_value;
+  }
+
+  bool keep = !solver_data->force_setup;
+  if (upd->Precond_Reuse == PRECOND_REUSE_NEWTON || TimeIntegration == STEADY) {
+    keep = keep && solver_data->reuse_solves < upd->Precond_Reuse_Steps;
+  } else {
+    keep = keep && solver_data->reuse_steps < upd->Precond_Reuse_Steps;
+  }
+
+  if (keep) {
+    Thyra::initializeAndReuseOp(*(solver_data->solverFactory), solver_data->A,
+                                solver_data->solver.ptr());
+    return "reuse";
+  }
+
+  Thyra::initializeOp(*(solver_data->solverFactory), solver_data->A, solver_data->solver.ptr());
+  stratimikos_reset_reuse(solver_data);
+  return "refresh";
+}
+
+/*
+ * Update the reuse counters after a solve, a failed solve or one that took
+ * Precond_Reuse_Growth times the iterations of the first solve with the
+ * current preconditioner forces a new one
+ */
+static void stratimikos_finish_solve(Stratimikos_Solver_Data *solver_data,
+                                     const Thyra::SolveStatus<double> &status,
+                                     int iterations,
+                                     const char *action,
+                                     double setup_time,
+                                     double solve_time) {
+  if (upd->Precond_Reuse == PRECOND_REUSE_NONE) {
+    return;
+  }
+  solver_data->reuse_solves++;
+  if (status.solveStatus == Thyra::SOLVE_STATUS_UNCONVERGED) {
+    solver_data->force_setup = true;
+  }
+  if (solver_data->setup_iterations < 0) {
+    solver_data->setup_iterations = iterations;
+  } else if (upd->Precond_Reuse_Growth > 0 &&
+             iterations > upd->Precond_Reuse_Growth * MAX(solver_data->setup_iterations, 1)) {
+    solver_data->force_setup = true;
+  }
+  DPRINTF(stdout, "    stratimikos preconditioner %-7s setup %.3e s, solve %.3e s, %d its\n",
+          action, setup_time, solve_time, iterations);
+}
+
 extern "C" {
 #ifdef GOMA_ENABLE_TPETRA
 int stratimikos_solve_tpetra(struct GomaLinearSolverData *ams,
@@ -166,7 +281,6 @@ int stratimikos_solve_tpetra(struct GomaLinearSolverData *ams,
                              int imtrx) {
   using Teuchos::RCP;
   auto matrix = static_cast<GomaSparseMatrix>(ams->GomaMatrixData);
-  auto *tpetra_data = static_cast<TpetraSparseMatrix *>(matrix->data);
   bool success = true;
   bool verbose = true;
   static bool param_echo[MAX_NUM_MATRICES] = {true};
@@ -178,9 +292,15 @@ int stratimikos_solve_tpetra(struct GomaLinearSolverData *ams,
   auto solver_data = static_cast<Stratimikos_Solver_Data *>(ams->SolverData);
 
   try {
-    RCP<const Tpetra::FECrsMatrix<double, LO, GO>> tpetra_A = tpetra_data->matrix;
-    if (!tpetra_data->matrix->isFillComplete()) {
-      tpetra_data->matrix->endAssembly();
+    RCP<const Tpetra::Operator<double, LO, GO>> tpetra_A;
+    if (matrix->type == GOMA_SPARSE_MATRIX_TYPE_TPETRA_BLOCK) {
+      tpetra_A = static_cast<TpetraBlockSparseMatrix *>(matrix->data)->matrix;
+    } else {
+      auto *tpetra_data = static_cast<TpetraSparseMatrix *>(matrix->data);
+      if (!tpetra_data->matrix->isFillComplete()) {
+        tpetra_data->matrix->endAssembly();
+      }
+      tpetra_A = tpetra_data->matrix;
     }
 
     RCP<Tpetra::Vector<double, LO, GO>> tpetra_x =
@@ -201,8 +321,7 @@ int stratimikos_solve_tpetra(struct GomaLinearSolverData *ams,
     Tpetra::MatrixMarket::Writer<Tpetra::Vector<double, LO, GO>>::writeDenseFile("b.mm", tpetra_b);
 #endif
 
-    solver_data->A = Thyra::createConstLinearOp(
-        Teuchos::rcp_dynamic_cast<const Tpetra::Operator<double, LO, GO>>(tpetra_A));
+    solver_data->A = Thyra::createConstLinearOp(tpetra_A);
 
     RCP<Thyra::VectorBase<double>> x = Thyra::createVector(tpetra_x);
     RCP<const Thyra::VectorBase<double>> b = Thyra::createVector(tpetra_b);
@@ -219,12 +338,31 @@ int stratimikos_solve_tpetra(struct GomaLinearSolverData *ams,
       }
     }
 
-    stratimikos_solve_setup(solver_data->A, solver_data, stratimikos_file[imtrx],
-                            param_echo[imtrx]);
+    GOMA_PROF_BEGIN("precond_setup");
+    double setup_start = wall_time();
+    const char *action =
+        stratimikos_prepare_solver(ams, solver_data, tpetra_A.get(), stratimikos_file[imtrx],
+                                   param_echo[imtrx]);
+    double setup_time = wall_time() - setup_start;
+    GOMA_PROF_END("precond_setup");
     param_echo[imtrx] = false;
 
-    Thyra::SolveStatus<double> status =
-        Thyra::solve<double>(*(solver_data->solver), Thyra::NOTRANS, *b, x.ptr());
+    GOMA_PROF_BEGIN("krylov_solve");
+    double solve_start = wall_time();
+    Thyra::SolveCriteria<double> criteria(
+        Thyra::SolveMeasureType(Thyra::SOLVE_MEASURE_NORM_RESIDUAL, Thyra::SOLVE_MEASURE_NORM_RHS),
+        ams->forcingTol);
+    Teuchos::Ptr<const Thyra::SolveCriteria<double>> solve_criteria;
+    if (ams->forcingTol > 0) {
+      solve_criteria = Teuchos::ptrFromRef(criteria);
+    }
+    Thyra::SolveStatus<double> status = Thyra::solve<double>(
+        *(solver_data->solver), Thyra::NOTRANS, *b, x.ptr(), solve_criteria);
+    double solve_time = wall_time() - solve_start;
+    GOMA_PROF_END("krylov_solve");
+    if (status.achievedTol != Thyra::SolveStatus<double>::unknownTolerance()) {
+      ams->achievedTol = status.achievedTol;
+    }
 
     *iterations = 1;
     if (!status.extraParameters.is_null()) {
@@ -241,11 +379,19 @@ int stratimikos_solve_tpetra(struct GomaLinearSolverData *ams,
     for (int i = 0; i < NumMyRows; i++) {
       x_[i] = x_data[i];
     }
+    if (matrix->unscale_solution != NULL) {
+      matrix->unscale_solution(matrix, x_);
+    }
+    stratimikos_finish_solve(solver_data, status, *iterations, action, setup_time, solve_time);
     x = Teuchos::null;
-    Thyra::uninitializeOp(*(solver_data->solverFactory), solver_data->solver.ptr());
+    if (upd->Precond_Reuse == PRECOND_REUSE_NONE) {
+      Thyra::uninitializeOp(*(solver_data->solverFactory), solver_data->solver.ptr());
+    }
   }
   TEUCHOS_STANDARD_CATCH_STATEMENTS(verbose, std::cerr, success)
-  tpetra_data->matrix->beginAssembly();
+  if (matrix->type == GOMA_SPARSE_MATRIX_TYPE_TPETRA) {
+    static_cast<TpetraSparseMatrix *>(matrix->data)->matrix->beginAssembly();
+  }
 
   if (success) {
     return 0;
@@ -311,12 +457,31 @@ int stratimikos_solve(struct GomaLinearSolverData *ams,
       }
     }
 
-    stratimikos_solve_setup(solver_data->A, solver_data, stratimikos_file[imtrx],
-                            param_echo[imtrx]);
+    GOMA_PROF_BEGIN("precond_setup");
+    double setup_start = wall_time();
+    const char *action =
+        stratimikos_prepare_solver(ams, solver_data, epetra_A.get(), stratimikos_file[imtrx],
+                                   param_echo[imtrx]);
+    double setup_time = wall_time() - setup_start;
+    GOMA_PROF_END("precond_setup");
     param_echo[imtrx] = true;
 
-    Thyra::SolveStatus<double> status =
-        Thyra::solve<double>(*(solver_data->solver), Thyra::NOTRANS, *b, x.ptr());
+    GOMA_PROF_BEGIN("krylov_solve");
+    double solve_start = wall_time();
+    Thyra::SolveCriteria<double> criteria(
+        Thyra::SolveMeasureType(Thyra::SOLVE_MEASURE_NORM_RESIDUAL, Thyra::SOLVE_MEASURE_NORM_RHS),
+        ams->forcingTol);
+    Teuchos::Ptr<const Thyra::SolveCriteria<double>> solve_criteria;
+    if (ams->forcingTol > 0) {
+      solve_criteria = Teuchos::ptrFromRef(criteria);
+    }
+    Thyra::SolveStatus<double> status = Thyra::solve<double>(
+        *(solver_data->solver), Thyra::NOTRANS, *b, x.ptr(), solve_criteria);
+    double solve_time = wall_time() - solve_start;
+    GOMA_PROF_END("krylov_solve");
+    if (status.achievedTol != Thyra::SolveStatus<double>::unknownTolerance()) {
+      ams->achievedTol = status.achievedTol;
+    }
 
     x = Teuchos::null;
 
@@ -327,6 +492,7 @@ int stratimikos_solve(struct GomaLinearSolverData *ams,
       } catch (const Teuchos::Exceptions::InvalidParameter &excpt) {
       }
     }
+    stratimikos_finish_solve(solver_data, status, *iterations, action, setup_time, solve_time);
 
     /* Convert solution vector */
     int NumMyRows = map.NumMyElements();
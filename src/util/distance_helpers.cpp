@@ -1,8 +1,11 @@
+#include <algorithm>
 #include <array>
 #include <cmath>
 #include <cstddef>
-#include <fstream>
+#include <limits>
+#include <map>
 #include <memory>
+#include <mpi.h>
 #include <nanoflann.hpp>
 #include <unordered_set>
 #include <vector>
@@ -102,71 +105,191 @@ struct KDTreeVectorOfArraysAdaptor {
   /** @} */
 };
 
-template <int dim>
-void find_distances(coordinates_type side_coordinates,
-                    coordinates_type distance_coordinates,
-                    std::vector<double> &distances) {
-  KDTreeVectorOfArraysAdaptor<coordinates_type, double, dim> kd_tree(side_coordinates.size(),
-                                                                     side_coordinates, dim);
+namespace {
 
-  for (size_t i = 0; i < distance_coordinates.size(); i++) {
-    std::vector<size_t> ret_indexes(dim);
-    std::vector<double> out_dists_sqr(dim);
-    kd_tree.query(&distance_coordinates[i][0], 1, &ret_indexes[0], &out_dists_sqr[0]);
-    distances[i] = sqrt(out_dists_sqr[0]);
-  }
-}
+using KDTree = KDTreeVectorOfArraysAdaptor<coordinates_type, double>;
 
-extern "C" goma_error find_current_distances(Exo_DB *exo,
-                                             Dpi *dpi,
-                                             double *solution_vector,
-                                             bool apply_displacements,
-                                             int num_ns,
-                                             int *ns_ids,
-                                             int num_ss,
-                                             int *ss_ids,
-                                             double *distances) {
+/* A wall facet reduced to a point (node sets), a segment (2D sides) or a
+ * triangle (3D sides, quadrilateral faces are split in two) */
+struct WallFacet {
+  int num_points;
+  std::array<std::array<double, 3>, 3> x;
+};
 
-  const int dim = exo->num_dim;
+/* num_points followed by the three points */
+constexpr int facet_pack_size = 10;
 
-  if (dim != 2 && dim != 3) {
-    return GOMA_ERROR;
+/* Per rank box data shared with every rank: the wall box, the box of the
+ * nodes we need distances for, the number of wall facets and whether the
+ * wall moved since the last call */
+constexpr int box_pack_size = 14;
+
+constexpr int wall_distance_tag = 2101;
+
+struct BoundingBox {
+  std::array<double, 3> lo = {{std::numeric_limits<double>::max(),
+                               std::numeric_limits<double>::max(),
+                               std::numeric_limits<double>::max()}};
+  std::array<double, 3> hi = {{std::numeric_limits<double>::lowest(),
+                               std::numeric_limits<double>::lowest(),
+                               std::numeric_limits<double>::lowest()}};
+
+  bool empty() const { return lo[0] > hi[0]; }
+
+  void add(const std::array<double, 3> &p) {
+    for (int k = 0; k < 3; k++) {
+      lo[k] = std::min(lo[k], p[k]);
+      hi[k] = std::max(hi[k], p[k]);
+    }
   }
 
-  // get the coordinates of all the nodes
-  coordinates_type coordinates(exo->num_nodes);
-  for (int i = 0; i < exo->num_nodes; ++i) {
-    coordinates[i][0] = exo->x_coord[i];
-    coordinates[i][1] = exo->y_coord[i];
-    if (dim == 3) {
-      coordinates[i][2] = exo->z_coord[i];
-    } else {
-      coordinates[i][2] = 0.0;
+  // smallest distance between any two points of the boxes
+  double min_distance(const BoundingBox &other) const {
+    double d2 = 0.0;
+    for (int k = 0; k < 3; k++) {
+      double gap = std::max({0.0, lo[k] - other.hi[k], other.lo[k] - hi[k]});
+      d2 += gap * gap;
     }
+    return sqrt(d2);
+  }
 
-    // apply displacements to the nodes
-    if (apply_displacements) {
-      int index =
-          Index_Solution(i, MESH_DISPLACEMENT1, 0, 0, -1, upd->matrix_index[MESH_DISPLACEMENT1]);
-      if (index != -1)
-        coordinates[i][0] += solution_vector[index];
-      index =
-          Index_Solution(i, MESH_DISPLACEMENT2, 0, 0, -1, upd->matrix_index[MESH_DISPLACEMENT2]);
-      if (index != -1)
-        coordinates[i][1] += solution_vector[index];
-      if (dim == 3) {
-        index =
-            Index_Solution(i, MESH_DISPLACEMENT3, 0, 0, -1, upd->matrix_index[MESH_DISPLACEMENT3]);
-        GOMA_ASSERT_ALWAYS(index != -1);
-        if (index != -1)
-          coordinates[i][2] += solution_vector[index];
-      }
+  // largest distance between any two points of the boxes
+  double max_distance(const BoundingBox &other) const {
+    double d2 = 0.0;
+    for (int k = 0; k < 3; k++) {
+      double span = std::max(hi[k] - other.lo[k], other.hi[k] - lo[k]);
+      d2 += span * span;
+    }
+    return sqrt(d2);
+  }
+};
+
+inline double distance_squared(const std::array<double, 3> &a, const std::array<double, 3> &b) {
+  double d0 = a[0] - b[0];
+  double d1 = a[1] - b[1];
+  double d2 = a[2] - b[2];
+  return d0 * d0 + d1 * d1 + d2 * d2;
+}
+
+inline double dot(const std::array<double, 3> &a, const std::array<double, 3> &b) {
+  return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+inline std::array<double, 3> subtract(const std::array<double, 3> &a,
+                                      const std::array<double, 3> &b) {
+  return {{a[0] - b[0], a[1] - b[1], a[2] - b[2]}};
+}
+
+inline std::array<double, 3> axpy(const std::array<double, 3> &x,
+                                  double a,
+                                  const std::array<double, 3> &y) {
+  return {{x[0] + a * y[0], x[1] + a * y[1], x[2] + a * y[2]}};
+}
+
+/* Closest point on a triangle, following Ericson, Real-Time Collision
+ * Detection, section 5.1.5 */
+std::array<double, 3> closest_point_triangle(const std::array<double, 3> &p,
+                                             const std::array<double, 3> &a,
+                                             const std::array<double, 3> &b,
+                                             const std::array<double, 3> &c) {
+  std::array<double, 3> ab = subtract(b, a);
+  std::array<double, 3> ac = subtract(c, a);
+  std::array<double, 3> ap = subtract(p, a);
+  double d1 = dot(ab, ap);
+  double d2 = dot(ac, ap);
+  if (d1 <= 0.0 && d2 <= 0.0)
+    return a;
+
+  std::array<double, 3> bp = subtract(p, b);
+  double d3 = dot(ab, bp);
+  double d4 = dot(ac, bp);
+  if (d3 >= 0.0 && d4 <= d3)
+    return b;
+
+  double vc = d1 * d4 - d3 * d2;
+  if (vc <= 0.0 && d1 >= 0.0 && d3 <= 0.0)
+    return axpy(a, d1 / (d1 - d3), ab);
+
+  std::array<double, 3> cp = subtract(p, c);
+  double d5 = dot(ab, cp);
+  double d6 = dot(ac, cp);
+  if (d6 >= 0.0 && d5 <= d6)
+    return c;
+
+  double vb = d5 * d2 - d1 * d6;
+  if (vb <= 0.0 && d2 >= 0.0 && d6 <= 0.0)
+    return axpy(a, d2 / (d2 - d6), ac);
+
+  double va = d3 * d6 - d5 * d4;
+  if (va <= 0.0 && (d4 - d3) >= 0.0 && (d5 - d6) >= 0.0)
+    return axpy(b, (d4 - d3) / ((d4 - d3) + (d5 - d6)), subtract(c, b));
+
+  double denom = 1.0 / (va + vb + vc);
+  return axpy(axpy(a, vb * denom, ab), vc * denom, ac);
+}
+
+double facet_distance_squared(const std::array<double, 3> &p, const WallFacet &facet) {
+  switch (facet.num_points) {
+  case 1:
+    return distance_squared(p, facet.x[0]);
+  case 2: {
+    std::array<double, 3> ab = subtract(facet.x[1], facet.x[0]);
+    double len2 = dot(ab, ab);
+    double t = 0.0;
+    if (len2 > 0.0) {
+      t = std::min(1.0, std::max(0.0, dot(subtract(p, facet.x[0]), ab) / len2));
     }
+    return distance_squared(p, axpy(facet.x[0], t, ab));
   }
+  default:
+    return distance_squared(p, closest_point_triangle(p, facet.x[0], facet.x[1], facet.x[2]));
+  }
+}
+
+/* Persistent wall distance state for one combination of node sets and side
+ * sets, the wall facets and the kd-tree of their centroids are kept across
+ * calls and only rebuilt when the wall moves */
+struct WallDistanceEngine {
+  int dim = 0;
+
+  // local wall facets as exodus node numbers, these never change
+  std::vector<std::array<int, 3>> facet_nodes;
+  std::vector<int> facet_num_points;
+  std::vector<int> wall_nodes;
+
+  // wall node positions used for the current tree
+  coordinates_type wall_coordinates;
 
+  // local and received facets, the tree is built over their centroids
+  std::vector<WallFacet> facets;
+  coordinates_type centroids;
+  double max_radius = 0.0;
+  std::unique_ptr<KDTree> kd_tree;
+
+  // ranks whose facets each rank received for the current tree
+  std::vector<char> exchange_pattern;
+
+  coordinates_type node_coordinates;
+  std::vector<double> distances;
+  bool computed = false;
+
+  void setup_facets(Exo_DB *exo, Dpi *dpi, int num_ns, int *ns_ids, int num_ss, int *ss_ids);
+  void update_node_coordinates(Exo_DB *exo, double *solution_vector, bool apply_displacements);
+  bool update_wall_coordinates();
+  void gather_facets(Dpi *dpi, bool wall_moved);
+  void build_tree();
+  double query(const std::array<double, 3> &p) const;
+};
+
+void WallDistanceEngine::setup_facets(Exo_DB *exo,
+                                      Dpi *dpi,
+                                      int num_ns,
+                                      int *ns_ids,
+                                      int num_ss,
+                                      int *ss_ids) {
   std::unordered_set<int> set_nodes;
 
-  // Get nodes from sidesets
+  // Get facets from sidesets, sides of elements owned by this processor
   for (int in_ss_index = 0; in_ss_index < num_ss; in_ss_index++) {
     int ss_id = ss_ids[in_ss_index];
     int ss_index = -1;
@@ -180,17 +303,39 @@ extern "C" goma_error find_current_distances(Exo_DB *exo,
       GOMA_EH(GOMA_ERROR, "Side set %d not found", ss_id);
     }
     for (int side = 0; side < exo->ss_num_sides[ss_index]; side++) {
-      for (int lni = exo->ss_node_side_index[ss_index][side];
-           lni < exo->ss_node_side_index[ss_index][side + 1]; lni++) {
-        int inode = exo->ss_node_list[ss_index][lni];
-        if (dpi->num_proc == 0 || dpi->node_owner[inode] == dpi->rank) {
-          set_nodes.insert(inode);
+      int elem = exo->ss_elem_list[exo->ss_elem_index[ss_index] + side];
+      if (dpi->num_proc > 1 && dpi->elem_owner[elem] != dpi->rank) {
+        continue;
+      }
+      int first = exo->ss_node_side_index[ss_index][side];
+      int num_side_nodes = exo->ss_node_side_index[ss_index][side + 1] - first;
+      int *side_nodes = &exo->ss_node_list[ss_index][first];
+
+      // corner nodes come first, higher order nodes are not used
+      if (dim == 2) {
+        if (num_side_nodes < 2) {
+          GOMA_EH(GOMA_ERROR, "Side set %d has a side with %d nodes", ss_id, num_side_nodes);
         }
+        facet_nodes.push_back({{side_nodes[0], side_nodes[1], -1}});
+        facet_num_points.push_back(2);
+      } else if (num_side_nodes == 3 || num_side_nodes == 6 || num_side_nodes == 7) {
+        facet_nodes.push_back({{side_nodes[0], side_nodes[1], side_nodes[2]}});
+        facet_num_points.push_back(3);
+      } else if (num_side_nodes == 4 || num_side_nodes == 8 || num_side_nodes == 9) {
+        facet_nodes.push_back({{side_nodes[0], side_nodes[1], side_nodes[2]}});
+        facet_num_points.push_back(3);
+        facet_nodes.push_back({{side_nodes[0], side_nodes[2], side_nodes[3]}});
+        facet_num_points.push_back(3);
+      } else {
+        GOMA_EH(GOMA_ERROR, "Side set %d has a side with %d nodes", ss_id, num_side_nodes);
+      }
+      for (int i = 0; i < num_side_nodes; i++) {
+        set_nodes.insert(side_nodes[i]);
       }
     }
   }
 
-  // Get nodes from nodesets
+  // Get point facets from nodesets
   for (int in_ns_index = 0; in_ns_index < num_ns; in_ns_index++) {
     int ns_id = ns_ids[in_ns_index];
     int ns_index = -1;
@@ -206,70 +351,306 @@ extern "C" goma_error find_current_distances(Exo_DB *exo,
     for (int lni = 0; lni < exo->ns_num_nodes[ns_index]; lni++) {
       int inode = exo->ns_node_list[exo->ns_node_index[ns_index] + lni];
       if (dpi->num_proc == 0 || dpi->node_owner[inode] == dpi->rank) {
+        facet_nodes.push_back({{inode, -1, -1}});
+        facet_num_points.push_back(1);
         set_nodes.insert(inode);
       }
     }
   }
 
-  std::vector<int> local_side_nodes(set_nodes.begin(), set_nodes.end());
-
-  coordinates_type side_coordinates;
-  if (dpi->num_proc > 0) {
-    std::vector<size_t> proc_node_counts(dpi->num_proc);
-    size_t my_count = local_side_nodes.size();
-    size_t max_count = 0;
-    std::vector<size_t> global_counts(dpi->num_proc);
-    MPI_Allreduce(&my_count, &max_count, 1, MPI_UINT64_T, MPI_MAX, MPI_COMM_WORLD);
-    MPI_Allgather(&my_count, 1, MPI_UINT64_T, &proc_node_counts[0], 1, MPI_UINT64_T,
-                  MPI_COMM_WORLD);
-    size_t total_count = 0;
-    for (size_t i = 0; i < proc_node_counts.size(); i++) {
-      total_count += proc_node_counts[i];
+  wall_nodes.assign(set_nodes.begin(), set_nodes.end());
+}
+
+void WallDistanceEngine::update_node_coordinates(Exo_DB *exo,
+                                                 double *solution_vector,
+                                                 bool apply_displacements) {
+  node_coordinates.resize(exo->num_nodes);
+  for (int i = 0; i < exo->num_nodes; ++i) {
+    node_coordinates[i][0] = exo->x_coord[i];
+    node_coordinates[i][1] = exo->y_coord[i];
+    if (dim == 3) {
+      node_coordinates[i][2] = exo->z_coord[i];
+    } else {
+      node_coordinates[i][2] = 0.0;
+    }
+
+    // apply displacements to the nodes
+    if (apply_displacements) {
+      int index =
+          Index_Solution(i, MESH_DISPLACEMENT1, 0, 0, -1, upd->matrix_index[MESH_DISPLACEMENT1]);
+      if (index != -1)
+        node_coordinates[i][0] += solution_vector[index];
+      index =
+          Index_Solution(i, MESH_DISPLACEMENT2, 0, 0, -1, upd->matrix_index[MESH_DISPLACEMENT2]);
+      if (index != -1)
+        node_coordinates[i][1] += solution_vector[index];
+      if (dim == 3) {
+        index =
+            Index_Solution(i, MESH_DISPLACEMENT3, 0, 0, -1, upd->matrix_index[MESH_DISPLACEMENT3]);
+        GOMA_ASSERT_ALWAYS(index != -1);
+        if (index != -1)
+          node_coordinates[i][2] += solution_vector[index];
+      }
+    }
+  }
+}
+
+// Returns true when a local wall node moved since the tree was built
+bool WallDistanceEngine::update_wall_coordinates() {
+  bool moved = wall_coordinates.size() != wall_nodes.size();
+  wall_coordinates.resize(wall_nodes.size());
+  for (size_t i = 0; i < wall_nodes.size(); i++) {
+    if (wall_coordinates[i] != node_coordinates[wall_nodes[i]]) {
+      wall_coordinates[i] = node_coordinates[wall_nodes[i]];
+      moved = true;
     }
-    std::vector<double> global_coordinates(dpi->num_proc * max_count * dim);
-    std::vector<double> my_side_coordinates(max_count * dim);
-    std::fill(my_side_coordinates.begin(), my_side_coordinates.end(), NAN);
-    for (size_t i = 0; i < local_side_nodes.size(); i++) {
-      for (int j = 0; j < dim; j++) {
-        my_side_coordinates[i * dim + j] = coordinates[local_side_nodes[i]][j];
+  }
+  return moved;
+}
+
+/* Collect the local facets and the facets of the ranks whose wall box is
+ * close enough to our nodes to hold a nearest facet.  Only boxes are shared
+ * with every rank, facets go to the ranks that need them.  The tree is
+ * rebuilt when any wall moved or the set of ranks we need changed. */
+void WallDistanceEngine::gather_facets(Dpi *dpi, bool wall_moved) {
+  std::vector<WallFacet> local_facets(facet_nodes.size());
+  BoundingBox wall_box;
+  for (size_t f = 0; f < facet_nodes.size(); f++) {
+    local_facets[f].num_points = facet_num_points[f];
+    for (int j = 0; j < 3; j++) {
+      if (j < facet_num_points[f]) {
+        local_facets[f].x[j] = node_coordinates[facet_nodes[f][j]];
+        wall_box.add(local_facets[f].x[j]);
+      } else {
+        local_facets[f].x[j] = {{0.0, 0.0, 0.0}};
       }
     }
-    MPI_Allgather(my_side_coordinates.data(), max_count * dim, MPI_DOUBLE,
-                  global_coordinates.data(), max_count * dim, MPI_DOUBLE, MPI_COMM_WORLD);
-
-    side_coordinates.resize(total_count);
-    size_t offset_local = 0;
-    for (int i = 0; i < dpi->num_proc; i++) {
-      size_t offset = i * max_count * dim;
-      for (size_t j = 0; j < proc_node_counts[i]; j++) {
-        for (int k = 0; k < dim; k++) {
-          side_coordinates[offset_local][k] = global_coordinates[offset + j * dim + k];
-        }
-        offset_local++;
+  }
+
+  if (dpi->num_proc <= 1) {
+    if (wall_moved || kd_tree == nullptr) {
+      facets = std::move(local_facets);
+      build_tree();
+    }
+    return;
+  }
+
+  const int num_proc = dpi->num_proc;
+  const int rank = dpi->rank;
+
+  BoundingBox node_box;
+  for (const auto &p : node_coordinates) {
+    node_box.add(p);
+  }
+
+  std::vector<double> my_boxes(box_pack_size);
+  for (int k = 0; k < 3; k++) {
+    my_boxes[k] = wall_box.lo[k];
+    my_boxes[3 + k] = wall_box.hi[k];
+    my_boxes[6 + k] = node_box.lo[k];
+    my_boxes[9 + k] = node_box.hi[k];
+  }
+  my_boxes[12] = static_cast<double>(local_facets.size());
+  my_boxes[13] = wall_moved ? 1.0 : 0.0;
+
+  std::vector<double> all_boxes(num_proc * box_pack_size);
+  MPI_Allgather(my_boxes.data(), box_pack_size, MPI_DOUBLE, all_boxes.data(), box_pack_size,
+                MPI_DOUBLE, MPI_COMM_WORLD);
+
+  std::vector<BoundingBox> wall_boxes(num_proc);
+  std::vector<BoundingBox> node_boxes(num_proc);
+  std::vector<int> facet_counts(num_proc);
+  bool any_moved = false;
+  for (int p = 0; p < num_proc; p++) {
+    const double *box = &all_boxes[p * box_pack_size];
+    for (int k = 0; k < 3; k++) {
+      wall_boxes[p].lo[k] = box[k];
+      wall_boxes[p].hi[k] = box[3 + k];
+      node_boxes[p].lo[k] = box[6 + k];
+      node_boxes[p].hi[k] = box[9 + k];
+    }
+    facet_counts[p] = static_cast<int>(box[12]);
+    any_moved = any_moved || box[13] != 0.0;
+  }
+
+  // needs[r * num_proc + s]: rank r needs the facets of rank s.  Every point
+  // of a node box is within the largest box to box distance of some facet,
+  // so walls farther than the smallest such bound cannot hold a nearest facet.
+  std::vector<char> needs(num_proc * num_proc, 0);
+  for (int r = 0; r < num_proc; r++) {
+    if (node_boxes[r].empty())
+      continue;
+    double bound = std::numeric_limits<double>::max();
+    for (int s = 0; s < num_proc; s++) {
+      if (facet_counts[s] > 0) {
+        bound = std::min(bound, node_boxes[r].max_distance(wall_boxes[s]));
       }
     }
-  } else {
-    side_coordinates.resize(local_side_nodes.size());
-    for (size_t i = 0; i < local_side_nodes.size(); i++) {
-      for (int j = 0; j < dim; j++) {
-        side_coordinates[i][j] = coordinates[local_side_nodes[i]][j];
+    for (int s = 0; s < num_proc; s++) {
+      if (s != r && facet_counts[s] > 0 &&
+          node_boxes[r].min_distance(wall_boxes[s]) <= bound) {
+        needs[r * num_proc + s] = 1;
+      }
+    }
+  }
+
+  if (!any_moved && kd_tree != nullptr && needs == exchange_pattern) {
+    return;
+  }
+  exchange_pattern = needs;
+
+  std::vector<double> send_buffer(local_facets.size() * facet_pack_size);
+  for (size_t f = 0; f < local_facets.size(); f++) {
+    double *packed = &send_buffer[f * facet_pack_size];
+    packed[0] = local_facets[f].num_points;
+    for (int j = 0; j < 3; j++) {
+      for (int k = 0; k < 3; k++) {
+        packed[1 + 3 * j + k] = local_facets[f].x[j][k];
+      }
+    }
+  }
+
+  std::vector<std::vector<double>> recv_buffers(num_proc);
+  std::vector<MPI_Request> requests;
+  for (int s = 0; s < num_proc; s++) {
+    if (needs[rank * num_proc + s]) {
+      recv_buffers[s].resize(facet_counts[s] * facet_pack_size);
+      requests.emplace_back();
+      MPI_Irecv(recv_buffers[s].data(), facet_counts[s] * facet_pack_size, MPI_DOUBLE, s,
+                wall_distance_tag, MPI_COMM_WORLD, &requests.back());
+    }
+  }
+  for (int r = 0; r < num_proc; r++) {
+    if (needs[r * num_proc + rank]) {
+      requests.emplace_back();
+      MPI_Isend(send_buffer.data(), static_cast<int>(send_buffer.size()), MPI_DOUBLE, r,
+                wall_distance_tag, MPI_COMM_WORLD, &requests.back());
+    }
+  }
+  MPI_Waitall(static_cast<int>(requests.size()), requests.data(), MPI_STATUSES_IGNORE);
+
+  facets = std::move(local_facets);
+  for (int s = 0; s < num_proc; s++) {
+    for (int f = 0; f < static_cast<int>(recv_buffers[s].size()) / facet_pack_size; f++) {
+      const double *packed = &recv_buffers[s][f * facet_pack_size];
+      WallFacet facet;
+      facet.num_points = static_cast<int>(packed[0]);
+      for (int j = 0; j < 3; j++) {
+        for (int k = 0; k < 3; k++) {
+          facet.x[j][k] = packed[1 + 3 * j + k];
+        }
       }
+      facets.push_back(facet);
     }
   }
+  build_tree();
+}
 
-  std::vector<double> distance_vector(exo->num_nodes);
-  if (dim == 3) {
-    find_distances<3>(side_coordinates, coordinates, distance_vector);
-  } else if (dim == 2) {
-    find_distances<2>(side_coordinates, coordinates, distance_vector);
+// Refit the centroid tree to the current facets, the adaptor and its index
+// are kept and only reindexed
+void WallDistanceEngine::build_tree() {
+  if (facets.empty()) {
+    GOMA_EH(GOMA_ERROR, "No wall facets found for wall distance calculation");
+  }
+  centroids.resize(facets.size());
+  max_radius = 0.0;
+  for (size_t f = 0; f < facets.size(); f++) {
+    const WallFacet &facet = facets[f];
+    std::array<double, 3> c = {{0.0, 0.0, 0.0}};
+    for (int j = 0; j < facet.num_points; j++) {
+      c = axpy(c, 1.0 / facet.num_points, facet.x[j]);
+    }
+    centroids[f] = c;
+    for (int j = 0; j < facet.num_points; j++) {
+      max_radius = std::max(max_radius, sqrt(distance_squared(c, facet.x[j])));
+    }
+  }
+  if (kd_tree == nullptr) {
+    kd_tree = std::unique_ptr<KDTree>(new KDTree(centroids.size(), centroids, dim));
   } else {
+    kd_tree->index->buildIndex();
+  }
+}
+
+/* Exact distance to the nearest facet: every facet is within max_radius of
+ * its centroid, so only facets whose centroid lies within the distance to
+ * the facet of the nearest centroid plus max_radius can be closer. */
+double WallDistanceEngine::query(const std::array<double, 3> &p) const {
+  size_t nearest;
+  double nearest_dist_sqr;
+  kd_tree->query(&p[0], 1, &nearest, &nearest_dist_sqr);
+  double best_sqr = facet_distance_squared(p, facets[nearest]);
+  if (max_radius == 0.0) {
+    return sqrt(best_sqr);
+  }
+
+  double search_radius = sqrt(best_sqr) + max_radius;
+  std::vector<std::pair<size_t, double>> candidates;
+  kd_tree->index->radiusSearch(&p[0], search_radius * search_radius, candidates,
+                               nanoflann::SearchParams());
+  for (const auto &candidate : candidates) {
+    best_sqr = std::min(best_sqr, facet_distance_squared(p, facets[candidate.first]));
+  }
+  return sqrt(best_sqr);
+}
+
+// Engines for each combination of dimension, node sets and side sets requested
+std::map<std::vector<int>, std::unique_ptr<WallDistanceEngine>> wall_distance_engines;
+
+} // namespace
+
+extern "C" goma_error find_current_distances(Exo_DB *exo,
+                                             Dpi *dpi,
+                                             double *solution_vector,
+                                             bool apply_displacements,
+                                             int num_ns,
+                                             int *ns_ids,
+                                             int num_ss,
+                                             int *ss_ids,
+                                             double *distances) {
+
+  const int dim = exo->num_dim;
+
+  if (dim != 2 && dim != 3) {
     fprintf(stderr, "%s ERROR: Unsupported dimensionality: %d\n", __FUNCTION__, dim);
     return GOMA_ERROR;
   }
 
-  for (size_t i = 0; i < distance_vector.size(); i++) {
-    distances[i] = distance_vector[i];
+  std::vector<int> key = {dim, num_ns};
+  key.insert(key.end(), ns_ids, ns_ids + num_ns);
+  key.push_back(num_ss);
+  key.insert(key.end(), ss_ids, ss_ids + num_ss);
+
+  std::unique_ptr<WallDistanceEngine> &engine = wall_distance_engines[key];
+  // a different node count means a new mesh, the facets and coordinates are stale
+  if (engine != nullptr && engine->computed &&
+      engine->distances.size() != static_cast<size_t>(exo->num_nodes)) {
+    engine.reset();
+  }
+  if (engine == nullptr) {
+    engine = std::unique_ptr<WallDistanceEngine>(new WallDistanceEngine());
+    engine->dim = dim;
+    engine->setup_facets(exo, dpi, num_ns, ns_ids, num_ss, ss_ids);
+  }
+
+  // without displacements nothing moves after the first call
+  if (engine->computed && !apply_displacements) {
+    std::copy(engine->distances.begin(), engine->distances.end(), distances);
+    return GOMA_SUCCESS;
   }
 
+  engine->update_node_coordinates(exo, solution_vector, apply_displacements);
+  bool wall_moved = engine->update_wall_coordinates();
+  engine->gather_facets(dpi, wall_moved);
+
+  engine->distances.resize(exo->num_nodes);
+  for (int i = 0; i < exo->num_nodes; i++) {
+    engine->distances[i] = engine->query(engine->node_coordinates[i]);
+    distances[i] = engine->distances[i];
+  }
+  engine->computed = true;
+
   return GOMA_SUCCESS;
-}
\ No newline at end of file
+}
+
+extern "C" void wall_distance_engines_free(void) { wall_distance_engines.clear(); }
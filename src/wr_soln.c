@@ -21,6 +21,7 @@
 #include "dpi.h"
 #include "el_elm_info.h"
 #include "exo_struct.h"
+#include "md_timer.h"
 #include "mm_as.h"
 #include "mm_as_const.h"
 #include "mm_as_structs.h"
@@ -73,6 +74,8 @@ void write_solution(char output_file[],             /* name EXODUS II file */
 {
   int i, i_post, step = 0;
 
+  GOMA_PROF_BEGIN("output");
+
   /* First nodal quantities */
   for (i = 0; i < rd->TotalNVSolnOutput; i++) {
     extract_nodal_vec(x, rd->nvtype[i], rd->nvkind[i], rd->nvmatID[i], gvec, exo, FALSE,
@@ -150,6 +153,8 @@ void write_solution(char output_file[],             /* name EXODUS II file */
       }
     }
   }
+
+  GOMA_PROF_END("output");
 }
 
 void write_solution_segregated(char output_file[],
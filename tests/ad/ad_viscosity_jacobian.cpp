@@ -0,0 +1,124 @@
+#include <Sacado.hpp>
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cstdlib>
+
+#include "ad_momentum.h"
+#include "ad_turbulence.h"
+extern "C" {
+#include "mm_as.h"
+#include "mm_as_structs.h"
+#include "mm_mp_const.h"
+#include "mm_mp_structs.h"
+#include "rf_fem.h"
+#include "rf_fem_const.h"
+}
+
+// ad_assemble_momentum loads d(mu)/d(v) into lec->J straight from the AD
+// viscosity, so check the AD derivatives with respect to the strain rate
+// tensor against central differences of the same routine
+
+static const double fd_step = 1.0e-6;
+
+static void strain_rate_values(double g[DIM][DIM]) {
+  for (int a = 0; a < DIM; a++) {
+    for (int b = 0; b < DIM; b++) {
+      g[a][b] = 0.3 * (a + 1) - 0.2 * (b + 1) + 0.1 * a * b;
+    }
+  }
+}
+
+static void load_strain_rate(ADType gamma[DIM][DIM], double g[DIM][DIM], bool seeded) {
+  for (int a = 0; a < DIM; a++) {
+    for (int b = 0; b < DIM; b++) {
+      if (seeded) {
+        gamma[a][b] = ADType(DIM * DIM, a * DIM + b, g[a][b]);
+      } else {
+        gamma[a][b] = g[a][b];
+      }
+    }
+  }
+}
+
+static double bingham_value(struct Generalized_Newtonian *gn_local, double g[DIM][DIM]) {
+  ADType gamma[DIM][DIM];
+  load_strain_rate(gamma, g, false);
+  return ad_viscosity(gn_local, gamma).val();
+}
+
+static double shearrate_value(double g[DIM][DIM]) {
+  ADType gamma[DIM][DIM], gammadot;
+  load_strain_rate(gamma, g, false);
+  ad_calc_shearrate(gammadot, gamma);
+  return gammadot.val();
+}
+
+TEST_CASE("ad_calc_shearrate Jacobian matches finite differences", "[ad]") {
+  double g[DIM][DIM];
+  ADType gamma[DIM][DIM], gammadot;
+
+  VIM = 3;
+  strain_rate_values(g);
+  load_strain_rate(gamma, g, true);
+  ad_calc_shearrate(gammadot, gamma);
+  CHECK(gammadot.val() == Catch::Approx(shearrate_value(g)));
+
+  for (int a = 0; a < DIM; a++) {
+    for (int b = 0; b < DIM; b++) {
+      double save = g[a][b];
+      g[a][b] = save + fd_step;
+      double plus = shearrate_value(g);
+      g[a][b] = save - fd_step;
+      double minus = shearrate_value(g);
+      g[a][b] = save;
+      double fd = (plus - minus) / (2.0 * fd_step);
+      CHECK(gammadot.dx(a * DIM + b) == Catch::Approx(fd).epsilon(1e-6).margin(1e-9));
+    }
+  }
+}
+
+TEST_CASE("ad_viscosity Bingham Jacobian matches finite differences", "[ad]") {
+  double g[DIM][DIM];
+  ADType gamma[DIM][DIM];
+  struct Generalized_Newtonian gn_local = {};
+
+  /* isothermal, no level set: only the strain rate enters the viscosity */
+  VIM = 3;
+  pd = static_cast<PROBLEM_DESCRIPTION_STRUCT *>(calloc(1, sizeof(PROBLEM_DESCRIPTION_STRUCT)));
+  upd = static_cast<UPD_STRUCT *>(calloc(1, sizeof(UPD_STRUCT)));
+  ls = NULL;
+
+  gn_local.ConstitutiveEquation = BINGHAM;
+  gn_local.mu0 = 1.0;
+  gn_local.muinf = 0.01;
+  gn_local.nexp = 0.5;
+  gn_local.aexp = 2.0;
+  gn_local.atexp = 0.0;
+  gn_local.lam = 1.0;
+  gn_local.tau_yModel = CONSTANT;
+  gn_local.tau_y = 0.5;
+  gn_local.fexp = 10.0;
+
+  strain_rate_values(g);
+  load_strain_rate(gamma, g, true);
+  ADType mu = ad_viscosity(&gn_local, gamma);
+  CHECK(mu.val() == Catch::Approx(bingham_value(&gn_local, g)));
+
+  for (int a = 0; a < DIM; a++) {
+    for (int b = 0; b < DIM; b++) {
+      double save = g[a][b];
+      g[a][b] = save + fd_step;
+      double plus = bingham_value(&gn_local, g);
+      g[a][b] = save - fd_step;
+      double minus = bingham_value(&gn_local, g);
+      g[a][b] = save;
+      double fd = (plus - minus) / (2.0 * fd_step);
+      CHECK(mu.dx(a * DIM + b) == Catch::Approx(fd).epsilon(1e-6).margin(1e-9));
+    }
+  }
+
+  free(pd);
+  free(upd);
+  pd = NULL;
+  upd = NULL;
+}